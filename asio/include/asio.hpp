@@ -46,6 +46,7 @@
 #include "asio/completion_condition.hpp"
 #include "asio/compose.hpp"
 #include "asio/connect.hpp"
+#include "asio/connect_race.hpp"
 #include "asio/coroutine.hpp"
 #include "asio/deadline_timer.hpp"
 #include "asio/defer.hpp"
@@ -107,6 +108,7 @@
 #include "asio/ip/network_v4.hpp"
 #include "asio/ip/network_v6.hpp"
 #include "asio/ip/bad_address_cast.hpp"
+#include "asio/ip/basic_dns_resolver.hpp"
 #include "asio/ip/basic_endpoint.hpp"
 #include "asio/ip/basic_resolver.hpp"
 #include "asio/ip/basic_resolver_entry.hpp"
@@ -146,10 +148,12 @@
 #include "asio/redirect_error.hpp"
 #include "asio/require.hpp"
 #include "asio/require_concept.hpp"
+#include "asio/sendfile.hpp"
 #include "asio/serial_port.hpp"
 #include "asio/serial_port_base.hpp"
 #include "asio/signal_set.hpp"
 #include "asio/socket_base.hpp"
+#include "asio/splice.hpp"
 #include "asio/static_thread_pool.hpp"
 #include "asio/steady_timer.hpp"
 #include "asio/strand.hpp"
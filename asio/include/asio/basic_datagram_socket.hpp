@@ -76,6 +76,36 @@ public:
   /// The endpoint type.
   typedef typename Protocol::endpoint endpoint_type;
 
+#if (!defined(ASIO_WINDOWS) && !defined(__CYGWIN__)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Describes one datagram in a batch send operation.
+  struct send_record
+  {
+    /// The data to be sent.
+    const_buffer buffer;
+
+    /// The remote endpoint to which the data will be sent.
+    endpoint_type endpoint;
+
+    /// Set to the number of bytes sent.
+    std::size_t size;
+  };
+
+  /// Describes one datagram in a batch receive operation.
+  struct receive_record
+  {
+    /// The buffer into which the data will be received.
+    mutable_buffer buffer;
+
+    /// Set to the endpoint of the remote sender of the datagram.
+    endpoint_type endpoint;
+
+    /// Set to the number of bytes received.
+    std::size_t size;
+  };
+#endif // (!defined(ASIO_WINDOWS) && !defined(__CYGWIN__))
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Construct a basic_datagram_socket without opening it.
   /**
    * This constructor creates a datagram socket without opening it. The open()
@@ -1065,137 +1095,925 @@ public:
         buffers, &sender_endpoint, flags);
   }
 
-private:
-  // Disallow copying and assignment.
-  basic_datagram_socket(const basic_datagram_socket&) ASIO_DELETED;
-  basic_datagram_socket& operator=(
-      const basic_datagram_socket&) ASIO_DELETED;
-
-  class initiate_async_send
-  { 
-  public:
-    typedef Executor executor_type;
-
-    explicit initiate_async_send(basic_datagram_socket* self)
-      : self_(self)
-    {
-    }
-
-    executor_type get_executor() const ASIO_NOEXCEPT
-    {
-      return self_->get_executor();
-    }
-
-    template <typename WriteHandler, typename ConstBufferSequence>
-    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
-        const ConstBufferSequence& buffers,
-        socket_base::message_flags flags) const
-    {
-      // If you get an error on the following line it means that your handler
-      // does not meet the documented type requirements for a WriteHandler.
-      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
-
-      detail::non_const_lvalue<WriteHandler> handler2(handler);
-      self_->impl_.get_service().async_send(
-          self_->impl_.get_implementation(), buffers, flags,
-          handler2.value, self_->impl_.get_executor());
-    }
-
-  private:
-    basic_datagram_socket* self_;
-  };
-
-  class initiate_async_send_to
+#if (!defined(ASIO_WINDOWS) && !defined(__CYGWIN__)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Send a batch of datagrams.
+  /**
+   * This function is used to send several datagrams, each to its own remote
+   * endpoint, using as few system calls as possible. The function call will
+   * block until at least one datagram has been sent successfully, or until an
+   * error occurs.
+   *
+   * @param records An array of records, each describing one datagram to send.
+   * On return, the @c size member of each record that was sent is set to the
+   * number of bytes sent.
+   *
+   * @param count The number of records in the array.
+   *
+   * @returns The number of datagrams sent. These are the records at the start
+   * of the array.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note At most 64 datagrams are sent by each call. Where the platform does
+   * not provide @c sendmmsg, the batch is sent using one system call per
+   * datagram.
+   */
+  std::size_t send_batch(send_record* records, std::size_t count)
   {
-  public:
-    typedef Executor executor_type;
-
-    explicit initiate_async_send_to(basic_datagram_socket* self)
-      : self_(self)
-    {
-    }
-
-    executor_type get_executor() const ASIO_NOEXCEPT
-    {
-      return self_->get_executor();
-    }
-
-    template <typename WriteHandler, typename ConstBufferSequence>
-    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
-        const ConstBufferSequence& buffers, const endpoint_type& destination,
-        socket_base::message_flags flags) const
-    {
-      // If you get an error on the following line it means that your handler
-      // does not meet the documented type requirements for a WriteHandler.
-      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
-
-      detail::non_const_lvalue<WriteHandler> handler2(handler);
-      self_->impl_.get_service().async_send_to(
-          self_->impl_.get_implementation(), buffers, destination,
-          flags, handler2.value, self_->impl_.get_executor());
-    }
-
-  private:
-    basic_datagram_socket* self_;
-  };
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_batch(
+        this->impl_.get_implementation(), records, count, 0, ec);
+    asio::detail::throw_error(ec, "send_batch");
+    return s;
+  }
 
-  class initiate_async_receive
+  /// Send a batch of datagrams.
+  /**
+   * This function is used to send several datagrams, each to its own remote
+   * endpoint, using as few system calls as possible. The function call will
+   * block until at least one datagram has been sent successfully, or until an
+   * error occurs.
+   *
+   * @param records An array of records, each describing one datagram to send.
+   * On return, the @c size member of each record that was sent is set to the
+   * number of bytes sent.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @returns The number of datagrams sent. These are the records at the start
+   * of the array.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t send_batch(send_record* records, std::size_t count,
+      socket_base::message_flags flags)
   {
-  public:
-    typedef Executor executor_type;
-
-    explicit initiate_async_receive(basic_datagram_socket* self)
-      : self_(self)
-    {
-    }
-
-    executor_type get_executor() const ASIO_NOEXCEPT
-    {
-      return self_->get_executor();
-    }
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_batch(
+        this->impl_.get_implementation(), records, count, flags, ec);
+    asio::detail::throw_error(ec, "send_batch");
+    return s;
+  }
 
-    template <typename ReadHandler, typename MutableBufferSequence>
-    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
-        const MutableBufferSequence& buffers,
-        socket_base::message_flags flags) const
-    {
-      // If you get an error on the following line it means that your handler
-      // does not meet the documented type requirements for a ReadHandler.
-      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+  /// Send a batch of datagrams.
+  /**
+   * This function is used to send several datagrams, each to its own remote
+   * endpoint, using as few system calls as possible. The function call will
+   * block until at least one datagram has been sent successfully, or until an
+   * error occurs.
+   *
+   * @param records An array of records, each describing one datagram to send.
+   * On return, the @c size member of each record that was sent is set to the
+   * number of bytes sent.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams sent. These are the records at the start
+   * of the array.
+   */
+  std::size_t send_batch(send_record* records, std::size_t count,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().send_batch(
+        this->impl_.get_implementation(), records, count, flags, ec);
+  }
 
-      detail::non_const_lvalue<ReadHandler> handler2(handler);
-      self_->impl_.get_service().async_receive(
-          self_->impl_.get_implementation(), buffers, flags,
-          handler2.value, self_->impl_.get_executor());
-    }
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams, each to
+   * its own remote endpoint. The datagrams are sent using as few system calls
+   * as possible each time the socket is ready. The function call always
+   * returns immediately.
+   *
+   * @param records An array of records, each describing one datagram to send.
+   * The @c size member of each record that is sent is set to the number of
+   * bytes sent. Ownership of the array, and of the memory blocks referred to
+   * by its buffers, is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_batch(send_record* records, std::size_t count,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_batch(this), handler,
+        records, count, socket_base::message_flags(0));
+  }
 
-  private:
-    basic_datagram_socket* self_;
-  };
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams, each to
+   * its own remote endpoint. The datagrams are sent using as few system calls
+   * as possible each time the socket is ready. The function call always
+   * returns immediately.
+   *
+   * @param records An array of records, each describing one datagram to send.
+   * The @c size member of each record that is sent is set to the number of
+   * bytes sent. Ownership of the array, and of the memory blocks referred to
+   * by its buffers, is retained by the caller, which must guarantee that they
+   * remain valid until the handler is called.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_batch(send_record* records, std::size_t count,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_batch(this), handler, records, count, flags);
+  }
 
-  class initiate_async_receive_from
+  /// Receive a batch of datagrams.
+  /**
+   * This function is used to receive several datagrams using as few system
+   * calls as possible. The function call will block until at least one
+   * datagram has been received successfully, or until an error occurs. It
+   * then returns the datagrams that are immediately available, up to the
+   * number of records.
+   *
+   * @param records An array of records, each describing a buffer into which
+   * one datagram may be received. On return, the @c endpoint and @c size
+   * members of each record that was filled are set to the sender of the
+   * datagram and the number of bytes received.
+   *
+   * @param count The number of records in the array.
+   *
+   * @returns The number of datagrams received. These are the records at the
+   * start of the array.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note At most 64 datagrams are received by each call. Where the platform
+   * does not provide @c recvmmsg, the batch is received using one system call
+   * per datagram.
+   */
+  std::size_t receive_batch(receive_record* records, std::size_t count)
   {
-  public:
-    typedef Executor executor_type;
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_batch(
+        this->impl_.get_implementation(), records, count, 0, ec);
+    asio::detail::throw_error(ec, "receive_batch");
+    return s;
+  }
 
-    explicit initiate_async_receive_from(basic_datagram_socket* self)
-      : self_(self)
-    {
-    }
+  /// Receive a batch of datagrams.
+  /**
+   * This function is used to receive several datagrams using as few system
+   * calls as possible. The function call will block until at least one
+   * datagram has been received successfully, or until an error occurs. It
+   * then returns the datagrams that are immediately available, up to the
+   * number of records.
+   *
+   * @param records An array of records, each describing a buffer into which
+   * one datagram may be received. On return, the @c endpoint and @c size
+   * members of each record that was filled are set to the sender of the
+   * datagram and the number of bytes received.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of datagrams received. These are the records at the
+   * start of the array.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  std::size_t receive_batch(receive_record* records, std::size_t count,
+      socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_batch(
+        this->impl_.get_implementation(), records, count, flags, ec);
+    asio::detail::throw_error(ec, "receive_batch");
+    return s;
+  }
 
-    executor_type get_executor() const ASIO_NOEXCEPT
-    {
-      return self_->get_executor();
-    }
+  /// Receive a batch of datagrams.
+  /**
+   * This function is used to receive several datagrams using as few system
+   * calls as possible. The function call will block until at least one
+   * datagram has been received successfully, or until an error occurs. It
+   * then returns the datagrams that are immediately available, up to the
+   * number of records.
+   *
+   * @param records An array of records, each describing a buffer into which
+   * one datagram may be received. On return, the @c endpoint and @c size
+   * members of each record that was filled are set to the sender of the
+   * datagram and the number of bytes received.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams received. These are the records at the
+   * start of the array.
+   */
+  std::size_t receive_batch(receive_record* records, std::size_t count,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive_batch(
+        this->impl_.get_implementation(), records, count, flags, ec);
+  }
 
-    template <typename ReadHandler, typename MutableBufferSequence>
-    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
-        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
-        socket_base::message_flags flags) const
-    {
-      // If you get an error on the following line it means that your handler
-      // does not meet the documented type requirements for a ReadHandler.
-      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams. When
+   * the socket is ready, the datagrams that are immediately available are
+   * received using as few system calls as possible, up to the number of
+   * records. The function call always returns immediately.
+   *
+   * @param records An array of records, each describing a buffer into which
+   * one datagram may be received. The @c endpoint and @c size members of each
+   * record that is filled are set to the sender of the datagram and the number
+   * of bytes received. Ownership of the array, and of the memory blocks
+   * referred to by its buffers, is retained by the caller, which must
+   * guarantee that they remain valid until the handler is called.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_batch(receive_record* records, std::size_t count,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), handler,
+        records, count, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams. When
+   * the socket is ready, the datagrams that are immediately available are
+   * received using as few system calls as possible, up to the number of
+   * records. The function call always returns immediately.
+   *
+   * @param records An array of records, each describing a buffer into which
+   * one datagram may be received. The @c endpoint and @c size members of each
+   * record that is filled are set to the sender of the datagram and the number
+   * of bytes received. Ownership of the array, and of the memory blocks
+   * referred to by its buffers, is retained by the caller, which must
+   * guarantee that they remain valid until the handler is called.
+   *
+   * @param count The number of records in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_batch(receive_record* records, std::size_t count,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_batch(this), handler, records, count, flags);
+  }
+#endif // (!defined(ASIO_WINDOWS) && !defined(__CYGWIN__))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+  /// Send datagrams of equal size to the specified endpoint.
+  /**
+   * This function is used to send several datagrams of equal size to the
+   * specified remote endpoint. The data is passed to the kernel in a single
+   * system call and divided into datagrams of @c segment_size bytes by the
+   * kernel or network interface. The function call will block until the data
+   * has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   *
+   * @param segment_size The size of each datagram. The final datagram may be
+   * shorter. A value of zero uses the ip::udp::segment_size socket option.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * To send 10 datagrams of 1200 bytes in a single call:
+   * @code
+   * std::vector<char> data(10 * 1200);
+   * ...
+   * socket.send_to_segmented(asio::buffer(data), destination, 1200);
+   * @endcode
+   *
+   * @note Only available on Linux. Sockets of other protocols, and kernels
+   * that do not support UDP segmentation offload, fail the operation.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_to_segmented(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_to_segmented(
+        this->impl_.get_implementation(), buffers,
+        destination, segment_size, 0, ec);
+    asio::detail::throw_error(ec, "send_to_segmented");
+    return s;
+  }
+
+  /// Send datagrams of equal size to the specified endpoint.
+  /**
+   * This function is used to send several datagrams of equal size to the
+   * specified remote endpoint. The data is passed to the kernel in a single
+   * system call and divided into datagrams of @c segment_size bytes by the
+   * kernel or network interface. The function call will block until the data
+   * has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   *
+   * @param segment_size The size of each datagram. The final datagram may be
+   * shorter. A value of zero uses the ip::udp::segment_size socket option.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_to_segmented(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size,
+      socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().send_to_segmented(
+        this->impl_.get_implementation(), buffers,
+        destination, segment_size, flags, ec);
+    asio::detail::throw_error(ec, "send_to_segmented");
+    return s;
+  }
+
+  /// Send datagrams of equal size to the specified endpoint.
+  /**
+   * This function is used to send several datagrams of equal size to the
+   * specified remote endpoint. The data is passed to the kernel in a single
+   * system call and divided into datagrams of @c segment_size bytes by the
+   * kernel or network interface. The function call will block until the data
+   * has been sent successfully or an error occurs.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   *
+   * @param segment_size The size of each datagram. The final datagram may be
+   * shorter. A value of zero uses the ip::udp::segment_size socket option.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes sent.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_to_segmented(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().send_to_segmented(
+        this->impl_.get_implementation(), buffers,
+        destination, segment_size, flags, ec);
+  }
+
+  /// Start an asynchronous send of datagrams of equal size.
+  /**
+   * This function is used to asynchronously send several datagrams of equal
+   * size to the specified remote endpoint. The data is divided into datagrams
+   * of @c segment_size bytes by the kernel or network interface. The function
+   * call always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param segment_size The size of each datagram. The final datagram may be
+   * shorter. A value of zero uses the ip::udp::segment_size socket option.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_to_segmented(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_to_segmented(this), handler, buffers,
+        destination, segment_size, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of datagrams of equal size.
+  /**
+   * This function is used to asynchronously send several datagrams of equal
+   * size to the specified remote endpoint. The data is divided into datagrams
+   * of @c segment_size bytes by the kernel or network interface. The function
+   * call always returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param segment_size The size of each datagram. The final datagram may be
+   * shorter. A value of zero uses the ip::udp::segment_size socket option.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_to_segmented(const ConstBufferSequence& buffers,
+      const endpoint_type& destination, std::size_t segment_size,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_to_segmented(this), handler, buffers,
+        destination, segment_size, flags);
+  }
+
+  /// Receive coalesced datagrams with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram, or a run of datagrams from
+   * the same sender that the kernel has coalesced because the
+   * ip::udp::generic_receive_offload socket option is enabled. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Set to the size of the coalesced datagrams. The final
+   * datagram may be shorter. If the data was not coalesced, this is the
+   * number of bytes received.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * asio::ip::udp::endpoint sender_endpoint;
+   * std::size_t segment_size = 0;
+   * std::size_t n = socket.receive_from_segmented(
+   *     asio::buffer(data, size), sender_endpoint, segment_size);
+   * // Datagram i is at offset i * segment_size, up to n.
+   * @endcode
+   *
+   * @note Only available on Linux.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from_segmented(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_from_segmented(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, 0, ec);
+    asio::detail::throw_error(ec, "receive_from_segmented");
+    return s;
+  }
+
+  /// Receive coalesced datagrams with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram, or a run of datagrams from
+   * the same sender that the kernel has coalesced because the
+   * ip::udp::generic_receive_offload socket option is enabled. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Set to the size of the coalesced datagrams. The final
+   * datagram may be shorter. If the data was not coalesced, this is the
+   * number of bytes received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of bytes received.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from_segmented(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      socket_base::message_flags flags)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().receive_from_segmented(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, flags, ec);
+    asio::detail::throw_error(ec, "receive_from_segmented");
+    return s;
+  }
+
+  /// Receive coalesced datagrams with the endpoint of the sender.
+  /**
+   * This function is used to receive a datagram, or a run of datagrams from
+   * the same sender that the kernel has coalesced because the
+   * ip::udp::generic_receive_offload socket option is enabled. The function
+   * call will block until data has been received successfully or an error
+   * occurs.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams.
+   *
+   * @param segment_size Set to the size of the coalesced datagrams. The final
+   * datagram may be shorter. If the data was not coalesced, this is the
+   * number of bytes received.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes received.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_from_segmented(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return this->impl_.get_service().receive_from_segmented(
+        this->impl_.get_implementation(), buffers,
+        sender_endpoint, segment_size, flags, ec);
+  }
+
+  /// Start an asynchronous receive of coalesced datagrams.
+  /**
+   * This function is used to asynchronously receive a datagram, or a run of
+   * datagrams from the same sender that the kernel has coalesced because the
+   * ip::udp::generic_receive_offload socket option is enabled. The function
+   * call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param segment_size Set to the size of the coalesced datagrams. If the
+   * data was not coalesced, this is the number of bytes received. Ownership of
+   * the segment_size object is retained by the caller, which must guarantee
+   * that it is valid until the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_segmented(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from_segmented(this), handler, buffers,
+        &sender_endpoint, &segment_size, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of coalesced datagrams.
+  /**
+   * This function is used to asynchronously receive a datagram, or a run of
+   * datagrams from the same sender that the kernel has coalesced because the
+   * ip::udp::generic_receive_offload socket option is enabled. The function
+   * call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param segment_size Set to the size of the coalesced datagrams. If the
+   * data was not coalesced, this is the number of bytes received. Ownership of
+   * the segment_size object is retained by the caller, which must guarantee
+   * that it is valid until the handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_segmented(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, std::size_t& segment_size,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from_segmented(this), handler, buffers,
+        &sender_endpoint, &segment_size, flags);
+  }
+#endif // defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+
+private:
+  // Disallow copying and assignment.
+  basic_datagram_socket(const basic_datagram_socket&) ASIO_DELETED;
+  basic_datagram_socket& operator=(
+      const basic_datagram_socket&) ASIO_DELETED;
+
+  class initiate_async_send
+  { 
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_send_to
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_to(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const endpoint_type& destination,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_to(
+          self_->impl_.get_implementation(), buffers, destination,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_from
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_from(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
       detail::non_const_lvalue<ReadHandler> handler2(handler);
       self_->impl_.get_service().async_receive_from(
@@ -1206,6 +2024,147 @@ private:
   private:
     basic_datagram_socket* self_;
   };
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  class initiate_async_send_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        send_record* records, std::size_t count,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_batch(
+          self_->impl_.get_implementation(), records, count,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        receive_record* records, std::size_t count,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_batch(
+          self_->impl_.get_implementation(), records, count,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#if defined(ASIO_HAS_UDP_GSO)
+  class initiate_async_send_to_segmented
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_to_segmented(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const endpoint_type& destination,
+        std::size_t segment_size, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_to_segmented(
+          self_->impl_.get_implementation(), buffers, destination,
+          segment_size, flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_from_segmented
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_from_segmented(
+        basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        std::size_t* segment_size, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_from_segmented(
+          self_->impl_.get_implementation(), buffers, *sender_endpoint,
+          *segment_size, flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_UDP_GSO)
 };
 
 } // namespace asio
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include "asio/async_result.hpp"
 #include "asio/basic_socket.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
@@ -532,6 +533,120 @@ public:
         initiate_async_send(this), handler, buffers, flags);
   }
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous zero-copy send.
+  /**
+   * This function is used to asynchronously send data on the stream socket
+   * without copying it into the kernel. The function call always returns
+   * immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid, and unmodified, until the handler is called. The handler is
+   * not called until the kernel has released the memory blocks, which may be
+   * some time after the data has been sent.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The send operation may not transmit all of the data to the peer.
+   *
+   * @note Once the data has been sent, the send operation can no longer be
+   * cancelled: cancel() leaves it waiting for the kernel to release the memory
+   * blocks. Closing the socket calls the handler with the result of the send,
+   * but the kernel may still be transmitting from the memory blocks, which
+   * should not be modified until the peer has received the data.
+   *
+   * @note Zero-copy sends are only available on Linux. Where the kernel does
+   * not support them, or runs out of memory to pin the buffers, the data is
+   * copied and the handler is called once it has been sent. Zero-copy sends
+   * generally benefit only large writes; the kernel copies the data anyway
+   * when the peer is on the same host.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_zerocopy(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_zerocopy(this), handler,
+        buffers, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous zero-copy send.
+  /**
+   * This function is used to asynchronously send data on the stream socket
+   * without copying it into the kernel. The function call always returns
+   * immediately.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid, and unmodified, until the handler is called. The handler is
+   * not called until the kernel has released the memory blocks, which may be
+   * some time after the data has been sent.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The send operation may not transmit all of the data to the peer.
+   *
+   * @note Once the data has been sent, the send operation can no longer be
+   * cancelled: cancel() leaves it waiting for the kernel to release the memory
+   * blocks. Closing the socket calls the handler with the result of the send,
+   * but the kernel may still be transmitting from the memory blocks, which
+   * should not be modified until the peer has received the data.
+   *
+   * @note Zero-copy sends are only available on Linux. Where the kernel does
+   * not support them, or runs out of memory to pin the buffers, the data is
+   * copied and the handler is called once it has been sent. Zero-copy sends
+   * generally benefit only large writes; the kernel copies the data anyway
+   * when the peer is on the same host.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_zerocopy(const ConstBufferSequence& buffers,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_zerocopy(this), handler, buffers, flags);
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on the socket.
   /**
    * This function is used to receive data on the stream socket. The function
@@ -972,6 +1087,305 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+#if defined(ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+  /// Write some data from a file to the socket.
+  /**
+   * This function is used to send data from a file directly to the stream
+   * socket, without copying it through user memory. The function call will
+   * block until one or more bytes of the data has been written successfully,
+   * or until an error occurs.
+   *
+   * @param file A native descriptor for the file to be sent. The descriptor's
+   * file position is neither used nor changed.
+   *
+   * @param offset The offset within the file at which to start sending.
+   *
+   * @param count The maximum number of bytes to send.
+   *
+   * @returns The number of bytes written.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the offset is at the end of the file.
+   *
+   * @note The sendfile_some operation may not transmit all of the requested
+   * data. Consider using the @ref sendfile function if you need to ensure that
+   * all data is written before the blocking operation completes.
+   *
+   * @note Writing to a socket whose peer has closed the connection may raise
+   * the @c SIGPIPE signal, which programs should ignore.
+   */
+  std::size_t sendfile_some(int file, uint64_t offset, std::size_t count)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().sendfile(
+        this->impl_.get_implementation(), file, offset, count, ec);
+    asio::detail::throw_error(ec, "sendfile_some");
+    return s;
+  }
+
+  /// Write some data from a file to the socket.
+  /**
+   * This function is used to send data from a file directly to the stream
+   * socket, without copying it through user memory. The function call will
+   * block until one or more bytes of the data has been written successfully,
+   * or until an error occurs.
+   *
+   * @param file A native descriptor for the file to be sent. The descriptor's
+   * file position is neither used nor changed.
+   *
+   * @param offset The offset within the file at which to start sending.
+   *
+   * @param count The maximum number of bytes to send.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes written. Returns 0 if an error occurred.
+   */
+  std::size_t sendfile_some(int file, uint64_t offset,
+      std::size_t count, asio::error_code& ec)
+  {
+    return this->impl_.get_service().sendfile(
+        this->impl_.get_implementation(), file, offset, count, ec);
+  }
+
+  /// Start an asynchronous write of data from a file.
+  /**
+   * This function is used to asynchronously send data from a file directly to
+   * the stream socket, without copying it through user memory. The function
+   * call always returns immediately.
+   *
+   * @param file A native descriptor for the file to be sent. The descriptor
+   * must remain open until the handler is called. Its file position is
+   * neither used nor changed.
+   *
+   * @param offset The offset within the file at which to start sending.
+   *
+   * @param count The maximum number of bytes to send.
+   *
+   * @param handler The handler to be called when the write operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes written.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The write operation may not transmit all of the requested data.
+   * Consider using the @ref async_sendfile function if you need to ensure that
+   * all data is written before the asynchronous operation completes.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_sendfile_some(int file, uint64_t offset, std::size_t count,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_sendfile(this), handler, file, offset, count);
+  }
+#endif // defined(ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_SPLICE) || defined(GENERATING_DOCUMENTATION)
+  /// Move some data received on the socket into a pipe.
+  /**
+   * This function is used to move data received on the stream socket into a
+   * pipe, without copying it through user memory. The function call will
+   * block until one or more bytes of data has been moved successfully, or
+   * until an error occurs.
+   *
+   * @param pipe A native descriptor for the write end of a pipe.
+   *
+   * @param count The maximum number of bytes to move.
+   *
+   * @returns The number of bytes moved.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the connection was closed by the
+   * peer.
+   *
+   * @note Consider using the @ref splice function if you need to ensure that
+   * the requested amount of data is moved before the blocking operation
+   * completes.
+   */
+  std::size_t splice_some_to(int pipe, std::size_t count)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().splice_to(
+        this->impl_.get_implementation(), pipe, count, ec);
+    asio::detail::throw_error(ec, "splice_some_to");
+    return s;
+  }
+
+  /// Move some data received on the socket into a pipe.
+  /**
+   * This function is used to move data received on the stream socket into a
+   * pipe, without copying it through user memory. The function call will
+   * block until one or more bytes of data has been moved successfully, or
+   * until an error occurs.
+   *
+   * @param pipe A native descriptor for the write end of a pipe.
+   *
+   * @param count The maximum number of bytes to move.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes moved. Returns 0 if an error occurred.
+   */
+  std::size_t splice_some_to(int pipe, std::size_t count,
+      asio::error_code& ec)
+  {
+    return this->impl_.get_service().splice_to(
+        this->impl_.get_implementation(), pipe, count, ec);
+  }
+
+  /// Start an asynchronous move of data received on the socket into a pipe.
+  /**
+   * This function is used to asynchronously move data received on the stream
+   * socket into a pipe, without copying it through user memory. The function
+   * call always returns immediately.
+   *
+   * @param pipe A native descriptor for the write end of a pipe. The
+   * descriptor must remain open until the handler is called.
+   *
+   * @param count The maximum number of bytes to move.
+   *
+   * @param handler The handler to be called when the operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes moved.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The operation waits only for the socket to become ready. If data is
+   * available on the socket but the pipe is full, the operation fails with
+   * asio::error::would_block. The @ref async_splice function handles
+   * this by waiting for the pipe.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_splice_some_to(int pipe, std::size_t count,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_splice(this), handler, pipe, true, count);
+  }
+
+  /// Send some data from a pipe to the socket.
+  /**
+   * This function is used to send data from a pipe to the stream socket,
+   * without copying it through user memory. The function call will block until
+   * one or more bytes of data has been moved successfully, or until an error
+   * occurs.
+   *
+   * @param pipe A native descriptor for the read end of a pipe.
+   *
+   * @param count The maximum number of bytes to move.
+   *
+   * @returns The number of bytes moved.
+   *
+   * @throws asio::system_error Thrown on failure. An error code of
+   * asio::error::eof indicates that the write end of the pipe has been
+   * closed.
+   *
+   * @note Consider using the @ref splice function if you need to ensure that
+   * the requested amount of data is moved before the blocking operation
+   * completes.
+   */
+  std::size_t splice_some_from(int pipe, std::size_t count)
+  {
+    asio::error_code ec;
+    std::size_t s = this->impl_.get_service().splice_from(
+        this->impl_.get_implementation(), pipe, count, ec);
+    asio::detail::throw_error(ec, "splice_some_from");
+    return s;
+  }
+
+  /// Send some data from a pipe to the socket.
+  /**
+   * This function is used to send data from a pipe to the stream socket,
+   * without copying it through user memory. The function call will block until
+   * one or more bytes of data has been moved successfully, or until an error
+   * occurs.
+   *
+   * @param pipe A native descriptor for the read end of a pipe.
+   *
+   * @param count The maximum number of bytes to move.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes moved. Returns 0 if an error occurred.
+   */
+  std::size_t splice_some_from(int pipe, std::size_t count,
+      asio::error_code& ec)
+  {
+    return this->impl_.get_service().splice_from(
+        this->impl_.get_implementation(), pipe, count, ec);
+  }
+
+  /// Start an asynchronous send of data from a pipe to the socket.
+  /**
+   * This function is used to asynchronously send data from a pipe to the
+   * stream socket, without copying it through user memory. The function call
+   * always returns immediately.
+   *
+   * @param pipe A native descriptor for the read end of a pipe. The
+   * descriptor must remain open until the handler is called.
+   *
+   * @param count The maximum number of bytes to move.
+   *
+   * @param handler The handler to be called when the operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes moved.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The operation waits only for the socket to become ready. If the
+   * socket can accept data but the pipe is empty, the operation fails with
+   * asio::error::would_block. The @ref async_splice function handles
+   * this by waiting for the pipe.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_splice_some_from(int pipe, std::size_t count,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_splice(this), handler, pipe, false, count);
+  }
+#endif // defined(ASIO_HAS_SPLICE) || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_stream_socket(const basic_stream_socket&) ASIO_DELETED;
@@ -1011,6 +1425,122 @@ private:
     basic_stream_socket* self_;
   };
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  class initiate_async_send_zerocopy
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_zerocopy(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_zerocopy(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SENDFILE)
+  class initiate_async_sendfile
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_sendfile(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        int file, uint64_t offset, std::size_t count) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_sendfile(
+          self_->impl_.get_implementation(), file, offset, count,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#if defined(ASIO_HAS_SPLICE)
+  class initiate_async_splice
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_splice(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename Handler>
+    void operator()(ASIO_MOVE_ARG(Handler) handler,
+        int pipe, bool to_pipe, std::size_t count) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler or
+      // WriteHandler.
+      ASIO_READ_HANDLER_CHECK(Handler, handler) type_check;
+
+      detail::non_const_lvalue<Handler> handler2(handler);
+      if (to_pipe)
+      {
+        self_->impl_.get_service().async_splice_to(
+            self_->impl_.get_implementation(), pipe, count,
+            handler2.value, self_->impl_.get_executor());
+      }
+      else
+      {
+        self_->impl_.get_service().async_splice_from(
+            self_->impl_.get_implementation(), pipe, count,
+            handler2.value, self_->impl_.get_executor());
+      }
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SPLICE)
+
   class initiate_async_receive
   {
   public:
@@ -623,6 +623,64 @@ public:
     return s;
   }
 
+  /// Change the timer's expiry time to an absolute time, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_at(), any pending
+   * asynchronous wait operations are not cancelled, and will instead complete
+   * when the new expiry time is reached. This allows a timeout to be pushed
+   * back without additional handler invocations.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note If the timer has already expired when reschedule_at() is called,
+   * then the handlers for asynchronous wait operations will:
+   *
+   * @li have already been invoked; or
+   *
+   * @li have been queued for invocation in the near future.
+   *
+   * These handlers are not affected by the new expiry time.
+   */
+  void reschedule_at(const time_point& expiry_time)
+  {
+    asio::error_code ec;
+    impl_.get_service().reschedule_at(
+        impl_.get_implementation(), expiry_time, ec);
+    asio::detail::throw_error(ec, "reschedule_at");
+  }
+
+  /// Change the timer's expiry time relative to now, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_after(), any pending
+   * asynchronous wait operations are not cancelled, and will instead complete
+   * when the new expiry time is reached. This allows a timeout to be pushed
+   * back without additional handler invocations.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note If the timer has already expired when reschedule_after() is called,
+   * then the handlers for asynchronous wait operations will:
+   *
+   * @li have already been invoked; or
+   *
+   * @li have been queued for invocation in the near future.
+   *
+   * These handlers are not affected by the new expiry time.
+   */
+  void reschedule_after(const duration& expiry_time)
+  {
+    asio::error_code ec;
+    impl_.get_service().reschedule_after(
+        impl_.get_implementation(), expiry_time, ec);
+    asio::detail::throw_error(ec, "reschedule_after");
+  }
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use expiry().) Get the timer's expiry time relative to now.
   /**
@@ -0,0 +1,194 @@
+//
+// connect_race.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_CONNECT_RACE_HPP
+#define ASIO_CONNECT_RACE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if (defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_MOVE)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include "asio/async_result.hpp"
+#include "asio/basic_socket.hpp"
+#include "asio/connect.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup async_connect_race asio::async_connect_race
+ *
+ * @brief The @c async_connect_race function is a composed asynchronous
+ * operation that establishes a socket connection by racing staggered
+ * connection attempts to the endpoints in a sequence.
+ */
+/*@{*/
+
+/// Asynchronously establishes a socket connection by racing connection
+/// attempts to each endpoint in a sequence.
+/**
+ * This function attempts to connect a socket to one of a sequence of
+ * endpoints, using the "Happy Eyeballs" algorithm described in RFC 8305.
+ * The endpoints are reordered so that the address families alternate,
+ * starting with the family of the first endpoint. A connection attempt is
+ * started to the first endpoint, and a further attempt is started each time
+ * the delay elapses or an attempt fails, until an attempt succeeds or the
+ * endpoints are exhausted. Each attempt uses a separate socket.
+ *
+ * The first attempt to succeed wins. Its connection is moved into @c s, and
+ * all other attempts are cancelled. Any connection held by @c s when the
+ * function is called is closed.
+ *
+ * @param s The socket to be connected. If the socket is already open, it will
+ * be closed.
+ *
+ * @param endpoints A sequence of endpoints.
+ *
+ * @param delay The time to wait for an attempt to complete before starting
+ * the next attempt. RFC 8305 recommends 250 milliseconds.
+ *
+ * @param handler The handler to be called when the connect operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   // Result of operation. if the sequence is empty, set to
+ *   // asio::error::not_found. Otherwise, contains the
+ *   // error from the last connection attempt to fail.
+ *   const asio::error_code& error,
+ *
+ *   // On success, the successfully connected endpoint.
+ *   // Otherwise, a default-constructed endpoint.
+ *   const typename Protocol::endpoint& endpoint
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Example
+ * @code tcp::socket s(my_context);
+ *
+ * // ...
+ *
+ * void resolve_handler(
+ *     const asio::error_code& ec,
+ *     tcp::resolver::results_type results)
+ * {
+ *   if (!ec)
+ *   {
+ *     asio::async_connect_race(s, results,
+ *         std::chrono::milliseconds(250), connect_handler);
+ *   }
+ * } @endcode
+ */
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    typename Rep, typename Period,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      typename Protocol::endpoint)) RangeConnectHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_race(basic_socket<Protocol, Executor>& s,
+    const EndpointSequence& endpoints,
+    const chrono::duration<Rep, Period>& delay,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor),
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type* = 0);
+
+/// Asynchronously establishes a socket connection by racing connection
+/// attempts to each endpoint in a sequence.
+/**
+ * This function attempts to connect a socket to one of a sequence of
+ * endpoints, using the "Happy Eyeballs" algorithm described in RFC 8305.
+ * The endpoints are reordered so that the address families alternate,
+ * starting with the family of the first endpoint. A connection attempt is
+ * started to the first endpoint, and a further attempt is started each time
+ * the delay elapses or an attempt fails, until an attempt succeeds or the
+ * endpoints are exhausted. Each attempt uses a separate socket.
+ *
+ * The first attempt to succeed wins. Its connection is moved into @c s, and
+ * all other attempts are cancelled. Any connection held by @c s when the
+ * function is called is closed.
+ *
+ * @param s The socket to be connected. If the socket is already open, it will
+ * be closed.
+ *
+ * @param endpoints A sequence of endpoints.
+ *
+ * @param delay The time to wait for an attempt to complete before starting
+ * the next attempt. RFC 8305 recommends 250 milliseconds.
+ *
+ * @param connect_condition A function object that is called prior to each
+ * connection attempt. The signature of the function object must be:
+ * @code bool connect_condition(
+ *     const asio::error_code& ec,
+ *     const typename Protocol::endpoint& next); @endcode
+ * The @c ec parameter contains the result from the most recent connection
+ * attempt to fail. Before the first attempt, @c ec is always set to indicate
+ * success. The @c next parameter is the next endpoint to be tried. The
+ * function object should return true if the next endpoint should be tried,
+ * and false if it should be skipped.
+ *
+ * @param handler The handler to be called when the connect operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   // Result of operation. if the sequence is empty, set to
+ *   // asio::error::not_found. Otherwise, contains the
+ *   // error from the last connection attempt to fail.
+ *   const asio::error_code& error,
+ *
+ *   // On success, the successfully connected endpoint.
+ *   // Otherwise, a default-constructed endpoint.
+ *   const typename Protocol::endpoint& endpoint
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ */
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    typename Rep, typename Period, typename ConnectCondition,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      typename Protocol::endpoint)) RangeConnectHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_race(basic_socket<Protocol, Executor>& s,
+    const EndpointSequence& endpoints,
+    const chrono::duration<Rep, Period>& delay,
+    ConnectCondition connect_condition,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor),
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type* = 0);
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/connect_race.hpp"
+
+#endif // (defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_MOVE))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_CONNECT_RACE_HPP
@@ -16,7 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
-#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/atomic_count.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_invoke_helpers.hpp"
@@ -27,57 +27,171 @@
 namespace asio {
 namespace detail {
 
+// Invokes a bulk function for each index in a contiguous range.
+template <typename Handler>
+struct bulk_executor_range
+{
+  Handler* handler_;
+  std::size_t begin_;
+  std::size_t end_;
+
+  void operator()()
+  {
+    for (std::size_t i = begin_; i != end_; ++i)
+      (*handler_)(i);
+  }
+};
+
+// A bulk execution divides its index space into chunks, and then posts a
+// small number of runner operations that claim and execute chunks until none
+// remain. The runners are allocated together as a single block, with the
+// state that is shared between them held by the first runner in the block.
 template <typename Handler, typename Alloc,
     typename Operation = scheduler_operation>
 class bulk_executor_op : public Operation
 {
 public:
-  ASIO_DEFINE_HANDLER_ALLOCATOR_PTR(bulk_executor_op);
-
+  // Allocate and construct the runners for a bulk execution of n indices.
+  // Returns the first runner in the block, and sets the number of runners.
   template <typename H>
-  bulk_executor_op(ASIO_MOVE_ARG(H) h,
-      const Alloc& allocator, std::size_t i)
-    : Operation(&bulk_executor_op::do_complete),
-      handler_(ASIO_MOVE_CAST(H)(h)),
-      allocator_(allocator),
-      index_(i)
+  static bulk_executor_op* create(ASIO_MOVE_ARG(H) h, const Alloc& allocator,
+      std::size_t n, std::size_t max_runners, std::size_t& runners)
   {
+    // Aim for several chunks per runner so that runners that finish early
+    // can take over the remaining work from those that are delayed.
+    std::size_t target_chunks = max_runners * 4;
+    std::size_t chunk_size = n / target_chunks
+      + (n % target_chunks != 0 ? 1 : 0);
+    std::size_t chunks = n / chunk_size + (n % chunk_size != 0 ? 1 : 0);
+    runners = chunks < max_runners ? chunks : max_runners;
+
+    bulk_executor_op* block = allocate(allocator, runners);
+
+    // Every runner other than the first receives a copy of the function, so
+    // that the first runner may take ownership of the original.
+    std::size_t constructed = 0;
+#if !defined(ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+      for (std::size_t i = runners - 1; i > 0; --i, ++constructed)
+        new (block + i) bulk_executor_op(
+            static_cast<const H&>(h), allocator, block);
+      new (block) bulk_executor_op(ASIO_MOVE_CAST(H)(h), allocator, block);
+#if !defined(ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      for (std::size_t i = runners - constructed; i < runners; ++i)
+        block[i].~bulk_executor_op();
+      deallocate(allocator, block, runners);
+      throw;
+    }
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+
+    block->size_ = n;
+    block->chunk_size_ = chunk_size;
+    block->chunks_ = static_cast<long>(chunks);
+    block->runners_ = runners;
+    block->outstanding_ = static_cast<long>(runners);
+
+    return block;
   }
 
   static void do_complete(void* owner, Operation* base,
       const asio::error_code& /*ec*/,
       std::size_t /*bytes_transferred*/)
   {
-    // Take ownership of the handler object.
     bulk_executor_op* o(static_cast<bulk_executor_op*>(base));
-    Alloc allocator(o->allocator_);
-    ptr p = { detail::addressof(allocator), o, o };
+    release_on_exit on_exit = { o->first_ };
 
     ASIO_HANDLER_COMPLETION((*o));
 
-    // Make a copy of the handler so that the memory can be deallocated before
-    // the upcall is made. Even if we're not about to make an upcall, a
-    // sub-object of the handler may be the true owner of the memory associated
-    // with the handler. Consequently, a local copy of the handler is required
-    // to ensure that any owning sub-object remains valid until after we have
-    // deallocated the memory here.
-    detail::binder1<Handler, std::size_t> handler(o->handler_, o->index_);
-    p.reset();
-
-    // Make the upcall if required.
+    // Claim and execute chunks until there are none left. The thread pool
+    // offers the parallel bulk guarantee, so the indices within a chunk may
+    // be executed in a tight loop by a single execution agent.
     if (owner)
     {
-      fenced_block b(fenced_block::half);
-      ASIO_HANDLER_INVOCATION_BEGIN(());
-      asio_handler_invoke_helpers::invoke(handler, handler.handler_);
-      ASIO_HANDLER_INVOCATION_END;
+      bulk_executor_op* first = o->first_;
+      for (long chunk; (chunk = ++first->next_chunk_ - 1) < first->chunks_;)
+      {
+        std::size_t begin =
+          static_cast<std::size_t>(chunk) * first->chunk_size_;
+        std::size_t end = begin + first->chunk_size_;
+        bulk_executor_range<Handler> range = { &o->handler_, begin,
+          end < first->size_ ? end : first->size_ };
+
+        fenced_block b(fenced_block::half);
+        ASIO_HANDLER_INVOCATION_BEGIN(());
+        asio_handler_invoke_helpers::invoke(range, o->handler_);
+        ASIO_HANDLER_INVOCATION_END;
+      }
     }
   }
 
 private:
+  template <typename H>
+  bulk_executor_op(ASIO_MOVE_ARG(H) h,
+      const Alloc& allocator, bulk_executor_op* first)
+    : Operation(&bulk_executor_op::do_complete),
+      handler_(ASIO_MOVE_CAST(H)(h)),
+      allocator_(allocator),
+      first_(first),
+      next_chunk_(0),
+      outstanding_(0)
+  {
+  }
+
+  typedef typename get_recycling_allocator<Alloc,
+      thread_info_base::default_tag>::type recycling_allocator_type;
+  typedef ASIO_REBIND_ALLOC(recycling_allocator_type,
+      bulk_executor_op) block_allocator_type;
+
+  static bulk_executor_op* allocate(const Alloc& a, std::size_t runners)
+  {
+    block_allocator_type a1(get_recycling_allocator<Alloc,
+        thread_info_base::default_tag>::get(a));
+    return a1.allocate(runners);
+  }
+
+  static void deallocate(const Alloc& a,
+      bulk_executor_op* block, std::size_t runners)
+  {
+    block_allocator_type a1(get_recycling_allocator<Alloc,
+        thread_info_base::default_tag>::get(a));
+    a1.deallocate(block, runners);
+  }
+
+  // Destroys the block once the last runner has finished, even if a chunk
+  // exits via an exception.
+  struct release_on_exit
+  {
+    bulk_executor_op* first_;
+
+    ~release_on_exit()
+    {
+      if (ref_count_down(first_->outstanding_))
+      {
+        Alloc allocator(first_->allocator_);
+        std::size_t runners = first_->runners_;
+        for (std::size_t i = 0; i < runners; ++i)
+          first_[i].~bulk_executor_op();
+        deallocate(allocator, first_, runners);
+      }
+    }
+  };
+
   Handler handler_;
   Alloc allocator_;
-  std::size_t index_;
+  bulk_executor_op* first_;
+
+  // The following members are used only in the first runner of the block.
+  std::size_t size_;
+  std::size_t chunk_size_;
+  long chunks_;
+  std::size_t runners_;
+  atomic_count next_chunk_;
+  atomic_count outstanding_;
 };
 
 } // namespace detail
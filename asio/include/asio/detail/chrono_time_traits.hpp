@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/cstdint.hpp"
+#include "asio/detail/timer_wheel_resolution.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -180,6 +181,14 @@ struct chrono_time_traits
   {
     return posix_time_duration(WaitTraits::to_wait_duration(d));
   }
+
+  // Get the resolution of the timing wheel used to hold timers. A zero
+  // duration means that timers are held in a heap.
+  static duration_type timer_wheel_resolution()
+  {
+    return asio::detail::timer_wheel_resolution<
+      WaitTraits, duration_type>::get();
+  }
 };
 
 } // namespace detail
@@ -33,6 +33,25 @@
 // If set, this bit indicates that the reactor should perform locking for I/O.
 #define ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO 0x4u
 
+// If set, this bit indicates that the scheduler should give each thread that
+// runs it a private queue, with idle threads stealing work from their peers.
+#define ASIO_CONCURRENCY_HINT_WORK_STEALING_SCHEDULER 0x8u
+
+// These bits hold the maximum number of handlers that a scheduler thread takes
+// from the queue each time it acquires the lock. Values of 0 and 1 both mean
+// that handlers are taken one at a time.
+#define ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_MASK 0xF0u
+#define ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_SHIFT 4
+
+// These bits hold the number of epoll sets among which the reactor divides
+// its registered descriptors. Values of 0 and 1 both mean a single set.
+#define ASIO_CONCURRENCY_HINT_REACTOR_SHARDS_MASK 0x7F00u
+#define ASIO_CONCURRENCY_HINT_REACTOR_SHARDS_SHIFT 8
+
+// If set, this bit indicates that the scheduler is run by a single thread, and
+// that only handlers posted from other threads need to be synchronised.
+#define ASIO_CONCURRENCY_HINT_SINGLE_THREADED_SCHEDULER 0x8000u
+
 // Helper macro to determine if we have a special concurrency hint.
 #define ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
   ((static_cast<unsigned>(hint) \
@@ -46,6 +65,34 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_ ## facility)) \
         ^ ASIO_CONCURRENCY_HINT_ID) != 0)
 
+// Helper macro to determine if work stealing is enabled in the scheduler.
+#define ASIO_CONCURRENCY_HINT_IS_WORK_STEALING(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && (static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_WORK_STEALING_SCHEDULER) != 0)
+
+// Helper macro to determine if the scheduler is run by a single thread.
+#define ASIO_CONCURRENCY_HINT_IS_SINGLE_THREADED(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && (static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_SINGLE_THREADED_SCHEDULER) != 0)
+
+// Helper macro to obtain the number of reactor shards requested by a hint.
+#define ASIO_CONCURRENCY_HINT_REACTOR_SHARD_COUNT(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    ? ((static_cast<unsigned>(hint) \
+        & ASIO_CONCURRENCY_HINT_REACTOR_SHARDS_MASK) \
+          >> ASIO_CONCURRENCY_HINT_REACTOR_SHARDS_SHIFT) \
+    : 0u)
+
+// Helper macro to obtain the scheduler batch size requested by a hint.
+#define ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_SIZE(hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    ? ((static_cast<unsigned>(hint) \
+        & ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_MASK) \
+          >> ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_SHIFT) \
+    : 0u)
+
 // This special concurrency hint disables locking in both the scheduler and
 // reactor I/O. This hint has the following restrictions:
 //
@@ -78,6 +125,89 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO)
 
+// This special concurrency hint provides full thread safety, and gives each
+// thread that runs the io_context its own lock-free queue. Handlers posted
+// from within a handler are added to the current thread's queue, and threads
+// with no work steal it from their peers. This hint has the following
+// restrictions:
+//
+// - The order in which handlers are invoked is only preserved for handlers
+//   posted from the same thread.
+//
+// - Work stealing is only available when the program is compiled with support
+//   for threads and std::atomic. Otherwise this hint is equivalent to
+//   ASIO_CONCURRENCY_HINT_SAFE.
+#define ASIO_CONCURRENCY_HINT_WORK_STEALING \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO \
+      | ASIO_CONCURRENCY_HINT_WORK_STEALING_SCHEDULER)
+
+// This special concurrency hint provides full thread safety, and divides the
+// epoll reactor's descriptors among n epoll sets (where n is at most 127), so
+// that readiness events may be collected and processed by several threads at
+// once. The hint may be combined with ASIO_CONCURRENCY_HINT_WORK_STEALING
+// using bitwise or. It has no effect on other reactor implementations.
+#define ASIO_CONCURRENCY_HINT_REACTOR_SHARDS(n) \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO \
+      | ((static_cast<unsigned>(n) \
+          << ASIO_CONCURRENCY_HINT_REACTOR_SHARDS_SHIFT) \
+        & ASIO_CONCURRENCY_HINT_REACTOR_SHARDS_MASK))
+
+// This special concurrency hint provides full thread safety, and has each
+// thread that runs the io_context take up to n handlers (where n is at most 15)
+// from the scheduler's queue each time it acquires the lock. This hint has the
+// following restrictions:
+//
+// - A batch never extends past the reactor's position in the queue, so I/O
+//   completions wait for at most one batch per thread. Handlers that are not
+//   taken remain available to other threads, one of which is woken.
+//
+// - Only run() takes handlers in batches. It has no effect when combined with
+//   ASIO_CONCURRENCY_HINT_WORK_STEALING, or when the program is compiled
+//   without support for threads and std::atomic.
+//
+// The hint may be combined with ASIO_CONCURRENCY_HINT_REACTOR_SHARDS using
+// bitwise or.
+#define ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH(n) \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO \
+      | ((static_cast<unsigned>(n) \
+          << ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_SHIFT) \
+        & ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_MASK))
+
+// This special concurrency hint disables locking in the reactor I/O, and in the
+// scheduler's handler queue, for an io_context that is run by a single thread.
+// Handlers posted from within the running thread are queued without atomic
+// operations, while those posted from other threads are added to a lock-free
+// queue that the running thread checks before it runs each handler. This hint
+// has the following restrictions:
+//
+// - Care must be taken to ensure that run functions on the io_context, and all
+//   operations on the io_context's associated I/O objects (such as sockets and
+//   timers), occur in only one thread at a time. Other threads may only post,
+//   dispatch or defer handlers, track outstanding work, and call stop().
+//
+// - If no I/O object has created the reactor, it is created when the running
+//   thread has no handlers to run and must wait for more.
+//
+// - The hint cannot be combined with other special concurrency hints.
+//
+// - The single-threaded scheduler is only available when the program is
+//   compiled with support for threads and std::atomic. Otherwise this hint is
+//   equivalent to ASIO_CONCURRENCY_HINT_UNSAFE_IO.
+#define ASIO_CONCURRENCY_HINT_SINGLE_THREADED \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_ID \
+      | ASIO_CONCURRENCY_HINT_LOCKING_SCHEDULER \
+      | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
+      | ASIO_CONCURRENCY_HINT_SINGLE_THREADED_SCHEDULER)
+
 // This #define may be overridden at compile time to specify a program-wide
 // default concurrency hint, used by the zero-argument io_context constructor.
 #if !defined(ASIO_CONCURRENCY_HINT_DEFAULT)
@@ -1392,6 +1392,74 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(ASIO_HAS_EPOLL)
 # endif // !defined(ASIO_HAS_TIMERFD)
+# if !defined(ASIO_HAS_MMSG)
+#  if !defined(ASIO_DISABLE_MMSG)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#    define ASIO_HAS_MMSG 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#  endif // !defined(ASIO_DISABLE_MMSG)
+# endif // !defined(ASIO_HAS_MMSG)
+# if !defined(ASIO_HAS_UDP_GSO)
+#  if !defined(ASIO_DISABLE_UDP_GSO)
+#   define ASIO_HAS_UDP_GSO 1
+#  endif // !defined(ASIO_DISABLE_UDP_GSO)
+# endif // !defined(ASIO_HAS_UDP_GSO)
+# if !defined(ASIO_HAS_SENDFILE)
+#  if !defined(ASIO_DISABLE_SENDFILE)
+#   define ASIO_HAS_SENDFILE 1
+#  endif // !defined(ASIO_DISABLE_SENDFILE)
+# endif // !defined(ASIO_HAS_SENDFILE)
+# if !defined(ASIO_HAS_SPLICE)
+#  if !defined(ASIO_DISABLE_SPLICE)
+#   if defined(_GNU_SOURCE)
+#    define ASIO_HAS_SPLICE 1
+#   endif // defined(_GNU_SOURCE)
+#  endif // !defined(ASIO_DISABLE_SPLICE)
+# endif // !defined(ASIO_HAS_SPLICE)
+# if !defined(ASIO_HAS_THREAD_AFFINITY)
+#  if !defined(ASIO_DISABLE_THREAD_AFFINITY)
+#   if defined(_GNU_SOURCE)
+#    define ASIO_HAS_THREAD_AFFINITY 1
+#   endif // defined(_GNU_SOURCE)
+#  endif // !defined(ASIO_DISABLE_THREAD_AFFINITY)
+# endif // !defined(ASIO_HAS_THREAD_AFFINITY)
+# if !defined(ASIO_HAS_SO_BUSY_POLL)
+#  if !defined(ASIO_DISABLE_SO_BUSY_POLL)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,11,0)
+#    define ASIO_HAS_SO_BUSY_POLL 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,11,0)
+#  endif // !defined(ASIO_DISABLE_SO_BUSY_POLL)
+# endif // !defined(ASIO_HAS_SO_BUSY_POLL)
+# if !defined(ASIO_HAS_KERNEL_TLS)
+#  if !defined(ASIO_DISABLE_KERNEL_TLS)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(4,17,0)
+#    define ASIO_HAS_KERNEL_TLS 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,17,0)
+#  endif // !defined(ASIO_DISABLE_KERNEL_TLS)
+# endif // !defined(ASIO_HAS_KERNEL_TLS)
+#endif // defined(__linux__)
+
+// Linux: io_uring is used in place of epoll when explicitly enabled.
+#if defined(__linux__)
+# if !defined(ASIO_HAS_IO_URING)
+#  if defined(ASIO_ENABLE_IO_URING)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,13,0)
+#    define ASIO_HAS_IO_URING 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,13,0)
+#  endif // defined(ASIO_ENABLE_IO_URING)
+# endif // !defined(ASIO_HAS_IO_URING)
+#endif // defined(__linux__)
+
+// Linux: zero-copy sends using MSG_ZEROCOPY. Requires a reactor that watches
+// the socket error queue for completion notifications.
+#if defined(__linux__)
+# if defined(ASIO_HAS_EPOLL) || defined(ASIO_HAS_IO_URING)
+#  if !defined(ASIO_HAS_MSG_ZEROCOPY)
+#   if !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+#    define ASIO_HAS_MSG_ZEROCOPY 1
+#   endif // !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+#  endif // !defined(ASIO_HAS_MSG_ZEROCOPY)
+# endif // defined(ASIO_HAS_EPOLL) || defined(ASIO_HAS_IO_URING)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -1589,6 +1657,42 @@
 # endif // !defined(ASIO_DISABLE_THREADS)
 #endif // !defined(ASIO_HAS_THREADS)
 
+// Per-thread scheduler queues with work stealing.
+#if !defined(ASIO_HAS_WORK_STEALING)
+# if !defined(ASIO_DISABLE_WORK_STEALING)
+#  if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+#   define ASIO_HAS_WORK_STEALING 1
+#  endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+# endif // !defined(ASIO_DISABLE_WORK_STEALING)
+#endif // !defined(ASIO_HAS_WORK_STEALING)
+
+// Scheduler threads taking several handlers per acquisition of the lock.
+#if !defined(ASIO_HAS_SCHEDULER_BATCHING)
+# if !defined(ASIO_DISABLE_SCHEDULER_BATCHING)
+#  if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+#   define ASIO_HAS_SCHEDULER_BATCHING 1
+#  endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+# endif // !defined(ASIO_DISABLE_SCHEDULER_BATCHING)
+#endif // !defined(ASIO_HAS_SCHEDULER_BATCHING)
+
+// Schedulers run by a single thread that do not lock for their own handlers.
+#if !defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+# if !defined(ASIO_DISABLE_SINGLE_THREADED_SCHEDULER)
+#  if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+#   define ASIO_HAS_SINGLE_THREADED_SCHEDULER 1
+#  endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+# endif // !defined(ASIO_DISABLE_SINGLE_THREADED_SCHEDULER)
+#endif // !defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
+// Strands that queue handlers without locking a mutex.
+#if !defined(ASIO_HAS_LOCK_FREE_STRAND)
+# if !defined(ASIO_DISABLE_LOCK_FREE_STRAND)
+#  if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+#   define ASIO_HAS_LOCK_FREE_STRAND 1
+#  endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+# endif // !defined(ASIO_DISABLE_LOCK_FREE_STRAND)
+#endif // !defined(ASIO_HAS_LOCK_FREE_STRAND)
+
 // POSIX threads.
 #if !defined(ASIO_HAS_PTHREADS)
 # if defined(ASIO_HAS_THREADS)
@@ -0,0 +1,117 @@
+//
+// detail/datagram_batch_adapter.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DATAGRAM_BATCH_ADAPTER_HPP
+#define ASIO_DETAIL_DATAGRAM_BATCH_ADAPTER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include "asio/buffer.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Adapts an array of datagram records, each having buffer, endpoint and size
+// members, to the native message headers used for sendmmsg and recvmmsg. The
+// Buffer type is mutable_buffer for a receive and const_buffer for a send.
+template <typename Buffer, typename Record>
+class datagram_batch_adapter
+  : private noncopyable
+{
+public:
+  // The maximum number of datagrams transferred by one system call.
+  enum { max_datagrams = 64 };
+
+  datagram_batch_adapter(Record* records, std::size_t count)
+    : records_(records),
+      count_(count < static_cast<std::size_t>(max_datagrams)
+          ? count : static_cast<std::size_t>(max_datagrams))
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      Buffer buffer(records_[i].buffer);
+      socket_ops::init_buf(bufs_[i], buffer.data(), buffer.size());
+      socket_ops::init_mmsghdr(msgs_[i], &bufs_[i],
+          records_[i].endpoint.data(),
+          endpoint_size(static_cast<Buffer*>(0), records_[i].endpoint));
+    }
+  }
+
+  mmsghdr_type* msgs()
+  {
+    return msgs_;
+  }
+
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+  // Update the records of the datagrams that were transferred.
+  void complete(std::size_t msgs_transferred)
+  {
+    for (std::size_t i = 0; i < msgs_transferred; ++i)
+    {
+      records_[i].size = msgs_[i].msg_len;
+      update_endpoint(static_cast<Buffer*>(0), records_[i].endpoint,
+          msgs_[i].msg_hdr.msg_namelen);
+    }
+  }
+
+private:
+  template <typename Endpoint>
+  static std::size_t endpoint_size(asio::mutable_buffer*, Endpoint& e)
+  {
+    return e.capacity();
+  }
+
+  template <typename Endpoint>
+  static std::size_t endpoint_size(asio::const_buffer*, Endpoint& e)
+  {
+    return e.size();
+  }
+
+  template <typename Endpoint>
+  static void update_endpoint(asio::mutable_buffer*,
+      Endpoint& e, std::size_t size)
+  {
+    e.resize(size);
+  }
+
+  template <typename Endpoint>
+  static void update_endpoint(asio::const_buffer*, Endpoint&, std::size_t)
+  {
+  }
+
+  Record* records_;
+  std::size_t count_;
+  socket_ops::buf bufs_[max_datagrams];
+  mmsghdr_type msgs_[max_datagrams];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#endif // ASIO_DETAIL_DATAGRAM_BATCH_ADAPTER_HPP
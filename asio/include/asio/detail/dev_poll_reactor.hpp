@@ -28,6 +28,7 @@
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/reactor_op_queue.hpp"
+#include "asio/detail/reactor_statistics.hpp"
 #include "asio/detail/select_interrupter.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/detail/timer_queue_base.hpp"
@@ -138,6 +139,13 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -150,6 +158,20 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+  // Set the maximum number of events collected by each wait. The /dev/poll reactor
+  // does not collect events in batches, so the setting has no effect.
+  void set_batch_size(std::size_t)
+  {
+  }
+
+  // Get the counters that describe the waits for events. The counters are
+  // not maintained by the /dev/poll reactor.
+  reactor_statistics statistics()
+  {
+    reactor_statistics stats = { 0, 0, 0, 0 };
+    return stats;
+  }
+
 private:
   // Create the /dev/poll file descriptor. Throws an exception if the descriptor
   // cannot be created.
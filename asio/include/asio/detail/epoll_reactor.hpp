@@ -19,12 +19,16 @@
 
 #if defined(ASIO_HAS_EPOLL)
 
+#include <vector>
+#include <sys/epoll.h>
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/object_pool.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/reactor_op.hpp"
+#include "asio/detail/reactor_statistics.hpp"
 #include "asio/detail/select_interrupter.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/detail/timer_queue_base.hpp"
@@ -48,9 +52,12 @@ private:
   // The mutex type used by this reactor.
   typedef conditionally_enabled_mutex mutex;
 
+  // A secondary epoll set.
+  struct shard;
+
 public:
   enum op_types { read_op = 0, write_op = 1,
-    connect_op = 1, except_op = 2, max_ops = 3 };
+    connect_op = 1, except_op = 2, error_op = 3, max_ops = 4 };
 
   // Per-descriptor queues.
   class descriptor_state : operation
@@ -63,6 +70,7 @@ public:
 
     mutex mutex_;
     epoll_reactor* reactor_;
+    shard* shard_;
     int descriptor_;
     uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
@@ -73,6 +81,7 @@ public:
     void set_ready_events(uint32_t events) { task_result_ = events; }
     void add_ready_events(uint32_t events) { task_result_ |= events; }
     ASIO_DECL operation* perform_io(uint32_t events);
+    ASIO_DECL void perform_io(uint32_t events, op_queue<operation>& ops);
     ASIO_DECL static void do_complete(
         void* owner, operation* base,
         const asio::error_code& ec, std::size_t bytes_transferred);
@@ -170,6 +179,13 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -182,10 +198,38 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+  // Set the maximum number of events collected by each call to epoll_wait.
+  ASIO_DECL void set_batch_size(std::size_t max_events);
+
+  // Get the counters that describe the calls to epoll_wait.
+  ASIO_DECL reactor_statistics statistics();
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
 
+  // The number of events collected by the first wait on an epoll set, and the
+  // default and largest permitted limits on the number collected by a wait.
+  enum
+  {
+    initial_batch_size = 128,
+    default_max_batch_size = 1024,
+    max_batch_size_limit = 65536
+  };
+
+  // A buffer to receive the events returned by epoll_wait. The buffer is
+  // grown, up to the maximum batch size, after each wait that fills it.
+  struct event_buffer
+  {
+    event_buffer()
+      : full_(false)
+    {
+    }
+
+    std::vector<epoll_event> events_;
+    bool full_;
+  };
+
   // Create the epoll file descriptor. Throws an exception if the descriptor
   // cannot be created.
   ASIO_DECL static int do_epoll_create();
@@ -193,6 +237,62 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   ASIO_DECL static int do_timerfd_create();
 
+  // A secondary epoll set holding a subset of the registered descriptors. The
+  // set's descriptor is itself registered with the main epoll set, and the
+  // shard is returned to the scheduler as an operation when events are ready.
+  struct shard : operation
+  {
+    ASIO_DECL shard();
+    ASIO_DECL static void do_complete(
+        void* owner, operation* base,
+        const asio::error_code& ec, std::size_t bytes_transferred);
+
+    epoll_reactor* reactor_;
+    int epoll_fd_;
+    event_buffer events_;
+  };
+
+  // Create the secondary epoll sets and add them to the main epoll set.
+  ASIO_DECL void create_shards();
+
+  // Add or re-enable a secondary epoll set's registration with the main epoll
+  // set. The registration is disabled each time the set is reported as ready.
+  ASIO_DECL void arm_shard(shard* s, int op);
+
+  // Get the value registered with the main epoll set for a secondary set. The
+  // low bit is set to distinguish it from the other registrations, which are
+  // never at odd addresses.
+  static void* shard_tag(shard* s)
+  {
+    return reinterpret_cast<void*>(reinterpret_cast<uintmax_t>(s) | 1);
+  }
+
+  // Get the secondary epoll set for a value returned by the main epoll set,
+  // or 0 if the value does not belong to a secondary set.
+  static shard* tagged_shard(void* ptr)
+  {
+    uintmax_t value = reinterpret_cast<uintmax_t>(ptr);
+    return (value & 1) ? reinterpret_cast<shard*>(value ^ 1) : 0;
+  }
+
+  // Choose the epoll set to which a descriptor is added.
+  ASIO_DECL shard* choose_shard(socket_type descriptor);
+
+  // Get the epoll descriptor for the set to which a descriptor belongs.
+  int epoll_fd_for(descriptor_state* descriptor_data) const
+  {
+    return descriptor_data->shard_
+      ? descriptor_data->shard_->epoll_fd_ : epoll_fd_;
+  }
+
+  // Wait for events on an epoll set, storing them in the buffer. Returns the
+  // number of events.
+  ASIO_DECL int wait_for_events(int epoll_fd,
+      event_buffer& buffer, int timeout);
+
+  // Perform the I/O for all ready descriptors in a secondary epoll set.
+  ASIO_DECL void run_shard(shard* s);
+
   // Allocate a new descriptor state object.
   ASIO_DECL descriptor_state* allocate_descriptor_state();
 
@@ -234,6 +334,34 @@ private:
   // The timer file descriptor.
   int timer_fd_;
 
+  // Whether I/O on each descriptor is protected by the descriptor's mutex.
+  // When it is not, each descriptor's mutex is created disabled, so that
+  // start_op, cancel_ops and deregistration take no descriptor lock, and the
+  // I/O is performed by the thread running the reactor task rather than being
+  // returned to the scheduler. The registered_descriptors_mutex_ is governed
+  // separately by the REACTOR_REGISTRATION hint, as descriptors may still be
+  // registered and freed from other threads when only I/O locking is off.
+  const bool io_locking_;
+
+  // The total number of epoll sets, including the main set.
+  std::size_t num_shards_;
+
+  // The secondary epoll sets.
+  shard* shards_;
+
+  // The buffer for events from the main epoll set. Only used by the thread
+  // running the reactor task, but resized only while holding the mutex.
+  event_buffer events_;
+
+  // The maximum number of events collected by each wait. Protected by the
+  // mutex.
+  std::size_t max_batch_size_;
+
+  // Counters describing the waits on all epoll sets.
+  atomic_count waits_;
+  atomic_count events_returned_;
+  atomic_count full_batches_;
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
@@ -19,6 +19,7 @@
 
 #if defined(ASIO_HAS_EPOLL)
 
+#include <algorithm>
 #include <cstddef>
 #include <sys/epoll.h>
 #include "asio/detail/epoll_reactor.hpp"
@@ -42,6 +43,14 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     interrupter_(),
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
+    io_locking_(ASIO_CONCURRENCY_HINT_IS_LOCKING(
+          REACTOR_IO, scheduler_.concurrency_hint())),
+    num_shards_(1),
+    shards_(0),
+    max_batch_size_(default_max_batch_size),
+    waits_(0),
+    events_returned_(0),
+    full_batches_(0),
     shutdown_(false),
     registered_descriptors_mutex_(mutex_.enabled())
 {
@@ -59,6 +68,17 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     ev.data.ptr = &timer_fd_;
     epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev);
   }
+
+  // Divide the descriptors among multiple epoll sets if requested. Shards are
+  // only used when the reactor performs locking, as each secondary set may be
+  // processed by any thread that runs the scheduler.
+  std::size_t num_shards = ASIO_CONCURRENCY_HINT_REACTOR_SHARD_COUNT(
+      scheduler_.concurrency_hint());
+  if (num_shards > 1 && io_locking_)
+  {
+    num_shards_ = num_shards;
+    create_shards();
+  }
 }
 
 epoll_reactor::~epoll_reactor()
@@ -67,6 +87,10 @@ epoll_reactor::~epoll_reactor()
     close(epoll_fd_);
   if (timer_fd_ != -1)
     close(timer_fd_);
+  for (std::size_t i = 0; i + 1 < num_shards_; ++i)
+    if (shards_[i].epoll_fd_ != -1)
+      close(shards_[i].epoll_fd_);
+  delete[] shards_;
 }
 
 void epoll_reactor::shutdown()
@@ -124,6 +148,16 @@ void epoll_reactor::notify_fork(
 
     update_timeout();
 
+    // Recreate the secondary epoll sets.
+    for (std::size_t i = 0; i + 1 < num_shards_; ++i)
+    {
+      if (shards_[i].epoll_fd_ != -1)
+        ::close(shards_[i].epoll_fd_);
+      shards_[i].epoll_fd_ = -1;
+      shards_[i].epoll_fd_ = do_epoll_create();
+      arm_shard(&shards_[i], EPOLL_CTL_ADD);
+    }
+
     // Re-register all descriptors with epoll.
     mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
@@ -131,7 +165,8 @@ void epoll_reactor::notify_fork(
     {
       ev.events = state->registered_events_;
       ev.data.ptr = state;
-      int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
+      int result = epoll_ctl(epoll_fd_for(state),
+          EPOLL_CTL_ADD, state->descriptor_, &ev);
       if (result != 0)
       {
         asio::error_code ec(errno,
@@ -160,6 +195,7 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
     descriptor_data->reactor_ = this;
+    descriptor_data->shard_ = choose_shard(descriptor);
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
     for (int i = 0; i < max_ops; ++i)
@@ -170,7 +206,8 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
   ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
   descriptor_data->registered_events_ = ev.events;
   ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+  int result = epoll_ctl(epoll_fd_for(descriptor_data),
+      EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
   {
     if (errno == EPERM)
@@ -202,6 +239,7 @@ int epoll_reactor::register_internal_descriptor(
     mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
     descriptor_data->reactor_ = this;
+    descriptor_data->shard_ = 0;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
     descriptor_data->op_queue_[op_type].push(op);
@@ -257,6 +295,12 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       {
         if (reactor_op::status status = op->perform())
         {
+          if (status == reactor_op::wait_for_error)
+          {
+            descriptor_data->op_queue_[error_op].push(op);
+            scheduler_.work_started();
+            return;
+          }
           if (status == reactor_op::done_and_exhausted)
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
@@ -280,7 +324,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
           epoll_event ev = { 0, { 0 } };
           ev.events = descriptor_data->registered_events_ | EPOLLOUT;
           ev.data.ptr = descriptor_data;
-          if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0)
+          if (epoll_ctl(epoll_fd_for(descriptor_data),
+                EPOLL_CTL_MOD, descriptor, &ev) == 0)
           {
             descriptor_data->registered_events_ |= ev.events;
           }
@@ -310,7 +355,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       epoll_event ev = { 0, { 0 } };
       ev.events = descriptor_data->registered_events_;
       ev.data.ptr = descriptor_data;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
+      epoll_ctl(epoll_fd_for(descriptor_data),
+          EPOLL_CTL_MOD, descriptor, &ev);
     }
   }
 
@@ -329,6 +375,11 @@ void epoll_reactor::cancel_ops(socket_type,
   op_queue<operation> ops;
   for (int i = 0; i < max_ops; ++i)
   {
+    // A zero-copy send waiting for its notification has already sent its data
+    // and cannot be aborted, as the kernel still owns the buffers.
+    if (i == error_op)
+      continue;
+
     while (reactor_op* op = descriptor_data->op_queue_[i].front())
     {
       op->ec_ = asio::error::operation_aborted;
@@ -360,7 +411,8 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
     else if (descriptor_data->registered_events_ != 0)
     {
       epoll_event ev = { 0, { 0 } };
-      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+      epoll_ctl(epoll_fd_for(descriptor_data),
+          EPOLL_CTL_DEL, descriptor, &ev);
     }
 
     op_queue<operation> ops;
@@ -368,7 +420,11 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
     {
       while (reactor_op* op = descriptor_data->op_queue_[i].front())
       {
-        op->ec_ = asio::error::operation_aborted;
+        // A zero-copy send waiting for its notification has already sent its
+        // data. The notification cannot be received once the descriptor is
+        // deregistered, so the send completes with its result.
+        if (i != error_op)
+          op->ec_ = asio::error::operation_aborted;
         descriptor_data->op_queue_[i].pop();
         ops.push(op);
       }
@@ -407,7 +463,8 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
   if (!descriptor_data->shutdown_)
   {
     epoll_event ev = { 0, { 0 } };
-    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+    epoll_ctl(epoll_fd_for(descriptor_data),
+        EPOLL_CTL_DEL, descriptor, &ev);
 
     op_queue<operation> ops;
     for (int i = 0; i < max_ops; ++i)
@@ -466,8 +523,8 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   }
 
   // Block on the epoll descriptor.
-  epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  int num_events = wait_for_events(epoll_fd_, events_, timeout);
+  epoll_event* events = num_events > 0 ? &events_.events_[0] : 0;
 
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
@@ -484,6 +541,10 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       // Ignore.
     }
 # endif // defined(ASIO_HAS_TIMERFD)
+    else if (tagged_shard(ptr))
+    {
+      // Ignore.
+    }
     else
     {
       unsigned event_mask = 0;
@@ -529,6 +590,21 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       check_timers = true;
     }
 #endif // defined(ASIO_HAS_TIMERFD)
+    else if (shard* s = tagged_shard(ptr))
+    {
+      // The secondary epoll set's registration is one-shot, so the shard
+      // cannot be returned again until it has been processed and rearmed. As
+      // with descriptor operations, the shard doesn't count as work.
+      ops.push(s);
+    }
+    else if (!io_locking_)
+    {
+      // Without locking, only one thread at a time may perform I/O, so there
+      // is nothing to gain by returning the descriptor to the scheduler. The
+      // I/O is performed here, and the completed operations, which have
+      // already been counted as work, are returned directly.
+      static_cast<descriptor_state*>(ptr)->perform_io(events[i].events, ops);
+    }
     else
     {
       // The descriptor operation doesn't count as work in and of itself, so we
@@ -572,6 +648,66 @@ void epoll_reactor::interrupt()
   epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
 }
 
+void epoll_reactor::set_batch_size(std::size_t max_events)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (max_events < 1)
+    max_events = 1;
+  else if (max_events > max_batch_size_limit)
+    max_events = max_batch_size_limit;
+  max_batch_size_ = max_events;
+}
+
+reactor_statistics epoll_reactor::statistics()
+{
+  mutex::scoped_lock lock(mutex_);
+  reactor_statistics stats;
+  stats.waits = static_cast<std::size_t>(waits_);
+  stats.events = static_cast<std::size_t>(events_returned_);
+  stats.full_batches = static_cast<std::size_t>(full_batches_);
+  if (events_.events_.empty())
+    stats.batch_size = (std::min)(
+        static_cast<std::size_t>(initial_batch_size), max_batch_size_);
+  else
+    stats.batch_size = events_.events_.size();
+  return stats;
+}
+
+int epoll_reactor::wait_for_events(int epoll_fd,
+    epoll_reactor::event_buffer& buffer, int timeout)
+{
+  // Size the buffer on first use, and grow it after a wait that filled it.
+  // The buffer is only resized while holding the mutex, so that the
+  // statistics can report its size.
+  if (buffer.events_.empty() || buffer.full_)
+  {
+    mutex::scoped_lock lock(mutex_);
+    std::size_t size = buffer.events_.empty()
+      ? static_cast<std::size_t>(initial_batch_size)
+      : buffer.events_.size() * 2;
+    size = (std::min)(size, max_batch_size_);
+    if (size != buffer.events_.size())
+      std::vector<epoll_event>(size).swap(buffer.events_);
+    buffer.full_ = false;
+  }
+
+  int num_events = epoll_wait(epoll_fd, &buffer.events_[0],
+      static_cast<int>(buffer.events_.size()), timeout);
+
+  ++waits_;
+  if (num_events > 0)
+  {
+    increment(events_returned_, num_events);
+    if (static_cast<std::size_t>(num_events) == buffer.events_.size())
+    {
+      ++full_batches_;
+      buffer.full_ = true;
+    }
+  }
+
+  return num_events;
+}
+
 int epoll_reactor::do_epoll_create()
 {
 #if defined(EPOLL_CLOEXEC)
@@ -621,11 +757,60 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(ASIO_HAS_TIMERFD)
 }
 
+void epoll_reactor::create_shards()
+{
+  shards_ = new shard[num_shards_ - 1];
+  for (std::size_t i = 0; i + 1 < num_shards_; ++i)
+  {
+    shards_[i].reactor_ = this;
+    shards_[i].epoll_fd_ = do_epoll_create();
+    arm_shard(&shards_[i], EPOLL_CTL_ADD);
+  }
+}
+
+void epoll_reactor::arm_shard(epoll_reactor::shard* s, int op)
+{
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLONESHOT;
+  ev.data.ptr = shard_tag(s);
+  epoll_ctl(epoll_fd_, op, s->epoll_fd_, &ev);
+}
+
+epoll_reactor::shard* epoll_reactor::choose_shard(socket_type descriptor)
+{
+  // The main epoll set takes its share of descriptors as the first shard.
+  std::size_t index = static_cast<std::size_t>(descriptor) % num_shards_;
+  return index == 0 ? 0 : &shards_[index - 1];
+}
+
+void epoll_reactor::run_shard(epoll_reactor::shard* s)
+{
+  int num_events = wait_for_events(s->epoll_fd_, s->events_, 0);
+  epoll_event* events = num_events > 0 ? &s->events_.events_[0] : 0;
+
+  // Perform the I/O in this thread. The descriptor state objects cannot be
+  // returned to the scheduler, as a later pass over the same epoll set may
+  // run before they are dequeued.
+  op_queue<operation> ops;
+  for (int i = 0; i < num_events; ++i)
+  {
+    descriptor_state* descriptor_data
+      = static_cast<descriptor_state*>(events[i].data.ptr);
+    mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+    descriptor_data->perform_io(events[i].events, ops);
+  }
+
+  arm_shard(s, EPOLL_CTL_MOD);
+
+  // Each completed operation has already been counted as work, so the
+  // operations are posted as deferred completions.
+  scheduler_.post_deferred_completions(ops);
+}
+
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
-  return registered_descriptors_.alloc(ASIO_CONCURRENCY_HINT_IS_LOCKING(
-        REACTOR_IO, scheduler_.concurrency_hint()));
+  return registered_descriptors_.alloc(io_locking_);
 }
 
 void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
@@ -729,9 +914,21 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   perform_io_cleanup_on_block_exit io_cleanup(reactor_);
   mutex::scoped_lock descriptor_lock(mutex_, mutex::scoped_lock::adopt_lock);
 
+  perform_io(events, io_cleanup.ops_);
+
+  // The first operation will be returned for completion now. The others will
+  // be posted for later by the io_cleanup object's destructor.
+  io_cleanup.first_op_ = io_cleanup.ops_.front();
+  io_cleanup.ops_.pop();
+  return io_cleanup.first_op_;
+}
+
+void epoll_reactor::descriptor_state::perform_io(
+    uint32_t events, op_queue<operation>& ops)
+{
   // Exception operations must be processed first to ensure that any
   // out-of-band data is read before normal data.
-  static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
+  static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI, EPOLLERR };
   for (int j = max_ops - 1; j >= 0; --j)
   {
     if (events & (flag[j] | EPOLLERR | EPOLLHUP))
@@ -742,7 +939,12 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
         if (reactor_op::status status = op->perform())
         {
           op_queue_[j].pop();
-          io_cleanup.ops_.push(op);
+          if (status == reactor_op::wait_for_error)
+          {
+            op_queue_[error_op].push(op);
+            continue;
+          }
+          ops.push(op);
           if (status == reactor_op::done_and_exhausted)
           {
             try_speculative_[j] = false;
@@ -754,12 +956,6 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
       }
     }
   }
-
-  // The first operation will be returned for completion now. The others will
-  // be posted for later by the io_cleanup object's destructor.
-  io_cleanup.first_op_ = io_cleanup.ops_.front();
-  io_cleanup.ops_.pop();
-  return io_cleanup.first_op_;
 }
 
 void epoll_reactor::descriptor_state::do_complete(
@@ -777,6 +973,29 @@ void epoll_reactor::descriptor_state::do_complete(
   }
 }
 
+epoll_reactor::shard::shard()
+  : operation(&epoll_reactor::shard::do_complete),
+    reactor_(0),
+    epoll_fd_(-1)
+{
+}
+
+void epoll_reactor::shard::do_complete(
+    void* owner, operation* base,
+    const asio::error_code& /*ec*/, std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    shard* s = static_cast<shard*>(base);
+    s->reactor_->run_shard(s);
+
+    // The shard is not a user-initiated operation, so we need to compensate
+    // for the work_finished() call that the scheduler will make once this
+    // operation returns.
+    s->reactor_->scheduler_.compensating_work_started();
+  }
+}
+
 } // namespace detail
 } // namespace asio
 
@@ -0,0 +1,1230 @@
+//
+// detail/impl/io_uring_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+#define ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <cstddef>
+#include <cstring>
+#include <endian.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+namespace io_uring_ops {
+
+inline int setup(unsigned entries, io_uring_params* params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int enter(int fd, unsigned to_submit, unsigned min_complete,
+    unsigned flags, const void* arg, std::size_t arg_size)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter,
+        fd, to_submit, min_complete, flags, arg, arg_size));
+}
+
+inline __u32 poll_events(uint32_t events)
+{
+#if __BYTE_ORDER == __BIG_ENDIAN
+  // The kernel expects the two 16-bit halves of the mask to be swapped.
+  events = (events << 16) | (events >> 16);
+#endif // __BYTE_ORDER == __BIG_ENDIAN
+  return events;
+}
+
+} // namespace io_uring_ops
+
+io_uring_service::io_uring_service(asio::execution_context& ctx)
+  : execution_context_service_base<io_uring_service>(ctx),
+    scheduler_(use_service<scheduler>(ctx)),
+    mutex_(ASIO_CONCURRENCY_HINT_IS_LOCKING(
+          REACTOR_REGISTRATION, scheduler_.concurrency_hint())),
+    submit_mutex_(mutex_.enabled()
+        || ASIO_CONCURRENCY_HINT_IS_LOCKING(
+          REACTOR_IO, scheduler_.concurrency_hint())),
+    ring_fd_(do_io_uring_setup(ring_)),
+    pending_sqes_(0),
+    waiting_(false),
+    interrupt_pending_(false),
+    timeout_armed_(false),
+    shutdown_(false),
+    registered_descriptors_mutex_(mutex_.enabled())
+{
+  // Leave the ring in an interrupted state, as the epoll reactor does with its
+  // interrupter, so that the first call to run() returns promptly.
+  interrupt();
+}
+
+io_uring_service::~io_uring_service()
+{
+  if (ring_fd_ != -1)
+    do_io_uring_teardown(ring_fd_, ring_);
+}
+
+void io_uring_service::shutdown()
+{
+  mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+  lock.unlock();
+
+  // Submitted operations must be cancelled, and their completions delivered,
+  // before the kernel has finished with their buffers.
+  mutex::scoped_lock submit_lock(submit_mutex_);
+  std::size_t submitted = 0;
+  for (descriptor_state* state = registered_descriptors_.first();
+      state != 0; state = state->next_)
+  {
+    for (int i = 0; i < max_ops; ++i)
+      for (reactor_op* op = state->submitted_ops_[i].front();
+          op != 0; op = op_queue_access::next(op))
+        ++submitted;
+    prep_cancel_submissions(state);
+  }
+  while (submitted > 0)
+  {
+    int result = io_uring_ops::enter(ring_fd_,
+        pending_sqes_, 1, IORING_ENTER_GETEVENTS, 0, 0);
+    if (result >= 0)
+      pending_sqes_ -= static_cast<unsigned>(result);
+    else if (errno != EINTR)
+      break;
+
+    unsigned head = *ring_.cq_head;
+    unsigned tail = __atomic_load_n(ring_.cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+      if (ring_.cqes[head & ring_.cq_mask].user_data & submitted_op_flag)
+        --submitted;
+    __atomic_store_n(ring_.cq_head, head, __ATOMIC_RELEASE);
+  }
+  submit_lock.unlock();
+
+  op_queue<operation> ops;
+
+  while (descriptor_state* state = registered_descriptors_.first())
+  {
+    for (int i = 0; i < max_ops; ++i)
+    {
+      ops.push(state->op_queue_[i]);
+      ops.push(state->submitted_ops_[i]);
+    }
+    state->shutdown_ = true;
+    registered_descriptors_.free(state);
+  }
+
+  timer_queues_.get_all_timers(ops);
+
+  scheduler_.abandon_operations(ops);
+}
+
+void io_uring_service::notify_fork(
+    asio::execution_context::fork_event fork_ev)
+{
+  if (fork_ev == asio::execution_context::fork_child)
+  {
+    // The rings are shared with the parent process, so the child must stop
+    // using them immediately and create a ring of its own.
+    if (ring_fd_ != -1)
+      do_io_uring_teardown(ring_fd_, ring_);
+    ring_fd_ = -1;
+    ring_fd_ = do_io_uring_setup(ring_);
+
+    mutex::scoped_lock submit_lock(submit_mutex_);
+    pending_sqes_ = 0;
+    waiting_ = false;
+    interrupt_pending_ = false;
+    timeout_armed_ = false;
+    submit_lock.unlock();
+
+    interrupt();
+
+    // Re-arm poll requests and resubmit operations for all registered
+    // descriptors. Operations submitted against deregistered descriptors will
+    // never complete in the child, so they are aborted instead.
+    op_queue<operation> ops;
+    mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+    descriptor_state* state = registered_descriptors_.first();
+    while (state != 0)
+    {
+      descriptor_state* next_state = state->next_;
+      if (state->shutdown_ || state->free_pending_)
+      {
+        for (int i = 0; i < max_ops; ++i)
+        {
+          while (reactor_op* op = state->submitted_ops_[i].front())
+          {
+            op->ec_ = asio::error::operation_aborted;
+            state->submitted_ops_[i].pop();
+            ops.push(op);
+          }
+        }
+      }
+
+      if (state->free_pending_)
+      {
+        registered_descriptors_.free(state);
+      }
+      else
+      {
+        state->poll_armed_ = false;
+        if (!state->shutdown_)
+        {
+          submit_lock.lock();
+          if (state->registered_events_ != 0 && !prep_poll_add(state))
+          {
+            asio::error_code ec(asio::error::no_buffer_space);
+            asio::detail::throw_error(ec, "io_uring re-registration");
+          }
+          for (int i = 0; i < max_ops; ++i)
+          {
+            op_queue<reactor_op> submitted_ops;
+            submitted_ops.push(state->submitted_ops_[i]);
+            while (reactor_op* op = submitted_ops.front())
+            {
+              submitted_ops.pop();
+              io_uring_sqe sqe;
+              std::memset(&sqe, 0, sizeof(sqe));
+              if (!op->prepare_submission(sqe)
+                  || !prep_submission(state, i, op, sqe))
+              {
+                asio::error_code ec(asio::error::no_buffer_space);
+                asio::detail::throw_error(ec, "io_uring re-registration");
+              }
+            }
+          }
+          submit_lock.unlock();
+        }
+      }
+      state = next_state;
+    }
+    descriptors_lock.unlock();
+
+    scheduler_.post_deferred_completions(ops);
+  }
+}
+
+void io_uring_service::init_task()
+{
+  scheduler_.init_task();
+}
+
+int io_uring_service::register_descriptor(socket_type descriptor,
+    io_uring_service::per_descriptor_data& descriptor_data)
+{
+  struct stat st;
+  if (::fstat(descriptor, &st) != 0)
+  {
+    descriptor_data = 0;
+    return errno;
+  }
+
+  descriptor_data = allocate_descriptor_state();
+
+  ASIO_HANDLER_REACTOR_REGISTRATION((
+        context(), static_cast<uintmax_t>(descriptor),
+        reinterpret_cast<uintmax_t>(descriptor_data)));
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->service_ = this;
+  descriptor_data->descriptor_ = descriptor;
+  descriptor_data->shutdown_ = false;
+  descriptor_data->poll_armed_ = false;
+  descriptor_data->free_pending_ = false;
+  for (int i = 0; i < max_ops; ++i)
+    descriptor_data->try_speculative_[i] = true;
+
+  if (S_ISREG(st.st_mode) || S_ISDIR(st.st_mode))
+  {
+    // This file descriptor type is not supported by epoll, and a poll request
+    // would complete immediately. However, if it is a regular file then
+    // operations on it will not block. We will allow this descriptor to be
+    // used and fail later if an operation on it would otherwise require a
+    // trip through the reactor.
+    descriptor_data->registered_events_ = 0;
+    return 0;
+  }
+
+  descriptor_data->registered_events_ = POLLIN | POLLERR | POLLHUP | POLLPRI;
+
+  mutex::scoped_lock submit_lock(submit_mutex_);
+  if (!prep_poll_add(descriptor_data))
+    return ENOBUFS;
+  submit_sqes(false);
+
+  return 0;
+}
+
+int io_uring_service::register_internal_descriptor(
+    int op_type, socket_type descriptor,
+    io_uring_service::per_descriptor_data& descriptor_data, reactor_op* op)
+{
+  descriptor_data = allocate_descriptor_state();
+
+  ASIO_HANDLER_REACTOR_REGISTRATION((
+        context(), static_cast<uintmax_t>(descriptor),
+        reinterpret_cast<uintmax_t>(descriptor_data)));
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  descriptor_data->service_ = this;
+  descriptor_data->descriptor_ = descriptor;
+  descriptor_data->shutdown_ = false;
+  descriptor_data->poll_armed_ = false;
+  descriptor_data->free_pending_ = false;
+  descriptor_data->op_queue_[op_type].push(op);
+  for (int i = 0; i < max_ops; ++i)
+    descriptor_data->try_speculative_[i] = true;
+  descriptor_data->registered_events_ = POLLIN | POLLERR | POLLHUP | POLLPRI;
+
+  mutex::scoped_lock submit_lock(submit_mutex_);
+  if (!prep_poll_add(descriptor_data))
+    return ENOBUFS;
+  submit_sqes(false);
+
+  return 0;
+}
+
+void io_uring_service::move_descriptor(socket_type,
+    io_uring_service::per_descriptor_data& target_descriptor_data,
+    io_uring_service::per_descriptor_data& source_descriptor_data)
+{
+  target_descriptor_data = source_descriptor_data;
+  source_descriptor_data = 0;
+}
+
+void io_uring_service::start_op(int op_type, socket_type,
+    io_uring_service::per_descriptor_data& descriptor_data, reactor_op* op,
+    bool is_continuation, bool allow_speculative)
+{
+  if (!descriptor_data)
+  {
+    op->ec_ = asio::error::bad_descriptor;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+  {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  if (descriptor_data->op_queue_[op_type].empty())
+  {
+    if ((op_type == read_op || op_type == write_op)
+        && descriptor_data->registered_events_ != 0
+        && (op_type != read_op
+          || descriptor_data->op_queue_[except_op].empty()))
+    {
+      // Submit the operation itself, if it supports it, rather than waiting
+      // for the descriptor to become ready.
+      io_uring_sqe sqe;
+      std::memset(&sqe, 0, sizeof(sqe));
+      if (op->prepare_submission(sqe))
+      {
+        mutex::scoped_lock submit_lock(submit_mutex_);
+        if (!prep_submission(descriptor_data, op_type, op, sqe))
+        {
+          submit_lock.unlock();
+          op->ec_ = asio::error::no_buffer_space;
+          scheduler_.post_immediate_completion(op, is_continuation);
+          return;
+        }
+        scheduler_.work_started();
+        submit_sqes(false);
+        return;
+      }
+    }
+
+    if (allow_speculative
+        && (op_type != read_op
+          || descriptor_data->op_queue_[except_op].empty()))
+    {
+      if (descriptor_data->try_speculative_[op_type])
+      {
+        if (reactor_op::status status = op->perform())
+        {
+          if (status == reactor_op::wait_for_error)
+          {
+            descriptor_data->op_queue_[error_op].push(op);
+            scheduler_.work_started();
+            return;
+          }
+          if (status == reactor_op::done_and_exhausted)
+            if (descriptor_data->registered_events_ != 0)
+              descriptor_data->try_speculative_[op_type] = false;
+          descriptor_lock.unlock();
+          scheduler_.post_immediate_completion(op, is_continuation);
+          return;
+        }
+      }
+
+      if (descriptor_data->registered_events_ == 0)
+      {
+        op->ec_ = asio::error::operation_not_supported;
+        scheduler_.post_immediate_completion(op, is_continuation);
+        return;
+      }
+
+      if (op_type == write_op)
+      {
+        if ((descriptor_data->registered_events_ & POLLOUT) == 0)
+        {
+          descriptor_data->registered_events_ |= POLLOUT;
+          mutex::scoped_lock submit_lock(submit_mutex_);
+          if (!prep_poll_update(descriptor_data))
+          {
+            descriptor_data->registered_events_ &= ~POLLOUT;
+            submit_lock.unlock();
+            op->ec_ = asio::error::no_buffer_space;
+            scheduler_.post_immediate_completion(op, is_continuation);
+            return;
+          }
+          submit_sqes(false);
+        }
+      }
+    }
+    else if (descriptor_data->registered_events_ == 0)
+    {
+      op->ec_ = asio::error::operation_not_supported;
+      scheduler_.post_immediate_completion(op, is_continuation);
+      return;
+    }
+    else
+    {
+      uint32_t old_events = descriptor_data->registered_events_;
+      if (op_type == write_op)
+      {
+        descriptor_data->registered_events_ |= POLLOUT;
+      }
+
+      // Updating the poll request re-evaluates the descriptor's readiness, so
+      // the operation will be performed even if the descriptor is already
+      // ready.
+      mutex::scoped_lock submit_lock(submit_mutex_);
+      if (!prep_poll_update(descriptor_data))
+      {
+        descriptor_data->registered_events_ = old_events;
+        submit_lock.unlock();
+        op->ec_ = asio::error::no_buffer_space;
+        scheduler_.post_immediate_completion(op, is_continuation);
+        return;
+      }
+      submit_sqes(false);
+    }
+  }
+
+  descriptor_data->op_queue_[op_type].push(op);
+  scheduler_.work_started();
+}
+
+void io_uring_service::cancel_ops(socket_type,
+    io_uring_service::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  // Submitted operations complete with operation_aborted once the kernel has
+  // delivered the completion of the cancelled request.
+  mutex::scoped_lock submit_lock(submit_mutex_);
+  prep_cancel_submissions(descriptor_data);
+  submit_sqes(false);
+  submit_lock.unlock();
+
+  op_queue<operation> ops;
+  for (int i = 0; i < max_ops; ++i)
+  {
+    // A zero-copy send waiting for its notification has already sent its data
+    // and cannot be aborted, as the kernel still owns the buffers.
+    if (i == error_op)
+      continue;
+
+    while (reactor_op* op = descriptor_data->op_queue_[i].front())
+    {
+      op->ec_ = asio::error::operation_aborted;
+      descriptor_data->op_queue_[i].pop();
+      ops.push(op);
+    }
+  }
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+void io_uring_service::deregister_descriptor(socket_type descriptor,
+    io_uring_service::per_descriptor_data& descriptor_data, bool)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    // Unlike an epoll registration, a poll request or submitted operation
+    // holds a reference to the underlying file. They must be removed even when
+    // the descriptor is about to be closed, and the removal must reach the
+    // kernel before the close.
+    mutex::scoped_lock submit_lock(submit_mutex_);
+    if (descriptor_data->poll_armed_)
+      prep_poll_remove(descriptor_data);
+    prep_cancel_submissions(descriptor_data);
+    submit_sqes(true);
+    submit_lock.unlock();
+
+    op_queue<operation> ops;
+    for (int i = 0; i < max_ops; ++i)
+    {
+      while (reactor_op* op = descriptor_data->op_queue_[i].front())
+      {
+        // A zero-copy send waiting for its notification has already sent its
+        // data. The notification cannot be received once the descriptor is
+        // deregistered, so the send completes with its result.
+        if (i != error_op)
+          op->ec_ = asio::error::operation_aborted;
+        descriptor_data->op_queue_[i].pop();
+        ops.push(op);
+      }
+    }
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->shutdown_ = true;
+
+    descriptor_lock.unlock();
+
+    ASIO_HANDLER_REACTOR_DEREGISTRATION((
+          context(), static_cast<uintmax_t>(descriptor),
+          reinterpret_cast<uintmax_t>(descriptor_data)));
+
+    scheduler_.post_deferred_completions(ops);
+
+    // Leave descriptor_data set so that it will be freed by the subsequent
+    // call to cleanup_descriptor_data.
+  }
+  else
+  {
+    // We are shutting down, so prevent cleanup_descriptor_data from freeing
+    // the descriptor_data object and let the destructor free it instead.
+    descriptor_data = 0;
+  }
+}
+
+void io_uring_service::deregister_internal_descriptor(socket_type descriptor,
+    io_uring_service::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_)
+  {
+    if (descriptor_data->poll_armed_)
+    {
+      mutex::scoped_lock submit_lock(submit_mutex_);
+      prep_poll_remove(descriptor_data);
+      submit_sqes(true);
+    }
+
+    op_queue<operation> ops;
+    for (int i = 0; i < max_ops; ++i)
+      ops.push(descriptor_data->op_queue_[i]);
+
+    descriptor_data->descriptor_ = -1;
+    descriptor_data->shutdown_ = true;
+
+    descriptor_lock.unlock();
+
+    ASIO_HANDLER_REACTOR_DEREGISTRATION((
+          context(), static_cast<uintmax_t>(descriptor),
+          reinterpret_cast<uintmax_t>(descriptor_data)));
+
+    // Leave descriptor_data set so that it will be freed by the subsequent
+    // call to cleanup_descriptor_data.
+  }
+  else
+  {
+    // We are shutting down, so prevent cleanup_descriptor_data from freeing
+    // the descriptor_data object and let the destructor free it instead.
+    descriptor_data = 0;
+  }
+}
+
+void io_uring_service::cleanup_descriptor_data(
+    per_descriptor_data& descriptor_data)
+{
+  if (descriptor_data)
+  {
+    mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+    bool submitted = false;
+    for (int i = 0; i < max_ops; ++i)
+      submitted = submitted || !descriptor_data->submitted_ops_[i].empty();
+    if (descriptor_data->poll_armed_ || submitted)
+    {
+      // The object will be freed when the final completion for the poll
+      // request or a submitted operation is delivered by run().
+      descriptor_data->free_pending_ = true;
+    }
+    else
+    {
+      descriptor_lock.unlock();
+      free_descriptor_state(descriptor_data);
+    }
+    descriptor_data = 0;
+  }
+}
+
+void io_uring_service::run(long usec, op_queue<operation>& ops)
+{
+  // This code relies on the fact that the scheduler queues the reactor task
+  // behind all descriptor operations generated by this function. This means,
+  // that by the time we reach this point, any previously returned descriptor
+  // operations have already been dequeued. Therefore it is now safe for us to
+  // reuse and return them for the scheduler to queue again.
+
+  // Calculate timeout.
+  long timeout_usec = 0;
+  if (usec != 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    timeout_usec = get_timeout(usec);
+  }
+
+  // Submit all queued entries and block until at least one completion is
+  // available, the timeout request completes, or we are interrupted. If the
+  // timeout request cannot be queued we must not block.
+  mutex::scoped_lock submit_lock(submit_mutex_);
+  bool wait = timeout_usec != 0 && prep_timeout(timeout_usec);
+  unsigned to_submit = pending_sqes_;
+  pending_sqes_ = 0;
+  waiting_ = wait;
+  submit_lock.unlock();
+
+  int result = io_uring_ops::enter(ring_fd_, to_submit,
+      wait ? 1 : 0, IORING_ENTER_GETEVENTS, 0, 0);
+  unsigned submitted = result > 0 ? static_cast<unsigned>(result) : 0;
+
+  submit_lock.lock();
+  waiting_ = false;
+  if (submitted < to_submit)
+    pending_sqes_ += to_submit - submitted;
+  submit_lock.unlock();
+
+  // Dispatch the completions.
+  unsigned head = *ring_.cq_head;
+  unsigned tail = __atomic_load_n(ring_.cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head)
+  {
+    const io_uring_cqe& cqe = ring_.cqes[head & ring_.cq_mask];
+    void* ptr = reinterpret_cast<void*>(cqe.user_data);
+    if (ptr == 0)
+    {
+      // Completion of a poll update or removal. Ignore.
+    }
+    else if (ptr == &ring_fd_)
+    {
+      submit_lock.lock();
+      interrupt_pending_ = false;
+      submit_lock.unlock();
+    }
+    else if (ptr == &timeout_)
+    {
+      submit_lock.lock();
+      timeout_armed_ = false;
+      submit_lock.unlock();
+    }
+    else if (cqe.user_data & submitted_op_flag)
+    {
+      complete_submission(cqe, ops);
+    }
+    else
+    {
+      // The descriptor operation doesn't count as work in and of itself, so we
+      // don't call work_started() here. This still allows the scheduler to
+      // stop if the only remaining operations are descriptor operations.
+      descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
+      uint32_t events = cqe.res > 0 ? static_cast<uint32_t>(cqe.res) : 0;
+
+      if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+      {
+        // The kernel has terminated the poll request. Free the state if its
+        // owner has already finished with it, otherwise re-arm the request.
+        mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+        descriptor_data->poll_armed_ = false;
+        if (descriptor_data->free_pending_)
+        {
+          bool submitted = false;
+          for (int i = 0; i < max_ops; ++i)
+            submitted = submitted
+              || !descriptor_data->submitted_ops_[i].empty();
+          descriptor_lock.unlock();
+          if (!submitted)
+            free_descriptor_state(descriptor_data);
+          continue;
+        }
+
+        if (descriptor_data->shutdown_)
+          continue;
+
+        if (cqe.res >= 0 || cqe.res == -ECANCELED)
+        {
+          submit_lock.lock();
+          prep_poll_add(descriptor_data);
+          submit_sqes(false);
+          submit_lock.unlock();
+        }
+        else
+        {
+          // The descriptor cannot be polled. Flag an error so that pending
+          // operations are performed and discover the failure themselves.
+          events = POLLERR;
+        }
+      }
+
+      if (events != 0)
+      {
+#if defined(ASIO_ENABLE_HANDLER_TRACKING)
+        unsigned event_mask = 0;
+        if ((events & POLLIN) != 0)
+          event_mask |= ASIO_HANDLER_REACTOR_READ_EVENT;
+        if ((events & POLLOUT))
+          event_mask |= ASIO_HANDLER_REACTOR_WRITE_EVENT;
+        if ((events & (POLLERR | POLLHUP)) != 0)
+          event_mask |= ASIO_HANDLER_REACTOR_ERROR_EVENT;
+        ASIO_HANDLER_REACTOR_EVENTS((context(),
+              reinterpret_cast<uintmax_t>(ptr), event_mask));
+#endif // defined(ASIO_ENABLE_HANDLER_TRACKING)
+
+        if (!ops.is_enqueued(descriptor_data))
+        {
+          descriptor_data->set_ready_events(events);
+          ops.push(descriptor_data);
+        }
+        else
+        {
+          descriptor_data->add_ready_events(events);
+        }
+      }
+    }
+  }
+  __atomic_store_n(ring_.cq_head, head, __ATOMIC_RELEASE);
+
+  mutex::scoped_lock common_lock(mutex_);
+  timer_queues_.get_ready_timers(ops);
+}
+
+void io_uring_service::interrupt()
+{
+  mutex::scoped_lock submit_lock(submit_mutex_);
+  if (!interrupt_pending_)
+  {
+    io_uring_sqe sqe;
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_NOP;
+    sqe.user_data = reinterpret_cast<__u64>(&ring_fd_);
+    if (push_sqe(sqe))
+      interrupt_pending_ = true;
+  }
+  submit_sqes(false);
+}
+
+int io_uring_service::do_io_uring_setup(io_uring_service::ring& r)
+{
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = completion_ring_size;
+
+  int fd = io_uring_ops::setup(ring_size, &params);
+  if (fd == -1)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "io_uring");
+  }
+
+  // Completions must never be dropped.
+  if ((params.features & IORING_FEAT_NODROP) == 0)
+  {
+    ::close(fd);
+    asio::error_code ec(asio::error::operation_not_supported);
+    asio::detail::throw_error(ec, "io_uring");
+  }
+
+  std::memset(&r, 0, sizeof(r));
+  r.sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  r.cq_map_size = params.cq_off.cqes
+    + params.cq_entries * sizeof(io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+  {
+    if (r.cq_map_size > r.sq_map_size)
+      r.sq_map_size = r.cq_map_size;
+    r.cq_map_size = r.sq_map_size;
+  }
+  r.sqes_map_size = params.sq_entries * sizeof(io_uring_sqe);
+
+  r.sq_ptr = ::mmap(0, r.sq_map_size, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (r.sq_ptr != MAP_FAILED)
+  {
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+      r.cq_ptr = r.sq_ptr;
+    else
+      r.cq_ptr = ::mmap(0, r.cq_map_size, PROT_READ | PROT_WRITE,
+          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (r.cq_ptr != MAP_FAILED)
+    {
+      void* sqes = ::mmap(0, r.sqes_map_size, PROT_READ | PROT_WRITE,
+          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+      if (sqes != MAP_FAILED)
+        r.sqes = static_cast<io_uring_sqe*>(sqes);
+    }
+    else
+      r.cq_ptr = 0;
+  }
+  else
+    r.sq_ptr = 0;
+
+  if (r.sqes == 0)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    do_io_uring_teardown(fd, r);
+    asio::detail::throw_error(ec, "io_uring");
+  }
+
+  char* sq = static_cast<char*>(r.sq_ptr);
+  r.sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  r.sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  r.sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  r.sq_entries = *reinterpret_cast<unsigned*>(
+      sq + params.sq_off.ring_entries);
+  r.sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+  char* cq = static_cast<char*>(r.cq_ptr);
+  r.cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  r.cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  r.cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  r.cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  // Submission queue entries are always used in ring order.
+  for (unsigned i = 0; i < r.sq_entries; ++i)
+    r.sq_array[i] = i;
+
+  return fd;
+}
+
+void io_uring_service::do_io_uring_teardown(int fd, io_uring_service::ring& r)
+{
+  if (r.sqes)
+    ::munmap(r.sqes, r.sqes_map_size);
+  if (r.cq_ptr && r.cq_ptr != r.sq_ptr)
+    ::munmap(r.cq_ptr, r.cq_map_size);
+  if (r.sq_ptr)
+    ::munmap(r.sq_ptr, r.sq_map_size);
+  std::memset(&r, 0, sizeof(r));
+  ::close(fd);
+}
+
+bool io_uring_service::push_sqe(const io_uring_sqe& sqe)
+{
+  unsigned tail = *ring_.sq_tail;
+  if (tail - __atomic_load_n(ring_.sq_head, __ATOMIC_ACQUIRE)
+      >= ring_.sq_entries)
+  {
+    // The queue is full, so hand the queued entries to the kernel now.
+    submit_sqes(true);
+    if (tail - __atomic_load_n(ring_.sq_head, __ATOMIC_ACQUIRE)
+        >= ring_.sq_entries)
+      return false;
+  }
+
+  ring_.sqes[tail & ring_.sq_mask] = sqe;
+  __atomic_store_n(ring_.sq_tail, tail + 1, __ATOMIC_RELEASE);
+  ++pending_sqes_;
+  return true;
+}
+
+bool io_uring_service::prep_poll_add(descriptor_state* descriptor_data)
+{
+  io_uring_sqe sqe;
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_POLL_ADD;
+  sqe.fd = descriptor_data->descriptor_;
+  sqe.poll32_events = io_uring_ops::poll_events(
+      descriptor_data->registered_events_);
+  sqe.len = IORING_POLL_ADD_MULTI;
+  sqe.user_data = reinterpret_cast<__u64>(descriptor_data);
+  if (!push_sqe(sqe))
+    return false;
+  descriptor_data->poll_armed_ = true;
+  return true;
+}
+
+bool io_uring_service::prep_poll_update(descriptor_state* descriptor_data)
+{
+  if (!descriptor_data->poll_armed_)
+    return prep_poll_add(descriptor_data);
+
+  io_uring_sqe sqe;
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_POLL_REMOVE;
+  sqe.fd = -1;
+  sqe.addr = reinterpret_cast<__u64>(descriptor_data);
+  sqe.poll32_events = io_uring_ops::poll_events(
+      descriptor_data->registered_events_);
+  sqe.len = IORING_POLL_UPDATE_EVENTS | IORING_POLL_ADD_MULTI;
+  sqe.user_data = 0;
+  return push_sqe(sqe);
+}
+
+bool io_uring_service::prep_poll_remove(descriptor_state* descriptor_data)
+{
+  io_uring_sqe sqe;
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_POLL_REMOVE;
+  sqe.fd = -1;
+  sqe.addr = reinterpret_cast<__u64>(descriptor_data);
+  sqe.user_data = 0;
+  return push_sqe(sqe);
+}
+
+bool io_uring_service::prep_submission(descriptor_state* descriptor_data,
+    int op_type, reactor_op* op, io_uring_sqe& sqe)
+{
+  sqe.user_data = reinterpret_cast<__u64>(op)
+    | submitted_op_flag | (static_cast<__u64>(op_type) << 1);
+  if (!push_sqe(sqe))
+    return false;
+  op->submission_owner_ = descriptor_data;
+  descriptor_data->submitted_ops_[op_type].push(op);
+  return true;
+}
+
+void io_uring_service::prep_cancel_submissions(
+    descriptor_state* descriptor_data)
+{
+  for (int i = 0; i < max_ops; ++i)
+  {
+    for (reactor_op* op = descriptor_data->submitted_ops_[i].front();
+        op != 0; op = op_queue_access::next(op))
+    {
+      io_uring_sqe sqe;
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_ASYNC_CANCEL;
+      sqe.fd = -1;
+      sqe.addr = reinterpret_cast<__u64>(op)
+        | submitted_op_flag | (static_cast<__u64>(i) << 1);
+      sqe.user_data = 0;
+      push_sqe(sqe);
+    }
+  }
+}
+
+bool io_uring_service::prep_timeout(long usec)
+{
+  timespec now;
+  ::clock_gettime(CLOCK_MONOTONIC, &now);
+  const uint64_t nsec_per_sec = 1000000000;
+  uint64_t expiry = static_cast<uint64_t>(now.tv_sec) * nsec_per_sec
+    + static_cast<uint64_t>(now.tv_nsec) + static_cast<uint64_t>(usec) * 1000;
+
+  // Keep an outstanding timeout request if it will expire no later than
+  // required, and not so much earlier that the wakeup would be wasted.
+  if (timeout_armed_)
+  {
+    uint64_t armed_expiry = static_cast<uint64_t>(timeout_.tv_sec)
+      * nsec_per_sec + static_cast<uint64_t>(timeout_.tv_nsec);
+    if (armed_expiry <= expiry
+        && expiry - armed_expiry <= static_cast<uint64_t>(usec) * 125)
+      return true;
+  }
+
+  timeout_.tv_sec = static_cast<__kernel_time64_t>(expiry / nsec_per_sec);
+  timeout_.tv_nsec = static_cast<long long>(expiry % nsec_per_sec);
+
+  io_uring_sqe sqe;
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.fd = -1;
+  if (timeout_armed_)
+  {
+    sqe.opcode = IORING_OP_TIMEOUT_REMOVE;
+    sqe.addr = reinterpret_cast<__u64>(&timeout_);
+    sqe.addr2 = reinterpret_cast<__u64>(&timeout_);
+    sqe.timeout_flags = IORING_TIMEOUT_UPDATE | IORING_TIMEOUT_ABS;
+    sqe.user_data = 0;
+  }
+  else
+  {
+    sqe.opcode = IORING_OP_TIMEOUT;
+    sqe.addr = reinterpret_cast<__u64>(&timeout_);
+    sqe.len = 1;
+    sqe.timeout_flags = IORING_TIMEOUT_ABS;
+    sqe.user_data = reinterpret_cast<__u64>(&timeout_);
+  }
+  if (!push_sqe(sqe))
+    return false;
+  timeout_armed_ = true;
+  return true;
+}
+
+void io_uring_service::complete_submission(
+    const io_uring_cqe& cqe, op_queue<operation>& ops)
+{
+  reactor_op* op = reinterpret_cast<reactor_op*>(
+      cqe.user_data & ~static_cast<__u64>(submitted_op_mask));
+  int op_type = static_cast<int>((cqe.user_data & submitted_op_mask) >> 1);
+  descriptor_state* descriptor_data =
+    static_cast<descriptor_state*>(op->submission_owner_);
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  // Remove the operation from the descriptor's submitted operations.
+  op_queue<reactor_op> other_ops;
+  while (reactor_op* o = descriptor_data->submitted_ops_[op_type].front())
+  {
+    descriptor_data->submitted_ops_[op_type].pop();
+    if (o != op)
+      other_ops.push(o);
+  }
+  descriptor_data->submitted_ops_[op_type].push(other_ops);
+  op->submission_owner_ = 0;
+
+  // The operation was counted as work when it was started, so it may be
+  // returned for completion as is.
+  if (cqe.res == -ECANCELED || descriptor_data->shutdown_)
+  {
+    if (cqe.res == -ECANCELED || op->complete_submission(cqe.res)
+        == reactor_op::not_done)
+      op->ec_ = asio::error::operation_aborted;
+    ops.push(op);
+  }
+  else if (op->complete_submission(cqe.res) != reactor_op::not_done)
+  {
+    ops.push(op);
+  }
+  else
+  {
+    // The operation must instead wait for the descriptor to become ready.
+    // Updating the poll request re-evaluates the descriptor's readiness.
+    uint32_t old_events = descriptor_data->registered_events_;
+    if (op_type == write_op)
+      descriptor_data->registered_events_ |= POLLOUT;
+    mutex::scoped_lock submit_lock(submit_mutex_);
+    if (prep_poll_update(descriptor_data))
+    {
+      descriptor_data->op_queue_[op_type].push(op);
+    }
+    else
+    {
+      descriptor_data->registered_events_ = old_events;
+      op->ec_ = asio::error::no_buffer_space;
+      ops.push(op);
+    }
+  }
+
+  if (descriptor_data->free_pending_ && !descriptor_data->poll_armed_)
+  {
+    bool submitted = false;
+    for (int i = 0; i < max_ops; ++i)
+      submitted = submitted || !descriptor_data->submitted_ops_[i].empty();
+    if (!submitted)
+    {
+      descriptor_lock.unlock();
+      free_descriptor_state(descriptor_data);
+    }
+  }
+}
+
+void io_uring_service::submit_sqes(bool force)
+{
+  if (pending_sqes_ > 0 && (force || waiting_))
+  {
+    int result = io_uring_ops::enter(ring_fd_, pending_sqes_, 0, 0, 0, 0);
+    if (result > 0)
+      pending_sqes_ -= static_cast<unsigned>(result);
+  }
+}
+
+io_uring_service::descriptor_state*
+io_uring_service::allocate_descriptor_state()
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  return registered_descriptors_.alloc(ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        REACTOR_IO, scheduler_.concurrency_hint()));
+}
+
+void io_uring_service::free_descriptor_state(
+    io_uring_service::descriptor_state* s)
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  registered_descriptors_.free(s);
+}
+
+void io_uring_service::do_add_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.insert(&queue);
+}
+
+void io_uring_service::do_remove_timer_queue(timer_queue_base& queue)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.erase(&queue);
+}
+
+void io_uring_service::update_timeout()
+{
+  // The timeout is recalculated on each call to run(), so we only need to
+  // wake a thread that is currently blocked using an earlier timeout.
+  interrupt();
+}
+
+long io_uring_service::get_timeout(long usec)
+{
+  // By default we will wait no longer than 5 minutes. This will ensure that
+  // any changes to the system clock are detected after no longer than this.
+  const long max_usec = 5 * 60 * 1000 * 1000;
+  return timer_queues_.wait_duration_usec(
+      (usec < 0 || max_usec < usec) ? max_usec : usec);
+}
+
+struct io_uring_service::perform_io_cleanup_on_block_exit
+{
+  explicit perform_io_cleanup_on_block_exit(io_uring_service* s)
+    : service_(s), first_op_(0)
+  {
+  }
+
+  ~perform_io_cleanup_on_block_exit()
+  {
+    if (first_op_)
+    {
+      // Post the remaining completed operations for invocation.
+      if (!ops_.empty())
+        service_->scheduler_.post_deferred_completions(ops_);
+
+      // A user-initiated operation has completed, but there's no need to
+      // explicitly call work_finished() here. Instead, we'll take advantage of
+      // the fact that the scheduler will call work_finished() once we return.
+    }
+    else
+    {
+      // No user-initiated operations have completed, so we need to compensate
+      // for the work_finished() call that the scheduler will make once this
+      // operation returns.
+      service_->scheduler_.compensating_work_started();
+    }
+  }
+
+  io_uring_service* service_;
+  op_queue<operation> ops_;
+  operation* first_op_;
+};
+
+io_uring_service::descriptor_state::descriptor_state(bool locking)
+  : operation(&io_uring_service::descriptor_state::do_complete),
+    mutex_(locking)
+{
+}
+
+operation* io_uring_service::descriptor_state::perform_io(uint32_t events)
+{
+  mutex_.lock();
+  perform_io_cleanup_on_block_exit io_cleanup(service_);
+  mutex::scoped_lock descriptor_lock(mutex_, mutex::scoped_lock::adopt_lock);
+
+  // Exception operations must be processed first to ensure that any
+  // out-of-band data is read before normal data.
+  static const int flag[max_ops] = { POLLIN, POLLOUT, POLLPRI, POLLERR };
+  for (int j = max_ops - 1; j >= 0; --j)
+  {
+    if (events & (flag[j] | POLLERR | POLLHUP))
+    {
+      try_speculative_[j] = true;
+      while (reactor_op* op = op_queue_[j].front())
+      {
+        if (reactor_op::status status = op->perform())
+        {
+          op_queue_[j].pop();
+          if (status == reactor_op::wait_for_error)
+          {
+            op_queue_[error_op].push(op);
+            continue;
+          }
+          io_cleanup.ops_.push(op);
+          if (status == reactor_op::done_and_exhausted)
+          {
+            try_speculative_[j] = false;
+            break;
+          }
+        }
+        else
+          break;
+      }
+    }
+  }
+
+  // The first operation will be returned for completion now. The others will
+  // be posted for later by the io_cleanup object's destructor.
+  io_cleanup.first_op_ = io_cleanup.ops_.front();
+  io_cleanup.ops_.pop();
+  return io_cleanup.first_op_;
+}
+
+void io_uring_service::descriptor_state::do_complete(
+    void* owner, operation* base,
+    const asio::error_code& ec, std::size_t bytes_transferred)
+{
+  if (owner)
+  {
+    descriptor_state* descriptor_data = static_cast<descriptor_state*>(base);
+    uint32_t events = static_cast<uint32_t>(bytes_transferred);
+    if (operation* op = descriptor_data->perform_io(events))
+    {
+      op->complete(owner, ec, 0);
+    }
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
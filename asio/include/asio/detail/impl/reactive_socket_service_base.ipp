@@ -43,6 +43,9 @@ void reactive_socket_service_base::construct(
 {
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  impl.zerocopy_.reset();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 }
 
 void reactive_socket_service_base::base_move_construct(
@@ -56,6 +59,11 @@ void reactive_socket_service_base::base_move_construct(
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  impl.zerocopy_ = other_impl.zerocopy_;
+  other_impl.zerocopy_.reset();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
 }
@@ -73,6 +81,11 @@ void reactive_socket_service_base::base_move_assign(
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  impl.zerocopy_ = other_impl.zerocopy_;
+  other_impl.zerocopy_.reset();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   other_service.reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
 }
@@ -88,6 +101,10 @@ void reactive_socket_service_base::destroy(
     reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
         (impl.state_ & socket_ops::possible_dup) == 0);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    impl.zerocopy_.reset();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
     asio::error_code ignored_ec;
     socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
 
@@ -107,6 +124,10 @@ asio::error_code reactive_socket_service_base::close(
     reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
         (impl.state_ & socket_ops::possible_dup) == 0);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    impl.zerocopy_.reset();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
     socket_ops::close(impl.socket_, impl.state_, false, ec);
 
     reactor_.cleanup_descriptor_data(impl.reactor_data_);
@@ -144,6 +165,9 @@ socket_type reactive_socket_service_base::release(
 
   reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
   reactor_.cleanup_descriptor_data(impl.reactor_data_);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  impl.zerocopy_.reset();
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
   socket_type sock = impl.socket_;
   construct(impl);
   ec = asio::error_code();
@@ -251,6 +275,35 @@ void reactive_socket_service_base::start_op(
   reactor_.post_immediate_completion(op, is_continuation);
 }
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+shared_ptr<zerocopy_send_state>
+reactive_socket_service_base::get_zerocopy_state(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  if (!impl.zerocopy_ && impl.socket_ != invalid_socket)
+  {
+    shared_ptr<zerocopy_send_state> state(new zerocopy_send_state);
+    state->next_ = 0;
+    state->released_ = 0;
+
+    // If the option cannot be enabled, the MSG_ZEROCOPY flag would be
+    // ignored by the kernel and no notifications would be delivered. Sends
+    // are instead made without the flag, and complete immediately.
+    int optval = 1;
+    asio::error_code ec;
+    state->enabled_ = socket_ops::setsockopt(impl.socket_, impl.state_,
+        SOL_SOCKET, ASIO_OS_DEF(SO_ZEROCOPY),
+        &optval, sizeof(optval), ec) == 0;
+
+    impl.zerocopy_ = state;
+  }
+
+  return impl.zerocopy_;
+}
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
 void reactive_socket_service_base::start_accept_op(
     reactive_socket_service_base::base_implementation_type& impl,
     reactor_op* op, bool is_continuation, bool peer_is_open)
@@ -266,13 +319,20 @@ void reactive_socket_service_base::start_accept_op(
 
 void reactive_socket_service_base::start_connect_op(
     reactive_socket_service_base::base_implementation_type& impl,
-    reactor_op* op, bool is_continuation,
+    reactive_socket_connect_op_base* op, bool is_continuation,
     const socket_addr_type* addr, size_t addrlen)
 {
   if ((impl.state_ & socket_ops::non_blocking)
       || socket_ops::set_internal_non_blocking(
         impl.socket_, impl.state_, true, op->ec_))
   {
+#if defined(ASIO_HAS_IO_URING)
+    // Submit the connect itself rather than waiting for it to complete.
+    op->set_peer_address(addr, addrlen);
+    reactor_.start_op(reactor::connect_op, impl.socket_,
+        impl.reactor_data_, op, is_continuation, false);
+    return;
+#else // defined(ASIO_HAS_IO_URING)
     if (socket_ops::connect(impl.socket_, addr, addrlen, op->ec_) != 0)
     {
       if (op->ec_ == asio::error::in_progress
@@ -284,6 +344,7 @@ void reactive_socket_service_base::start_connect_op(
         return;
       }
     }
+#endif // defined(ASIO_HAS_IO_URING)
   }
 
   reactor_.post_immediate_completion(op, is_continuation);
@@ -44,7 +44,8 @@ private:
 resolver_service_base::resolver_service_base(execution_context& context)
   : scheduler_(asio::use_service<scheduler_impl>(context)),
     work_scheduler_(new scheduler_impl(context, -1, false)),
-    work_thread_(0)
+    work_thread_count_(1),
+    running_work_threads_(0)
 {
   work_scheduler_->work_started();
 }
@@ -60,11 +61,8 @@ void resolver_service_base::base_shutdown()
   {
     work_scheduler_->work_finished();
     work_scheduler_->stop();
-    if (work_thread_.get())
-    {
-      work_thread_->join();
-      work_thread_.reset();
-    }
+    work_threads_.join();
+    running_work_threads_ = 0;
     work_scheduler_.reset();
   }
 }
@@ -72,13 +70,13 @@ void resolver_service_base::base_shutdown()
 void resolver_service_base::base_notify_fork(
     execution_context::fork_event fork_ev)
 {
-  if (work_thread_.get())
+  if (!work_threads_.empty())
   {
     if (fork_ev == execution_context::fork_prepare)
     {
       work_scheduler_->stop();
-      work_thread_->join();
-      work_thread_.reset();
+      work_threads_.join();
+      running_work_threads_ = 0;
     }
   }
   else if (fork_ev != execution_context::fork_prepare)
@@ -124,12 +122,26 @@ void resolver_service_base::cancel(
   impl.reset(static_cast<void*>(0), socket_ops::noop_deleter());
 }
 
+void resolver_service_base::set_thread_count(std::size_t n)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  work_thread_count_ = n > 0 ? n : 1;
+  if (running_work_threads_ > 0)
+  {
+    while (running_work_threads_ < work_thread_count_)
+    {
+      work_threads_.create_thread(work_scheduler_runner(*work_scheduler_));
+      ++running_work_threads_;
+    }
+  }
+}
+
 void resolver_service_base::start_resolve_op(resolve_op* op)
 {
   if (ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER,
         scheduler_.concurrency_hint()))
   {
-    start_work_thread();
+    start_work_threads();
     scheduler_.work_started();
     work_scheduler_->post_immediate_completion(op, false);
   }
@@ -140,13 +152,13 @@ void resolver_service_base::start_resolve_op(resolve_op* op)
   }
 }
 
-void resolver_service_base::start_work_thread()
+void resolver_service_base::start_work_threads()
 {
   asio::detail::mutex::scoped_lock lock(mutex_);
-  if (!work_thread_.get())
+  while (running_work_threads_ < work_thread_count_)
   {
-    work_thread_.reset(new asio::detail::thread(
-          work_scheduler_runner(*work_scheduler_)));
+    work_threads_.create_thread(work_scheduler_runner(*work_scheduler_));
+    ++running_work_threads_;
   }
 }
 
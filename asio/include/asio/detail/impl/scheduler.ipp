@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/event.hpp"
 #include "asio/detail/limits.hpp"
@@ -103,6 +104,122 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+class scheduler::spin_wait
+{
+public:
+  explicit spin_wait(long usec)
+    : usec_(usec),
+      started_(false)
+  {
+  }
+
+  // Determine whether an idle thread should poll for work rather than block.
+  // The spin period starts on the first call.
+  bool keep_spinning()
+  {
+#if defined(ASIO_HAS_CHRONO)
+    if (usec_ <= 0)
+      return false;
+
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    if (!started_)
+    {
+      started_ = true;
+      deadline_ = now + chrono::microseconds(usec_);
+      return true;
+    }
+
+    return now < deadline_;
+#else // defined(ASIO_HAS_CHRONO)
+    return false;
+#endif // defined(ASIO_HAS_CHRONO)
+  }
+
+private:
+  long usec_;
+  bool started_;
+#if defined(ASIO_HAS_CHRONO)
+  chrono::steady_clock::time_point deadline_;
+#endif // defined(ASIO_HAS_CHRONO)
+};
+
+#if defined(ASIO_HAS_SCHEDULER_BATCHING)
+struct scheduler::batch_cleanup
+{
+  ~batch_cleanup()
+  {
+    // Each operation taken from the batch accounts for one unit of finished
+    // work, so the counts are reconciled once for the whole batch.
+    long work = this_thread_->private_outstanding_work
+      - static_cast<long>(completed_);
+    this_thread_->private_outstanding_work = 0;
+    if (work > 0)
+      asio::detail::increment(scheduler_->outstanding_work_, work);
+    else if (work < 0 && (scheduler_->outstanding_work_ += work) == 0)
+      scheduler_->stop();
+
+    // Operations not run, due to an exception or a call to stop(), are
+    // returned to the front of the queue, followed by those posted by the
+    // batch's handlers.
+    lock_->lock();
+    if (!batch_->empty())
+    {
+      batch_->push(scheduler_->op_queue_);
+      scheduler_->op_queue_.push(*batch_);
+    }
+    scheduler_->op_queue_.push(this_thread_->private_op_queue);
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+  op_queue<operation>* batch_;
+  std::size_t completed_;
+};
+#endif // defined(ASIO_HAS_SCHEDULER_BATCHING)
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+struct scheduler::single_thread_cleanup
+{
+  ~single_thread_cleanup()
+  {
+    if (this_thread_->private_outstanding_work != 0)
+      scheduler_->flush_private_work(*this_thread_);
+
+    // Enqueue the completed operations, and reinsert the task at the end of
+    // the operation queue if it was being run.
+    scheduler_->op_queue_.push(this_thread_->private_op_queue);
+    if (task_running_)
+    {
+      scheduler_->task_sleeping_.store(false, std::memory_order_relaxed);
+      scheduler_->op_queue_.push(&scheduler_->task_operation_);
+    }
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+  bool task_running_;
+};
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
+#if defined(ASIO_HAS_WORK_STEALING)
+struct scheduler::work_queue_cleanup
+{
+  ~work_queue_cleanup()
+  {
+    // Hand any operations left in the thread's work queue to other threads.
+    lock_->lock();
+    scheduler_->release_work_queue(*this_thread_);
+    if (!scheduler_->op_queue_.empty())
+      scheduler_->wake_one_thread_and_unlock(*lock_);
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
 scheduler::scheduler(asio::execution_context& ctx,
     int concurrency_hint, bool own_thread)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
@@ -119,10 +236,41 @@ scheduler::scheduler(asio::execution_context& ctx,
     stopped_(false),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
-    thread_(0)
+    thread_(0),
+    spin_usec_(0)
+#if defined(ASIO_HAS_WORK_STEALING)
+    , work_stealing_(ASIO_CONCURRENCY_HINT_IS_WORK_STEALING(concurrency_hint)
+        && !ASIO_CONCURRENCY_HINT_IS_SINGLE_THREADED(concurrency_hint)),
+    num_work_queues_(0),
+    idle_threads_(0)
+#endif // defined(ASIO_HAS_WORK_STEALING)
+#if defined(ASIO_HAS_SCHEDULER_BATCHING)
+    , batch_size_(ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH_SIZE(concurrency_hint))
+#endif // defined(ASIO_HAS_SCHEDULER_BATCHING)
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+    , single_thread_(
+        ASIO_CONCURRENCY_HINT_IS_SINGLE_THREADED(concurrency_hint)),
+    task_sleeping_(false)
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+#if defined(ASIO_HAS_WORK_STEALING) \
+  || defined(ASIO_HAS_SCHEDULER_BATCHING) \
+  || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+    , atomic_stopped_(false)
+#endif // defined(ASIO_HAS_WORK_STEALING)
+       //   || defined(ASIO_HAS_SCHEDULER_BATCHING)
+       //   || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
 {
   ASIO_HANDLER_TRACKING_INIT;
 
+#if defined(ASIO_HAS_WORK_STEALING)
+  for (std::size_t i = 0; i < max_work_queues; ++i)
+  {
+    work_queues_[i] = 0;
+    work_queue_in_use_[i] = false;
+    work_queue_node_[i].store(0, std::memory_order_relaxed);
+  }
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
   if (own_thread)
   {
     ++outstanding_work_;
@@ -142,6 +290,11 @@ scheduler::~scheduler()
     thread_->join();
     delete thread_;
   }
+
+#if defined(ASIO_HAS_WORK_STEALING)
+  for (std::size_t i = 0; i < num_work_queues_; ++i)
+    delete work_queues_[i];
+#endif // defined(ASIO_HAS_WORK_STEALING)
 }
 
 void scheduler::shutdown()
@@ -160,6 +313,10 @@ void scheduler::shutdown()
     thread_ = 0;
   }
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  inbox_.pop_all(op_queue_);
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   // Destroy handler objects.
   while (!op_queue_.empty())
   {
@@ -185,6 +342,11 @@ void scheduler::init_task()
 }
 
 std::size_t scheduler::run(asio::error_code& ec)
+{
+  return run(0, ec);
+}
+
+std::size_t scheduler::run(std::size_t node, asio::error_code& ec)
 {
   ec = asio::error_code();
   if (outstanding_work_ == 0)
@@ -195,10 +357,58 @@ std::size_t scheduler::run(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+#if defined(ASIO_HAS_WORK_STEALING)
+  this_thread.node = node;
+#else // defined(ASIO_HAS_WORK_STEALING)
+  (void)node;
+#endif // defined(ASIO_HAS_WORK_STEALING)
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+  {
+    return do_run_single(lock, this_thread,
+        (std::numeric_limits<std::size_t>::max)(), -1, ec);
+  }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
+#if defined(ASIO_HAS_WORK_STEALING)
+  if (work_stealing_)
+  {
+    acquire_work_queue(this_thread);
+    if (this_thread.work_queue)
+    {
+      work_queue_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+      lock.unlock();
+
+      std::size_t n = 0;
+      for (; do_run_one_stealing(lock, this_thread, ec); )
+        if (n != (std::numeric_limits<std::size_t>::max)())
+          ++n;
+      return n;
+    }
+  }
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
+#if defined(ASIO_HAS_SCHEDULER_BATCHING)
+  if (batch_size_ > 1)
+  {
+    std::size_t n = 0;
+    for (std::size_t m; (m = do_run_batch(lock, this_thread, ec)) != 0;
+        lock.lock())
+    {
+      if (n < (std::numeric_limits<std::size_t>::max)() - m)
+        n += m;
+      else
+        n = (std::numeric_limits<std::size_t>::max)();
+    }
+    return n;
+  }
+#endif // defined(ASIO_HAS_SCHEDULER_BATCHING)
+
   std::size_t n = 0;
   for (; do_run_one(lock, this_thread, ec); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
@@ -221,6 +431,11 @@ std::size_t scheduler::run_one(asio::error_code& ec)
 
   mutex::scoped_lock lock(mutex_);
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+    return do_run_single(lock, this_thread, 1, -1, ec);
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   return do_run_one(lock, this_thread, ec);
 }
 
@@ -239,6 +454,11 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
 
   mutex::scoped_lock lock(mutex_);
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+    return do_run_single(lock, this_thread, 1, usec < 0 ? 0 : usec, ec);
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   return do_wait_one(lock, this_thread, usec, ec);
 }
 
@@ -266,6 +486,14 @@ std::size_t scheduler::poll(asio::error_code& ec)
       op_queue_.push(outer_info->private_op_queue);
 #endif // defined(ASIO_HAS_THREADS)
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+  {
+    return do_run_single(lock, this_thread,
+        (std::numeric_limits<std::size_t>::max)(), 0, ec);
+  }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   std::size_t n = 0;
   for (; do_poll_one(lock, this_thread, ec); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
@@ -297,17 +525,39 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
       op_queue_.push(outer_info->private_op_queue);
 #endif // defined(ASIO_HAS_THREADS)
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+    return do_run_single(lock, this_thread, 1, 0, ec);
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   return do_poll_one(lock, this_thread, ec);
 }
 
 void scheduler::stop()
 {
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+  {
+    // The running thread checks the flag before it blocks in the task, and
+    // only needs to be interrupted if it has already done so.
+    atomic_stopped_ = true;
+    if (task_sleeping_.load() && task_sleeping_.exchange(false))
+      task_->interrupt();
+    return;
+  }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   mutex::scoped_lock lock(mutex_);
   stop_all_threads(lock);
 }
 
 bool scheduler::stopped() const
 {
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+    return atomic_stopped_.load();
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   mutex::scoped_lock lock(mutex_);
   return stopped_;
 }
@@ -316,6 +566,29 @@ void scheduler::restart()
 {
   mutex::scoped_lock lock(mutex_);
   stopped_ = false;
+#if defined(ASIO_HAS_WORK_STEALING) \
+  || defined(ASIO_HAS_SCHEDULER_BATCHING) \
+  || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  atomic_stopped_ = false;
+#endif // defined(ASIO_HAS_WORK_STEALING)
+       //   || defined(ASIO_HAS_SCHEDULER_BATCHING)
+       //   || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+}
+
+void scheduler::set_spin_duration(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  spin_usec_ = usec;
+}
+
+void scheduler::set_reactor_batch_size(std::size_t max_events)
+{
+  use_service<reactor>(this->context()).set_batch_size(max_events);
+}
+
+reactor_statistics scheduler::get_reactor_statistics()
+{
+  return use_service<reactor>(this->context()).statistics();
 }
 
 void scheduler::compensating_work_started()
@@ -333,6 +606,17 @@ void scheduler::capture_current_exception()
 void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
+#if defined(ASIO_HAS_WORK_STEALING)
+  if (work_stealing_)
+  {
+    work_started();
+    op_queue<operation> ops;
+    ops.push(op);
+    post_to_work_queue(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -348,6 +632,17 @@ void scheduler::post_immediate_completion(
 #endif // defined(ASIO_HAS_THREADS)
 
   work_started();
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+  {
+    op_queue<operation> ops;
+    ops.push(op);
+    post_to_inbox(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -356,6 +651,15 @@ void scheduler::post_immediate_completion(
 void scheduler::post_immediate_completions(std::size_t n,
     op_queue<scheduler::operation>& ops, bool is_continuation)
 {
+#if defined(ASIO_HAS_WORK_STEALING)
+  if (work_stealing_)
+  {
+    increment(outstanding_work_, static_cast<long>(n));
+    post_to_work_queue(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -372,6 +676,15 @@ void scheduler::post_immediate_completions(std::size_t n,
 #endif // defined(ASIO_HAS_THREADS)
 
   increment(outstanding_work_, static_cast<long>(n));
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+  {
+    post_to_inbox(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(ops);
   wake_one_thread_and_unlock(lock);
@@ -379,6 +692,16 @@ void scheduler::post_immediate_completions(std::size_t n,
 
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
+#if defined(ASIO_HAS_WORK_STEALING)
+  if (work_stealing_)
+  {
+    op_queue<operation> ops;
+    ops.push(op);
+    post_to_work_queue(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_)
   {
@@ -390,6 +713,16 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
   }
 #endif // defined(ASIO_HAS_THREADS)
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+  {
+    op_queue<operation> ops;
+    ops.push(op);
+    post_to_inbox(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -400,6 +733,14 @@ void scheduler::post_deferred_completions(
 {
   if (!ops.empty())
   {
+#if defined(ASIO_HAS_WORK_STEALING)
+    if (work_stealing_)
+    {
+      post_to_work_queue(ops);
+      return;
+    }
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
 #if defined(ASIO_HAS_THREADS)
     if (one_thread_)
     {
@@ -411,6 +752,14 @@ void scheduler::post_deferred_completions(
     }
 #endif // defined(ASIO_HAS_THREADS)
 
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+    if (single_thread_)
+    {
+      post_to_inbox(ops);
+      return;
+    }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
     mutex::scoped_lock lock(mutex_);
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
@@ -421,6 +770,27 @@ void scheduler::do_dispatch(
     scheduler::operation* op)
 {
   work_started();
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  if (single_thread_)
+  {
+    op_queue<operation> ops;
+    ops.push(op);
+    post_to_inbox(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
+#if defined(ASIO_HAS_WORK_STEALING)
+  if (work_stealing_)
+  {
+    op_queue<operation> ops;
+    ops.push(op);
+    post_to_work_queue(ops);
+    return;
+  }
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -437,6 +807,8 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
     const asio::error_code& ec)
 {
+  spin_wait spin(spin_usec_);
+
   while (!stopped_)
   {
     if (!op_queue_.empty())
@@ -448,7 +820,10 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
 
       if (o == &task_operation_)
       {
-        task_interrupted_ = more_handlers;
+        // An idle thread polls the task, rather than blocking in it, until its
+        // spin period has elapsed. A polling task need not be interrupted.
+        bool poll_task = more_handlers || spin.keep_spinning();
+        task_interrupted_ = poll_task;
 
         if (more_handlers && !one_thread_)
           wakeup_event_.unlock_and_signal_one(lock);
@@ -461,7 +836,7 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
         // as soon as possible.
-        task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
+        task_->run(poll_task ? 0 : -1, this_thread.private_op_queue);
       }
       else
       {
@@ -483,6 +858,12 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         return 1;
       }
     }
+    else if (spin.keep_spinning())
+    {
+      // Release the lock so that other threads may queue work.
+      lock.unlock();
+      lock.lock();
+    }
     else
     {
       wakeup_event_.clear(lock);
@@ -619,10 +1000,247 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   return 1;
 }
 
+#if defined(ASIO_HAS_SCHEDULER_BATCHING)
+std::size_t scheduler::do_run_batch(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread,
+    const asio::error_code& ec)
+{
+  spin_wait spin(spin_usec_);
+
+  while (!stopped_)
+  {
+    if (!op_queue_.empty())
+    {
+      operation* o = op_queue_.front();
+      if (o == &task_operation_)
+      {
+        op_queue_.pop();
+        bool more_handlers = (!op_queue_.empty());
+
+        // An idle thread polls the task, rather than blocking in it, until its
+        // spin period has elapsed. A polling task need not be interrupted.
+        bool poll_task = more_handlers || spin.keep_spinning();
+        task_interrupted_ = poll_task;
+
+        if (more_handlers && !one_thread_)
+          wakeup_event_.unlock_and_signal_one(lock);
+        else
+          lock.unlock();
+
+        task_cleanup on_exit = { this, &lock, &this_thread };
+        (void)on_exit;
+
+        // Run the task. May throw an exception. Only block if the operation
+        // queue is empty and we're not polling, otherwise we want to return
+        // as soon as possible.
+        task_->run(poll_task ? 0 : -1, this_thread.private_op_queue);
+      }
+      else
+      {
+        // Take handlers up to the task's position in the queue, so that the
+        // task is delayed by no more than one batch.
+        op_queue<operation> batch;
+        std::size_t batch_length = 0;
+        do
+        {
+          op_queue_.pop();
+          batch.push(o);
+          o = op_queue_.front();
+        } while (++batch_length < batch_size_
+            && o != 0 && o != &task_operation_);
+        bool more_handlers = (o != 0);
+
+        // Any handlers that remain are left for another thread.
+        if (more_handlers && !one_thread_)
+          wake_one_thread_and_unlock(lock);
+        else
+          lock.unlock();
+
+        // Ensure the count of outstanding work is decremented, and unrun
+        // handlers are requeued, on block exit.
+        batch_cleanup on_exit = { this, &lock, &this_thread, &batch, 0 };
+
+        do
+        {
+          o = batch.front();
+          batch.pop();
+          ++on_exit.completed_;
+
+          // Complete the operation. May throw an exception. Deletes the
+          // object.
+          o->complete(this, ec, o->task_result_);
+          this_thread.rethrow_pending_exception();
+        } while (!batch.empty()
+            && !atomic_stopped_.load(std::memory_order_acquire));
+
+        return on_exit.completed_;
+      }
+    }
+    else if (spin.keep_spinning())
+    {
+      // Release the lock so that other threads may queue work.
+      lock.unlock();
+      lock.lock();
+    }
+    else
+    {
+      wakeup_event_.clear(lock);
+      wakeup_event_.wait(lock);
+    }
+  }
+
+  return 0;
+}
+#endif // defined(ASIO_HAS_SCHEDULER_BATCHING)
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+std::size_t scheduler::do_run_single(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread, std::size_t max_handlers,
+    long usec, const asio::error_code& ec)
+{
+  spin_wait spin(spin_usec_);
+  lock.unlock();
+
+  // Ensure the count of outstanding work is updated, and the task is returned
+  // to the queue, on block exit.
+  single_thread_cleanup on_exit = { this, &this_thread, false };
+
+  bool blocking = (usec < 0);
+  std::size_t n = 0;
+  while (n < max_handlers && !atomic_stopped_.load(std::memory_order_acquire))
+  {
+    // Handlers posted from other threads are queued behind those already
+    // waiting to run.
+    if (!inbox_.empty())
+      inbox_.pop_all(op_queue_);
+
+    operation* o = op_queue_.front();
+    if (o == 0)
+    {
+      // There is no task until an I/O object needs one, so the queue may be
+      // empty. Check whether the work has run out before creating the task.
+      if (this_thread.private_outstanding_work != 0)
+      {
+        flush_private_work(this_thread);
+        if (atomic_stopped_)
+          break;
+      }
+
+      // The task is needed to wait for operations posted from other threads.
+      if (shutdown_ || (!blocking && usec == 0))
+        break;
+      lock.lock();
+      if (!task_)
+      {
+        task_ = &use_service<reactor>(this->context());
+        op_queue_.push(&task_operation_);
+      }
+      lock.unlock();
+      continue;
+    }
+
+    op_queue_.pop();
+
+    if (o == &task_operation_)
+    {
+      on_exit.task_running_ = true;
+      bool more_handlers = (!op_queue_.empty());
+
+      long timeout = 0;
+      if (!more_handlers)
+      {
+        // Each handler run so far has left the shared count one too high, so
+        // it is brought up to date before deciding whether to wait.
+        if (this_thread.private_outstanding_work != 0)
+        {
+          flush_private_work(this_thread);
+          if (atomic_stopped_)
+            break;
+        }
+
+        if (!blocking)
+        {
+          // Timed waits block at most once.
+          timeout = usec;
+          usec = 0;
+        }
+        else if (!spin.keep_spinning())
+        {
+          // Announce that the task may block before checking for work for
+          // the last time, so that a thread that adds to the inbox afterwards
+          // interrupts it.
+          task_sleeping_ = true;
+          if (inbox_.empty() && !atomic_stopped_)
+            timeout = -1;
+        }
+      }
+
+      // Run the task. May throw an exception.
+      task_->run(timeout, this_thread.private_op_queue);
+
+      // Polls and timed waits return if the task finds nothing to do.
+      if (!more_handlers && !blocking
+          && this_thread.private_op_queue.empty() && inbox_.empty())
+        break;
+
+      task_sleeping_.store(false, std::memory_order_relaxed);
+      on_exit.task_running_ = false;
+      op_queue_.push(this_thread.private_op_queue);
+      op_queue_.push(&task_operation_);
+    }
+    else
+    {
+      // The work count is decremented when the private count is flushed.
+      --this_thread.private_outstanding_work;
+      ++n;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      o->complete(this, ec, o->task_result_);
+      this_thread.rethrow_pending_exception();
+
+      op_queue_.push(this_thread.private_op_queue);
+    }
+  }
+
+  return n;
+}
+
+void scheduler::flush_private_work(scheduler::thread_info& this_thread)
+{
+  long work = this_thread.private_outstanding_work;
+  this_thread.private_outstanding_work = 0;
+  if (work > 0)
+    asio::detail::increment(outstanding_work_, work);
+  else if ((outstanding_work_ += work) == 0)
+    stop();
+}
+
+void scheduler::post_to_inbox(op_queue<scheduler::operation>& ops)
+{
+  while (operation* op = ops.front())
+  {
+    ops.pop();
+    inbox_.push(op);
+  }
+
+  // The running thread only needs to be interrupted if it may have checked
+  // the inbox before the operations were added.
+  if (task_sleeping_.load() && task_sleeping_.exchange(false))
+    task_->interrupt();
+}
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
   stopped_ = true;
+#if defined(ASIO_HAS_WORK_STEALING) \
+  || defined(ASIO_HAS_SCHEDULER_BATCHING) \
+  || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  atomic_stopped_ = true;
+#endif // defined(ASIO_HAS_WORK_STEALING)
+       //   || defined(ASIO_HAS_SCHEDULER_BATCHING)
+       //   || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
   wakeup_event_.signal_all(lock);
 
   if (!task_interrupted_ && task_)
@@ -646,6 +1264,251 @@ void scheduler::wake_one_thread_and_unlock(
   }
 }
 
+#if defined(ASIO_HAS_WORK_STEALING)
+std::size_t scheduler::do_run_one_stealing(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread,
+    const asio::error_code& ec)
+{
+  for (;;)
+  {
+    operation* o = 0;
+
+    // Prefer the thread's own work queue, but periodically check the shared
+    // queue so that the task and handlers posted from outside the scheduler
+    // are not starved.
+    if (++this_thread.work_queue_ticks % work_queue_fairness_interval != 0
+        && !atomic_stopped_.load(std::memory_order_acquire))
+      o = this_thread.work_queue->pop();
+
+    if (o == 0)
+    {
+      lock.lock();
+
+      if (stopped_)
+      {
+        lock.unlock();
+        return 0;
+      }
+
+      if (!op_queue_.empty())
+      {
+        o = op_queue_.front();
+        op_queue_.pop();
+        bool more_handlers = (!op_queue_.empty());
+
+        if (o == &task_operation_)
+        {
+          // The task may only block if there is no work anywhere. A thread
+          // that posts to its own work queue checks idle_threads_ after the
+          // push, so the queues must be checked again after registering as
+          // idle to avoid missing the wakeup.
+          bool block = !more_handlers && work_queues_empty();
+          if (block)
+          {
+            ++idle_threads_;
+            if (!work_queues_empty())
+            {
+              --idle_threads_;
+              block = false;
+            }
+          }
+
+          task_interrupted_ = !block;
+
+          if (!block && !one_thread_)
+            wakeup_event_.unlock_and_signal_one(lock);
+          else
+            lock.unlock();
+
+          {
+            task_cleanup on_exit = { this, &lock, &this_thread };
+            (void)on_exit;
+
+            // Run the task. May throw an exception.
+            task_->run(block ? -1 : 0, this_thread.private_op_queue);
+          }
+
+          if (block)
+            --idle_threads_;
+        }
+        else
+        {
+          std::size_t task_result = o->task_result_;
+
+          if (more_handlers && !one_thread_)
+            wake_one_thread_and_unlock(lock);
+          else
+            lock.unlock();
+
+          {
+            // Ensure the count of outstanding work is decremented on block
+            // exit.
+            work_cleanup on_exit = { this, &lock, &this_thread };
+            (void)on_exit;
+
+            // Complete the operation. May throw an exception. Deletes the
+            // object.
+            o->complete(this, ec, task_result);
+            this_thread.rethrow_pending_exception();
+          }
+
+          lock.unlock();
+          return 1;
+        }
+      }
+
+      // Having run the task, or found the shared queue empty, look for work in
+      // the thread's own queue and then in those of its peers.
+      lock.unlock();
+      o = this_thread.work_queue->pop();
+      if (o == 0)
+        o = steal_work(this_thread);
+
+      if (o == 0)
+      {
+        // Wait for more work, using the same protocol as the task above.
+        lock.lock();
+        ++idle_threads_;
+        if (!stopped_ && op_queue_.empty() && work_queues_empty())
+        {
+          wakeup_event_.clear(lock);
+          wakeup_event_.wait(lock);
+        }
+        --idle_threads_;
+        lock.unlock();
+        continue;
+      }
+    }
+
+    {
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      o->complete(this, ec, o->task_result_);
+      this_thread.rethrow_pending_exception();
+    }
+
+    lock.unlock();
+    return 1;
+  }
+}
+
+void scheduler::acquire_work_queue(scheduler::thread_info& this_thread)
+{
+  std::size_t n = num_work_queues_.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    if (!work_queue_in_use_[i])
+    {
+      work_queue_in_use_[i] = true;
+      work_queue_node_[i].store(this_thread.node, std::memory_order_relaxed);
+      this_thread.work_queue = work_queues_[i];
+      this_thread.work_queue_index = i;
+      return;
+    }
+  }
+
+  // If all queues are in use then the thread will use the shared queue only.
+  if (n < max_work_queues)
+  {
+    work_queues_[n] = new work_stealing_queue<operation>;
+    work_queue_in_use_[n] = true;
+    work_queue_node_[n].store(this_thread.node, std::memory_order_relaxed);
+    num_work_queues_.store(n + 1, std::memory_order_release);
+    this_thread.work_queue = work_queues_[n];
+    this_thread.work_queue_index = n;
+  }
+}
+
+void scheduler::release_work_queue(scheduler::thread_info& this_thread)
+{
+  while (operation* o = this_thread.work_queue->pop())
+    op_queue_.push(o);
+  work_queue_in_use_[this_thread.work_queue_index] = false;
+  this_thread.work_queue = 0;
+}
+
+void scheduler::post_to_work_queue(op_queue<scheduler::operation>& ops)
+{
+  bool pushed = false;
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+  {
+    if (work_stealing_queue<operation>* q
+        = static_cast<thread_info*>(this_thread)->work_queue)
+    {
+      // An operation may be stolen and completed as soon as it is pushed, so
+      // it must be removed from the op_queue first.
+      while (operation* o = ops.front())
+      {
+        ops.pop();
+        if (!q->push(o))
+        {
+          op_queue<operation> remainder;
+          remainder.push(o);
+          remainder.push(ops);
+          ops.push(remainder);
+          break;
+        }
+        pushed = true;
+      }
+    }
+  }
+
+  if (pushed)
+  {
+    // Wake a blocked thread so that it can steal the new work. The fence
+    // orders the push before the check of idle_threads_, pairing with the
+    // increment made by a thread before it blocks.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle_threads_.load(std::memory_order_relaxed) > 0)
+    {
+      mutex::scoped_lock lock(mutex_);
+      op_queue_.push(ops);
+      wake_one_thread_and_unlock(lock);
+      return;
+    }
+  }
+
+  if (!ops.empty())
+  {
+    mutex::scoped_lock lock(mutex_);
+    op_queue_.push(ops);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+scheduler::operation* scheduler::steal_work(scheduler::thread_info& this_thread)
+{
+  // Work is only taken from threads on other nodes when there is none left on
+  // the thread's own node.
+  std::size_t n = num_work_queues_.load(std::memory_order_acquire);
+  for (int local = 1; local >= 0; --local)
+  {
+    for (std::size_t i = 1; i < n; ++i)
+    {
+      std::size_t index = (this_thread.work_queue_index + i) % n;
+      bool same_node = work_queue_node_[index].load(
+          std::memory_order_relaxed) == this_thread.node;
+      if (same_node == (local != 0))
+        if (operation* o = work_queues_[index]->pop())
+          return o;
+    }
+  }
+  return 0;
+}
+
+bool scheduler::work_queues_empty() const
+{
+  std::size_t n = num_work_queues_.load(std::memory_order_acquire);
+  for (std::size_t i = 0; i < n; ++i)
+    if (!work_queues_[i]->empty())
+      return false;
+  return true;
+}
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
 } // namespace detail
 } // namespace asio
 
@@ -1802,6 +1802,753 @@ bool non_blocking_sendto1(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void init_mmsghdr(mmsghdr_type& msg, buf* b,
+    const socket_addr_type* addr, std::size_t addrlen)
+{
+  msg = mmsghdr_type();
+  init_msghdr_msg_name(msg.msg_hdr.msg_name, addr);
+  msg.msg_hdr.msg_namelen = static_cast<int>(addrlen);
+  msg.msg_hdr.msg_iov = b;
+  msg.msg_hdr.msg_iovlen = 1;
+}
+
+signed_size_type recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_MMSG)
+  // Return as soon as one datagram has been received, rather than waiting
+  // for the whole batch.
+  signed_size_type result = ::recvmmsg(s, msgs,
+      static_cast<unsigned int>(count), flags | MSG_WAITFORONE, 0);
+  get_last_error(ec, result < 0);
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Emulate the batch with one call per datagram. Only the first call is
+  // permitted to block, and the batch ends at the first failure after that.
+  signed_size_type result = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    signed_size_type bytes = ::recvmsg(s, &msgs[i].msg_hdr, flags);
+    if (bytes < 0)
+    {
+      if (i == 0)
+      {
+        get_last_error(ec, true);
+        return bytes;
+      }
+      break;
+    }
+    msgs[i].msg_len = static_cast<unsigned int>(bytes);
+    ++result;
+# if defined(MSG_DONTWAIT)
+    flags |= MSG_DONTWAIT;
+# else // defined(MSG_DONTWAIT)
+    break;
+# endif // defined(MSG_DONTWAIT)
+  }
+  get_last_error(ec, false);
+  return result;
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+size_t sync_recvmmsg(socket_type s, state_type state,
+    mmsghdr_type* msgs, size_t count, int flags, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to receive no datagrams is a no-op.
+  if (count == 0)
+  {
+    ec.assign(0, ec.category());
+    return 0;
+  }
+
+  // Read some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type msgs_recvd = socket_ops::recvmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (msgs_recvd >= 0)
+      return msgs_recvd;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvmmsg(socket_type s,
+    mmsghdr_type* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    signed_size_type msgs_recvd = socket_ops::recvmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (msgs_recvd >= 0)
+    {
+      msgs_transferred = msgs_recvd;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    msgs_transferred = 0;
+    return true;
+  }
+}
+
+signed_size_type sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec)
+{
+#if defined(__linux__)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(__linux__)
+#if defined(ASIO_HAS_MMSG)
+  signed_size_type result = ::sendmmsg(s, msgs,
+      static_cast<unsigned int>(count), flags);
+  get_last_error(ec, result < 0);
+  return result;
+#else // defined(ASIO_HAS_MMSG)
+  // Emulate the batch with one call per datagram. The batch ends at the first
+  // failure after a datagram has been sent.
+  signed_size_type result = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    signed_size_type bytes = ::sendmsg(s, &msgs[i].msg_hdr, flags);
+    if (bytes < 0)
+    {
+      if (i == 0)
+      {
+        get_last_error(ec, true);
+        return bytes;
+      }
+      break;
+    }
+    msgs[i].msg_len = static_cast<unsigned int>(bytes);
+    ++result;
+  }
+  get_last_error(ec, false);
+  return result;
+#endif // defined(ASIO_HAS_MMSG)
+}
+
+size_t sync_sendmmsg(socket_type s, state_type state,
+    mmsghdr_type* msgs, size_t count, int flags, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to send no datagrams is a no-op.
+  if (count == 0)
+  {
+    ec.assign(0, ec.category());
+    return 0;
+  }
+
+  // Write some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type msgs_sent = socket_ops::sendmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (msgs_sent >= 0)
+      return msgs_sent;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendmmsg(socket_type s,
+    mmsghdr_type* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred)
+{
+  for (;;)
+  {
+    // Write some datagrams.
+    signed_size_type msgs_sent = socket_ops::sendmmsg(
+        s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (msgs_sent >= 0)
+    {
+      msgs_transferred = msgs_sent;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    msgs_transferred = 0;
+    return true;
+  }
+}
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+signed_size_type recvfrom_segmented(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, std::size_t* segment_size, asio::error_code& ec)
+{
+  union
+  {
+    cmsghdr align;
+    char buf[CMSG_SPACE(sizeof(int))];
+  } control;
+
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = static_cast<int>(*addrlen);
+  msg.msg_iov = bufs;
+  msg.msg_iovlen = static_cast<int>(count);
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  signed_size_type result = ::recvmsg(s, &msg, flags);
+  get_last_error(ec, result < 0);
+  *addrlen = msg.msg_namelen;
+
+  // A datagram that was not coalesced by the kernel is a single segment.
+  *segment_size = result > 0 ? static_cast<std::size_t>(result) : 0;
+  if (result > 0)
+  {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if (cmsg->cmsg_level == ASIO_OS_DEF(IPPROTO_UDP)
+          && cmsg->cmsg_type == ASIO_OS_DEF(UDP_GRO))
+      {
+        using namespace std; // For memcpy.
+        int gso_size = 0;
+        memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+        if (gso_size > 0)
+          *segment_size = static_cast<std::size_t>(gso_size);
+      }
+    }
+  }
+
+  return result;
+}
+
+size_t sync_recvfrom_segmented(socket_type s, state_type state,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, std::size_t* segment_size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Read some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::recvfrom_segmented(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvfrom_segmented(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, std::size_t* segment_size,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Read some data.
+    signed_size_type bytes = socket_ops::recvfrom_segmented(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+signed_size_type sendto_segmented(socket_type s,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec)
+{
+  // The kernel carries the segment size in 16 bits.
+  if (segment_size > 0xFFFF)
+  {
+    ec = asio::error::invalid_argument;
+    return socket_error_retval;
+  }
+
+  union
+  {
+    cmsghdr align;
+    char buf[CMSG_SPACE(sizeof(uint16_t))];
+  } control;
+
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = static_cast<int>(addrlen);
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+
+  // A segment size of zero sends the data using the socket's default, as set
+  // by the UDP_SEGMENT socket option.
+  if (segment_size > 0)
+  {
+    using namespace std; // For memcpy and memset.
+    memset(control.buf, 0, sizeof(control.buf));
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = ASIO_OS_DEF(IPPROTO_UDP);
+    cmsg->cmsg_type = ASIO_OS_DEF(UDP_SEGMENT);
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t gso_size = static_cast<uint16_t>(segment_size);
+    memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+  }
+
+  signed_size_type result = ::sendmsg(s, &msg, flags | MSG_NOSIGNAL);
+  get_last_error(ec, result < 0);
+  return result;
+}
+
+size_t sync_sendto_segmented(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::sendto_segmented(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendto_segmented(socket_type s,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::sendto_segmented(
+        s, bufs, count, flags, addr, addrlen, segment_size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+bool recv_zerocopy_notification(socket_type s,
+    uint32_t& first, uint32_t& last, asio::error_code& ec)
+{
+  union
+  {
+    cmsghdr align;
+    char buf[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+  } control;
+
+  for (;;)
+  {
+    msghdr msg = msghdr();
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    signed_size_type result = ::recvmsg(s, &msg, MSG_ERRQUEUE);
+    get_last_error(ec, result < 0);
+    if (result < 0)
+    {
+      if (ec == asio::error::interrupted)
+        continue;
+      return false;
+    }
+
+    // Other errors reported on the queue, such as ICMP errors when
+    // IP_RECVERR is enabled, are discarded.
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == SOL_IPV6
+            && cmsg->cmsg_type == IPV6_RECVERR))
+      {
+        using namespace std; // For memcpy.
+        sock_extended_err err;
+        memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+        if (err.ee_errno == 0
+            && err.ee_origin == ASIO_OS_DEF(SO_EE_ORIGIN_ZEROCOPY))
+        {
+          first = err.ee_info;
+          last = err.ee_data;
+          return true;
+        }
+      }
+    }
+  }
+}
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+signed_size_type sendfile(socket_type s, int file,
+    uint64_t offset, size_t size, asio::error_code& ec)
+{
+  off_t off = static_cast<off_t>(offset);
+  signed_size_type result = ::sendfile(s, file, &off, size);
+  get_last_error(ec, result < 0);
+  return result;
+}
+
+size_t sync_sendfile(socket_type s, state_type state, int file,
+    uint64_t offset, size_t size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes to a stream is a no-op.
+  if (size == 0)
+  {
+    ec.assign(0, ec.category());
+    return 0;
+  }
+
+  // Write some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::sendfile(
+        s, file, offset, size, ec);
+
+    // Check if we have reached the end of the file.
+    if (bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendfile(socket_type s, int file,
+    uint64_t offset, size_t size, asio::error_code& ec,
+    size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::sendfile(
+        s, file, offset, size, ec);
+
+    // Check if we have reached the end of the file.
+    if (bytes == 0 && size > 0)
+    {
+      ec = asio::error::eof;
+      bytes_transferred = 0;
+      return true;
+    }
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#if defined(ASIO_HAS_SPLICE)
+
+signed_size_type splice(int in, int out,
+    size_t size, asio::error_code& ec)
+{
+  signed_size_type result = ::splice(in, 0, out, 0,
+      size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  get_last_error(ec, result < 0);
+  return result;
+}
+
+// Check whether a pipe is ready, or wait for it to become ready.
+inline int poll_pipe(int pipe, short events,
+    int msec, asio::error_code& ec)
+{
+  pollfd fds;
+  fds.fd = pipe;
+  fds.events = events;
+  fds.revents = 0;
+  int result = ::poll(&fds, 1, msec);
+  get_last_error(ec, result < 0);
+  return result;
+}
+
+inline size_t sync_splice(socket_type s, state_type state,
+    int in, int out, bool to_pipe, size_t size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to move 0 bytes is a no-op.
+  if (size == 0)
+  {
+    ec.assign(0, ec.category());
+    return 0;
+  }
+
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::splice(in, out, size, ec);
+
+    // Check if we have reached the end of the input.
+    if (bytes == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for the pipe, and then the socket, to become ready.
+    if (socket_ops::poll_pipe(to_pipe ? out : in,
+          to_pipe ? POLLOUT : POLLIN, -1, ec) < 0)
+      return 0;
+    if ((to_pipe ? socket_ops::poll_read(s, 0, -1, ec)
+          : socket_ops::poll_write(s, 0, -1, ec)) < 0)
+      return 0;
+  }
+}
+
+size_t sync_splice_to(socket_type s, state_type state,
+    int pipe, size_t size, asio::error_code& ec)
+{
+  return sync_splice(s, state, s, pipe, true, size, ec);
+}
+
+size_t sync_splice_from(socket_type s, state_type state,
+    int pipe, size_t size, asio::error_code& ec)
+{
+  return sync_splice(s, state, pipe, s, false, size, ec);
+}
+
+inline bool non_blocking_splice(int in, int out, bool to_pipe,
+    size_t size, asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Move some data.
+    signed_size_type bytes = socket_ops::splice(in, out, size, ec);
+
+    // Check if we have reached the end of the input.
+    if (bytes == 0 && size > 0)
+    {
+      ec = asio::error::eof;
+      bytes_transferred = 0;
+      return true;
+    }
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+    {
+      // The reactor only waits for the socket. If it is the pipe that is not
+      // ready then the caller must wait for it.
+      asio::error_code poll_ec;
+      if (socket_ops::poll_pipe(to_pipe ? out : in,
+            to_pipe ? POLLOUT : POLLIN, 0, poll_ec) != 0)
+        return false;
+      ec = asio::error::would_block;
+    }
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+bool non_blocking_splice_to(socket_type s,
+    int pipe, size_t size, asio::error_code& ec, size_t& bytes_transferred)
+{
+  return non_blocking_splice(s, pipe, true, size, ec, bytes_transferred);
+}
+
+bool non_blocking_splice_from(socket_type s,
+    int pipe, size_t size, asio::error_code& ec, size_t& bytes_transferred)
+{
+  return non_blocking_splice(pipe, s, false, size, ec, bytes_transferred);
+}
+
+#endif // defined(ASIO_HAS_SPLICE)
+
 socket_type socket(int af, int type, int protocol,
     asio::error_code& ec)
 {
@@ -26,7 +26,9 @@ namespace detail {
 strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
+#if !defined(ASIO_HAS_LOCK_FREE_STRAND)
     salt_(0),
+#endif // !defined(ASIO_HAS_LOCK_FREE_STRAND)
     impl_list_(0)
 {
 }
@@ -40,11 +42,17 @@ void strand_executor_service::shutdown()
   strand_impl* impl = impl_list_;
   while (impl)
   {
+#if defined(ASIO_HAS_LOCK_FREE_STRAND)
+    impl->shutdown_ = true;
+    impl->waiting_queue_.pop_all(ops);
+    ops.push(impl->ready_queue_);
+#else // defined(ASIO_HAS_LOCK_FREE_STRAND)
     impl->mutex_->lock();
     impl->shutdown_ = true;
     ops.push(impl->waiting_queue_);
     ops.push(impl->ready_queue_);
     impl->mutex_->unlock();
+#endif // defined(ASIO_HAS_LOCK_FREE_STRAND)
     impl = impl->next_;
   }
 }
@@ -58,6 +66,7 @@ strand_executor_service::create_implementation()
 
   asio::detail::mutex::scoped_lock lock(mutex_);
 
+#if !defined(ASIO_HAS_LOCK_FREE_STRAND)
   // Select a mutex from the pool of shared mutexes.
   std::size_t salt = salt_++;
   std::size_t mutex_index = reinterpret_cast<std::size_t>(new_impl.get());
@@ -67,6 +76,7 @@ strand_executor_service::create_implementation()
   if (!mutexes_[mutex_index].get())
     mutexes_[mutex_index].reset(new mutex);
   new_impl->mutex_ = mutexes_[mutex_index].get();
+#endif // !defined(ASIO_HAS_LOCK_FREE_STRAND)
 
   // Insert implementation into linked list of all implementations.
   new_impl->next_ = impl_list_;
@@ -92,6 +102,64 @@ strand_executor_service::strand_impl::~strand_impl()
     next_->prev_= prev_;
 }
 
+#if defined(ASIO_HAS_LOCK_FREE_STRAND)
+
+bool strand_executor_service::enqueue(const implementation_type& impl,
+    scheduler_operation* op)
+{
+  if (impl->shutdown_)
+  {
+    op->destroy();
+    return false;
+  }
+
+  impl->waiting_queue_.push(op);
+
+  // If the strand was shut down while the function was being added, make
+  // sure that it is not left behind in the queue.
+  if (impl->shutdown_)
+  {
+    op_queue<scheduler_operation> ops;
+    impl->waiting_queue_.pop_all(ops);
+    return false;
+  }
+
+  // Try to acquire the strand lock. If some other function already holds it,
+  // the new function will be picked up when that lock is released.
+  bool locked = false;
+  if (!impl->locked_.compare_exchange_strong(locked, true))
+    return false;
+
+  // The function is acquiring the strand lock and so is responsible for
+  // scheduling the strand.
+  impl->waiting_queue_.pop_all(impl->ready_queue_);
+  return true;
+}
+
+bool strand_executor_service::push_waiting_to_ready(
+    implementation_type& impl)
+{
+  impl->waiting_queue_.pop_all(impl->ready_queue_);
+  if (!impl->ready_queue_.empty())
+    return true;
+
+  // Release the lock. A function may have been added after the queue was
+  // checked, but before the lock was released, in which case this thread
+  // must try to reacquire the lock so that the function is not missed.
+  impl->locked_ = false;
+  if (impl->waiting_queue_.empty())
+    return false;
+
+  bool locked = false;
+  if (!impl->locked_.compare_exchange_strong(locked, true))
+    return false;
+
+  impl->waiting_queue_.pop_all(impl->ready_queue_);
+  return true;
+}
+
+#else // defined(ASIO_HAS_LOCK_FREE_STRAND)
+
 bool strand_executor_service::enqueue(const implementation_type& impl,
     scheduler_operation* op)
 {
@@ -120,6 +188,18 @@ bool strand_executor_service::enqueue(const implementation_type& impl,
   }
 }
 
+bool strand_executor_service::push_waiting_to_ready(
+    implementation_type& impl)
+{
+  impl->mutex_->lock();
+  impl->ready_queue_.push(impl->waiting_queue_);
+  bool more_handlers = impl->locked_ = !impl->ready_queue_.empty();
+  impl->mutex_->unlock();
+  return more_handlers;
+}
+
+#endif // defined(ASIO_HAS_LOCK_FREE_STRAND)
+
 bool strand_executor_service::running_in_this_thread(
     const implementation_type& impl)
 {
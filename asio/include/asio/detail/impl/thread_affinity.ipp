@@ -0,0 +1,169 @@
+//
+// detail/impl/thread_affinity.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
+#define ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "asio/detail/thread_affinity.hpp"
+#include "asio/error.hpp"
+
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+# include <cerrno>
+# include <fstream>
+# include <string>
+# include <utility>
+# include <dirent.h>
+# include <sched.h>
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+namespace thread_affinity {
+
+void numa_nodes(std::vector<std::vector<int> >& nodes)
+{
+  nodes.clear();
+
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return;
+
+  // Find the nodes, which are not necessarily numbered contiguously.
+  std::vector<std::pair<int, std::vector<int> > > found;
+  const char* node_path = "/sys/devices/system/node/";
+  if (DIR* dir = ::opendir(node_path))
+  {
+    while (dirent* entry = ::readdir(dir))
+    {
+      const char* name = entry->d_name;
+      if (std::strncmp(name, "node", 4) != 0
+          || name[4] < '0' || name[4] > '9')
+        continue;
+
+      std::ifstream file((std::string(node_path)
+            + name + "/cpulist").c_str());
+      std::string list;
+      if (!std::getline(file, list))
+        continue;
+
+      std::vector<int> cpus;
+      parse_cpu_list(list.c_str(), cpus);
+      std::vector<int> usable;
+      for (std::size_t i = 0; i < cpus.size(); ++i)
+        if (cpus[i] < CPU_SETSIZE && CPU_ISSET(cpus[i], &allowed))
+          usable.push_back(cpus[i]);
+
+      if (!usable.empty())
+        found.push_back(std::make_pair(std::atoi(name + 4), usable));
+    }
+    ::closedir(dir);
+  }
+
+  std::sort(found.begin(), found.end());
+  for (std::size_t i = 0; i < found.size(); ++i)
+    nodes.push_back(found[i].second);
+
+  if (nodes.empty())
+  {
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &allowed))
+        cpus.push_back(cpu);
+    if (!cpus.empty())
+      nodes.push_back(cpus);
+  }
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+}
+
+void parse_cpu_list(const char* list, std::vector<int>& cpus)
+{
+  while (*list)
+  {
+    char* end = 0;
+    long first = std::strtol(list, &end, 10);
+    if (end == list)
+    {
+      // Skip separators and whitespace.
+      ++list;
+      continue;
+    }
+
+    long last = first;
+    list = end;
+    if (*list == '-')
+    {
+      last = std::strtol(list + 1, &end, 10);
+      if (end == list + 1)
+        last = first;
+      list = end;
+    }
+
+    for (long cpu = first; cpu >= 0 && cpu <= last; ++cpu)
+      cpus.push_back(static_cast<int>(cpu));
+  }
+}
+
+asio::error_code pin_current_thread(
+    const std::vector<int>& cpus, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  bool any = false;
+  for (std::size_t i = 0; i < cpus.size(); ++i)
+  {
+    if (cpus[i] >= 0 && cpus[i] < CPU_SETSIZE)
+    {
+      CPU_SET(cpus[i], &set);
+      any = true;
+    }
+  }
+
+  if (!any)
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  if (::sched_setaffinity(0, sizeof(set), &set) != 0)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return ec;
+  }
+
+  ec = asio::error_code();
+  return ec;
+#else // defined(ASIO_HAS_THREAD_AFFINITY)
+  (void)cpus;
+  ec = asio::error::operation_not_supported;
+  return ec;
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+}
+
+} // namespace thread_affinity
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_THREAD_AFFINITY_IPP
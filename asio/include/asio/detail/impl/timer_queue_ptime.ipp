@@ -75,6 +75,12 @@ std::size_t timer_queue<time_traits<boost::posix_time::ptime> >::cancel_timer(
   return impl_.cancel_timer(timer, ops, max_cancelled);
 }
 
+bool timer_queue<time_traits<boost::posix_time::ptime> >::reschedule_timer(
+    const time_type& time, per_timer_data& timer)
+{
+  return impl_.reschedule_timer(time, timer);
+}
+
 void timer_queue<time_traits<boost::posix_time::ptime> >::move_timer(
     per_timer_data& target, per_timer_data& source)
 {
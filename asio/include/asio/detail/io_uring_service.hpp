@@ -0,0 +1,380 @@
+//
+// detail/io_uring_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_SERVICE_HPP
+#define ASIO_DETAIL_IO_URING_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <linux/io_uring.h>
+#include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/limits.hpp"
+#include "asio/detail/object_pool.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/reactor_statistics.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/timer_queue_set.hpp"
+#include "asio/detail/wait_op.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A reactor implementation that uses a Linux io_uring instance in place of an
+// epoll set. Socket receives, sends, accepts and connects that support it are
+// submitted to the kernel as requests of their own, and are completed from
+// the corresponding completion queue entries. All other operations wait for
+// readiness notifications obtained using multishot poll requests. Timers are
+// waited for using a single timeout request. Queued entries are handed to the
+// kernel by the same io_uring_enter call that waits for completions, unless a
+// thread is already blocked waiting.
+class io_uring_service
+  : public execution_context_service_base<io_uring_service>
+{
+private:
+  // The mutex type used by this reactor.
+  typedef conditionally_enabled_mutex mutex;
+
+public:
+  enum op_types { read_op = 0, write_op = 1,
+    connect_op = 1, except_op = 2, error_op = 3, max_ops = 4 };
+
+  // Per-descriptor queues.
+  class descriptor_state : operation
+  {
+    friend class io_uring_service;
+    friend class object_pool_access;
+
+    descriptor_state* next_;
+    descriptor_state* prev_;
+
+    mutex mutex_;
+    io_uring_service* service_;
+    int descriptor_;
+    uint32_t registered_events_;
+    op_queue<reactor_op> op_queue_[max_ops];
+    bool try_speculative_[max_ops];
+    bool shutdown_;
+
+    // Whether a multishot poll request is outstanding in the kernel. The
+    // object cannot be freed until the kernel has delivered the poll's final
+    // completion, as the object's address is used as the request's user data.
+    bool poll_armed_;
+
+    // Operations that have been submitted to the kernel and whose completions
+    // have not yet been delivered. The object cannot be freed until these
+    // completions have been delivered.
+    op_queue<reactor_op> submitted_ops_[max_ops];
+
+    // Whether cleanup_descriptor_data has been called while the poll request
+    // or submitted operations were still outstanding.
+    bool free_pending_;
+
+    ASIO_DECL descriptor_state(bool locking);
+    void set_ready_events(uint32_t events) { task_result_ = events; }
+    void add_ready_events(uint32_t events) { task_result_ |= events; }
+    ASIO_DECL operation* perform_io(uint32_t events);
+    ASIO_DECL static void do_complete(
+        void* owner, operation* base,
+        const asio::error_code& ec, std::size_t bytes_transferred);
+  };
+
+  // Per-descriptor data.
+  typedef descriptor_state* per_descriptor_data;
+
+  // Constructor.
+  ASIO_DECL io_uring_service(asio::execution_context& ctx);
+
+  // Destructor.
+  ASIO_DECL ~io_uring_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Recreate internal descriptors following a fork.
+  ASIO_DECL void notify_fork(
+      asio::execution_context::fork_event fork_ev);
+
+  // Initialise the task.
+  ASIO_DECL void init_task();
+
+  // Register a socket with the reactor. Returns 0 on success, system error
+  // code on failure.
+  ASIO_DECL int register_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Register a descriptor with an associated single operation. Returns 0 on
+  // success, system error code on failure.
+  ASIO_DECL int register_internal_descriptor(
+      int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op);
+
+  // Move descriptor registration from one descriptor_data object to another.
+  ASIO_DECL void move_descriptor(socket_type descriptor,
+      per_descriptor_data& target_descriptor_data,
+      per_descriptor_data& source_descriptor_data);
+
+  // Post a reactor operation for immediate completion.
+  void post_immediate_completion(reactor_op* op, bool is_continuation)
+  {
+    scheduler_.post_immediate_completion(op, is_continuation);
+  }
+
+  // Start a new operation. The reactor operation will be performed when the
+  // given descriptor is flagged as ready, or an error has occurred.
+  ASIO_DECL void start_op(int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op,
+      bool is_continuation, bool allow_speculative);
+
+  // Cancel all operations associated with the given descriptor. The
+  // handlers associated with the descriptor will be invoked with the
+  // operation_aborted error.
+  ASIO_DECL void cancel_ops(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Cancel any operations that are running against the descriptor and remove
+  // its registration from the reactor. The reactor resources associated with
+  // the descriptor must be released by calling cleanup_descriptor_data.
+  ASIO_DECL void deregister_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data, bool closing);
+
+  // Remove the descriptor's registration from the reactor. The reactor
+  // resources associated with the descriptor must be released by calling
+  // cleanup_descriptor_data.
+  ASIO_DECL void deregister_internal_descriptor(
+      socket_type descriptor, per_descriptor_data& descriptor_data);
+
+  // Perform any post-deregistration cleanup tasks associated with the
+  // descriptor data.
+  ASIO_DECL void cleanup_descriptor_data(
+      per_descriptor_data& descriptor_data);
+
+  // Add a new timer queue to the reactor.
+  template <typename Time_Traits>
+  void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Remove a timer queue from the reactor.
+  template <typename Time_Traits>
+  void remove_timer_queue(timer_queue<Time_Traits>& timer_queue);
+
+  // Schedule a new operation in the given timer queue to expire at the
+  // specified absolute time.
+  template <typename Time_Traits>
+  void schedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer, wait_op* op);
+
+  // Cancel the timer operations associated with the given token. Returns the
+  // number of operations that have been posted or dispatched.
+  template <typename Time_Traits>
+  std::size_t cancel_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
+
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
+  // Move the timer operations associated with the given timer.
+  template <typename Time_Traits>
+  void move_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& target,
+      typename timer_queue<Time_Traits>::per_timer_data& source);
+
+  // Submit pending requests and wait until interrupted or completions are
+  // ready to be dispatched.
+  ASIO_DECL void run(long usec, op_queue<operation>& ops);
+
+  // Interrupt the io_uring_enter call.
+  ASIO_DECL void interrupt();
+
+  // Set the maximum number of events collected by each wait. The io_uring service
+  // does not collect events in batches, so the setting has no effect.
+  void set_batch_size(std::size_t)
+  {
+  }
+
+  // Get the counters that describe the waits for events. The counters are
+  // not maintained by the io_uring service.
+  reactor_statistics statistics()
+  {
+    reactor_statistics stats = { 0, 0, 0, 0 };
+    return stats;
+  }
+
+private:
+  // The number of submission queue entries in the ring.
+  enum { ring_size = 256 };
+
+  // The number of completion queue entries in the ring.
+  enum { completion_ring_size = 16 * ring_size };
+
+  // The user data of a submitted operation is the operation's address, with
+  // the low bits set to a marker and the operation type.
+  enum { submitted_op_flag = 1, submitted_op_mask = 3 };
+
+  // The memory mapped views of the kernel's submission and completion rings.
+  struct ring
+  {
+    void* sq_ptr;
+    std::size_t sq_map_size;
+    void* cq_ptr;
+    std::size_t cq_map_size;
+    io_uring_sqe* sqes;
+    std::size_t sqes_map_size;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    io_uring_cqe* cqes;
+  };
+
+  // Create the io_uring instance and map its rings. Throws an exception if the
+  // ring cannot be created or lacks a required feature.
+  ASIO_DECL static int do_io_uring_setup(ring& r);
+
+  // Unmap the ring's memory and close the io_uring descriptor.
+  ASIO_DECL static void do_io_uring_teardown(int fd, ring& r);
+
+  // Copy an entry into the submission queue. Returns false if the queue is
+  // full and could not be drained. The submit mutex must be held.
+  ASIO_DECL bool push_sqe(const io_uring_sqe& sqe);
+
+  // Queue a multishot poll request for the descriptor. The submit mutex and
+  // the descriptor's mutex must both be held.
+  ASIO_DECL bool prep_poll_add(descriptor_state* descriptor_data);
+
+  // Queue an update to the events monitored by a descriptor's poll request.
+  // The submit mutex and the descriptor's mutex must both be held.
+  ASIO_DECL bool prep_poll_update(descriptor_state* descriptor_data);
+
+  // Queue the removal of a descriptor's poll request. The submit mutex and the
+  // descriptor's mutex must both be held.
+  ASIO_DECL bool prep_poll_remove(descriptor_state* descriptor_data);
+
+  // Queue an entry that performs the operation itself. The submit mutex and
+  // the descriptor's mutex must both be held.
+  ASIO_DECL bool prep_submission(descriptor_state* descriptor_data,
+      int op_type, reactor_op* op, io_uring_sqe& sqe);
+
+  // Queue the cancellation of all of a descriptor's submitted operations. The
+  // submit mutex and the descriptor's mutex must both be held.
+  ASIO_DECL void prep_cancel_submissions(descriptor_state* descriptor_data);
+
+  // Arm or update the timeout request so that it expires after the given
+  // number of microseconds. The submit mutex must be held.
+  ASIO_DECL bool prep_timeout(long usec);
+
+  // Complete a submitted operation given its completion queue entry.
+  ASIO_DECL void complete_submission(const io_uring_cqe& cqe,
+      op_queue<operation>& ops);
+
+  // Hand queued entries to the kernel now if a thread is blocked waiting for
+  // completions, or if forced. Otherwise they will be submitted by the next
+  // call to run(). The submit mutex must be held.
+  ASIO_DECL void submit_sqes(bool force);
+
+  // Allocate a new descriptor state object.
+  ASIO_DECL descriptor_state* allocate_descriptor_state();
+
+  // Free an existing descriptor state object.
+  ASIO_DECL void free_descriptor_state(descriptor_state* s);
+
+  // Helper function to add a new timer queue.
+  ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
+
+  // Helper function to remove a timer queue.
+  ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
+
+  // Called to recalculate and update the timeout.
+  ASIO_DECL void update_timeout();
+
+  // Get the timeout value for the io_uring_enter call. The timeout value is
+  // returned as a number of microseconds. A negative value indicates that the
+  // call should block indefinitely.
+  ASIO_DECL long get_timeout(long usec);
+
+  // The scheduler implementation used to post completions.
+  scheduler& scheduler_;
+
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // Mutex to protect access to the submission queue.
+  mutex submit_mutex_;
+
+  // The mapped rings.
+  ring ring_;
+
+  // The io_uring file descriptor.
+  int ring_fd_;
+
+  // The number of entries that have been queued but not yet submitted.
+  unsigned pending_sqes_;
+
+  // Whether a thread is blocked in io_uring_enter waiting for completions.
+  bool waiting_;
+
+  // Whether an interrupting no-op request is queued or in flight.
+  bool interrupt_pending_;
+
+  // The absolute expiry time of the timeout request, on the monotonic clock.
+  __kernel_timespec timeout_;
+
+  // Whether the timeout request is queued or in flight.
+  bool timeout_armed_;
+
+  // The timer queues.
+  timer_queue_set timer_queues_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+
+  // Mutex to protect access to the registered descriptors.
+  mutex registered_descriptors_mutex_;
+
+  // Keep track of all registered descriptors.
+  object_pool<descriptor_state> registered_descriptors_;
+
+  // Helper class to do post-perform_io cleanup.
+  struct perform_io_cleanup_on_block_exit;
+  friend struct perform_io_cleanup_on_block_exit;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/detail/impl/io_uring_service.hpp"
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/io_uring_service.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_SERVICE_HPP
@@ -0,0 +1,105 @@
+//
+// detail/mpsc_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MPSC_OP_QUEUE_HPP
+#define ASIO_DETAIL_MPSC_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// An unbounded, lock-free queue of operations. Any thread may push, but only
+// a single consumer at a time may remove operations, and it does so by taking
+// everything that has been pushed so far.
+template <typename Operation>
+class mpsc_op_queue
+  : private noncopyable
+{
+public:
+  // Construct an empty queue.
+  mpsc_op_queue()
+    : head_(0)
+  {
+  }
+
+  // Destructor destroys all operations.
+  ~mpsc_op_queue()
+  {
+    op_queue<Operation> ops;
+    pop_all(ops);
+  }
+
+  // Add an operation to the queue. May be called from any thread.
+  void push(Operation* op)
+  {
+    Operation* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+      op_queue_access::next(op, head);
+    } while (!head_.compare_exchange_weak(head, op));
+  }
+
+  // Move all operations to the back of the given queue, preserving the order
+  // in which they were pushed. Must only be called by the consumer.
+  void pop_all(op_queue<Operation>& ops)
+  {
+    Operation* head = head_.exchange(0);
+
+    // The operations are linked in the reverse of the order they were pushed.
+    Operation* reversed = 0;
+    while (head)
+    {
+      Operation* next = op_queue_access::next(head);
+      op_queue_access::next(head, reversed);
+      reversed = head;
+      head = next;
+    }
+
+    while (reversed)
+    {
+      Operation* next = op_queue_access::next(reversed);
+      op_queue_access::next(reversed, static_cast<Operation*>(0));
+      ops.push(reversed);
+      reversed = next;
+    }
+  }
+
+  // Whether the queue appears to be empty.
+  bool empty() const
+  {
+    return head_.load() == 0;
+  }
+
+private:
+  // The most recently pushed operation.
+  std::atomic<Operation*> head_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_STD_ATOMIC)
+
+#endif // ASIO_DETAIL_MPSC_OP_QUEUE_HPP
@@ -19,6 +19,7 @@
 
 #if defined(ASIO_HAS_IOCP) || defined(ASIO_WINDOWS_RUNTIME)
 
+#include "asio/detail/reactor_statistics.hpp"
 #include "asio/detail/scheduler_operation.hpp"
 #include "asio/execution_context.hpp"
 
@@ -56,6 +57,19 @@ public:
   void interrupt()
   {
   }
+
+  // No-op.
+  void set_batch_size(std::size_t)
+  {
+  }
+
+  // Get the counters that describe the waits for events, which are always
+  // zero.
+  reactor_statistics statistics()
+  {
+    reactor_statistics stats = { 0, 0, 0, 0 };
+    return stats;
+  }
 };
 
 } // namespace detail
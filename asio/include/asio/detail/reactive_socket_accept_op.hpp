@@ -48,6 +48,10 @@ public:
       peer_endpoint_(peer_endpoint),
       addrlen_(peer_endpoint ? peer_endpoint->capacity() : 0)
   {
+#if defined(ASIO_HAS_IO_URING)
+    this->enable_submission(&reactive_socket_accept_op_base::do_prepare,
+        &reactive_socket_accept_op_base::do_submission);
+#endif // defined(ASIO_HAS_IO_URING)
   }
 
   static status do_perform(reactor_op* base)
@@ -67,6 +71,53 @@ public:
     return result;
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, io_uring_sqe& sqe)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    o->submission_addrlen_ = static_cast<socklen_t>(o->addrlen_);
+    sqe.opcode = IORING_OP_ACCEPT;
+    sqe.fd = o->socket_;
+    if (o->peer_endpoint_)
+    {
+      sqe.addr = reinterpret_cast<__u64>(o->peer_endpoint_->data());
+      sqe.addr2 = reinterpret_cast<__u64>(&o->submission_addrlen_);
+    }
+    return true;
+  }
+
+  static status do_submission(reactor_op* base, int result)
+  {
+    reactive_socket_accept_op_base* o(
+        static_cast<reactive_socket_accept_op_base*>(base));
+
+    // Retry using the reactor if the operation was interrupted, or if the
+    // connection was aborted and the application has not asked to see it.
+    if (result == -EAGAIN || result == -EINTR)
+      return not_done;
+    if (result == -ECONNABORTED || result == -EPROTO)
+      if ((o->state_ & socket_ops::enable_connection_aborted) == 0)
+        return not_done;
+
+    if (result < 0)
+    {
+      o->ec_ = asio::error_code(-result,
+          asio::error::get_system_category());
+    }
+    else
+    {
+      o->new_socket_.reset(result);
+      o->addrlen_ = o->submission_addrlen_;
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "io_uring_accept", o->ec_));
+
+    return done;
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+
   void do_assign()
   {
     if (new_socket_.get() != invalid_socket)
@@ -87,6 +138,9 @@ private:
   Protocol protocol_;
   typename Protocol::endpoint* peer_endpoint_;
   std::size_t addrlen_;
+#if defined(ASIO_HAS_IO_URING)
+  socklen_t submission_addrlen_;
+#endif // defined(ASIO_HAS_IO_URING)
 };
 
 template <typename Socket, typename Protocol,
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstring>
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
@@ -54,8 +55,52 @@ public:
     return result;
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  // Record the peer address so that the connect itself can be submitted. The
+  // address is copied as it must remain valid until the submission is made.
+  void set_peer_address(const socket_addr_type* addr, std::size_t addrlen)
+  {
+    addrlen_ = addrlen < sizeof(addr_) ? addrlen : sizeof(addr_);
+    std::memcpy(&addr_, addr, addrlen_);
+    this->enable_submission(&reactive_socket_connect_op_base::do_prepare,
+        &reactive_socket_connect_op_base::do_submission);
+  }
+
+  static bool do_prepare(reactor_op* base, io_uring_sqe& sqe)
+  {
+    reactive_socket_connect_op_base* o(
+        static_cast<reactive_socket_connect_op_base*>(base));
+
+    sqe.opcode = IORING_OP_CONNECT;
+    sqe.fd = o->socket_;
+    sqe.addr = reinterpret_cast<__u64>(&o->addr_);
+    sqe.off = o->addrlen_;
+    return true;
+  }
+
+  static status do_submission(reactor_op* base, int result)
+  {
+    reactive_socket_connect_op_base* o(
+        static_cast<reactive_socket_connect_op_base*>(base));
+
+    if (result < 0)
+    {
+      o->ec_ = asio::error_code(-result,
+          asio::error::get_system_category());
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "io_uring_connect", o->ec_));
+
+    return done;
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+
 private:
   socket_type socket_;
+#if defined(ASIO_HAS_IO_URING)
+  sockaddr_storage_type addr_;
+  std::size_t addrlen_;
+#endif // defined(ASIO_HAS_IO_URING)
 };
 
 template <typename Handler, typename IoExecutor>
@@ -46,6 +46,11 @@ public:
       buffers_(buffers),
       flags_(flags)
   {
+#if defined(ASIO_HAS_IO_URING)
+    if ((flags & socket_base::message_out_of_band) == 0)
+      this->enable_submission(&reactive_socket_recv_op_base::do_prepare,
+          &reactive_socket_recv_op_base::do_submission);
+#endif // defined(ASIO_HAS_IO_URING)
   }
 
   static status do_perform(reactor_op* base)
@@ -85,6 +90,65 @@ public:
     return result;
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  static bool do_prepare(reactor_op* base, io_uring_sqe& sqe)
+  {
+    reactive_socket_recv_op_base* o(
+        static_cast<reactive_socket_recv_op_base*>(base));
+
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    // Only a single, non-empty buffer can be submitted without additional
+    // storage for the operation.
+    if (!bufs_type::is_single_buffer)
+      return false;
+    asio::mutable_buffer buffer = bufs_type::first(o->buffers_);
+    if (buffer.size() == 0)
+      return false;
+
+    sqe.opcode = IORING_OP_RECV;
+    sqe.fd = o->socket_;
+    sqe.addr = reinterpret_cast<__u64>(buffer.data());
+    sqe.len = static_cast<__u32>(buffer.size() < 0x7FFFFFFF
+        ? buffer.size() : 0x7FFFFFFF);
+    sqe.msg_flags = static_cast<__u32>(o->flags_);
+    return true;
+  }
+
+  static status do_submission(reactor_op* base, int result)
+  {
+    reactive_socket_recv_op_base* o(
+        static_cast<reactive_socket_recv_op_base*>(base));
+
+    // Retry using the reactor if the operation was interrupted.
+    if (result == -EAGAIN || result == -EINTR)
+      return not_done;
+
+    status s = done;
+    if (result < 0)
+    {
+      o->ec_ = asio::error_code(-result,
+          asio::error::get_system_category());
+    }
+    else if (result == 0 && (o->state_ & socket_ops::stream_oriented) != 0)
+    {
+      // Check for EOF.
+      o->ec_ = asio::error::eof;
+      s = done_and_exhausted;
+    }
+    else
+    {
+      o->bytes_transferred_ = result;
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "io_uring_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return s;
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+
 private:
   socket_type socket_;
   socket_ops::state_type state_;
@@ -0,0 +1,211 @@
+//
+// detail/reactive_socket_send_zerocopy_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZEROCOPY_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZEROCOPY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The zero-copy send state of a socket. The kernel numbers the zero-copy sends
+// made on a socket, starting from zero, and reports the ranges of sends whose
+// buffers it has released through the socket's error queue.
+struct zerocopy_send_state
+{
+  // Whether the SO_ZEROCOPY option was successfully enabled on the socket.
+  bool enabled_;
+
+  // The number that the kernel will assign to the next zero-copy send.
+  uint32_t next_;
+
+  // The buffers of all sends numbered before this value have been released.
+  uint32_t released_;
+};
+
+template <typename ConstBufferSequence>
+class reactive_socket_send_zerocopy_op_base : public reactor_op
+{
+public:
+  reactive_socket_send_zerocopy_op_base(const asio::error_code& success_ec,
+      socket_type socket, const shared_ptr<zerocopy_send_state>& state,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_send_zerocopy_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      buffers_(buffers),
+      flags_(flags),
+      sent_(false),
+      id_(0)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_send_zerocopy_op_base* o(
+        static_cast<reactive_socket_send_zerocopy_op_base*>(base));
+
+    if (o->sent_)
+    {
+      // Collect the notifications that have arrived. Notifications for TCP
+      // sockets arrive in order, so each range extends those before it.
+      uint32_t first = 0, last = 0;
+      asio::error_code ec;
+      while (socket_ops::recv_zerocopy_notification(
+            o->socket_, first, last, ec))
+      {
+        if (static_cast<int32_t>(last + 1 - o->state_->released_) > 0)
+          o->state_->released_ = last + 1;
+      }
+
+      ASIO_HANDLER_REACTOR_OPERATION((*o, "recv_zerocopy_notification",
+            o->ec_, o->bytes_transferred_));
+
+      return static_cast<int32_t>(o->state_->released_ - o->id_) > 0
+        ? done : not_done;
+    }
+
+    typedef buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs_type;
+
+    bufs_type bufs(o->buffers_);
+    int flags = o->flags_;
+    if (o->state_->enabled_)
+      flags |= ASIO_OS_DEF(MSG_ZEROCOPY);
+    status result = socket_ops::non_blocking_send(o->socket_,
+        bufs.buffers(), bufs.count(), flags,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    // The kernel fails a zero-copy send when the socket's limit on pinned
+    // memory is reached. Fall back to a copying send.
+    if (result == done && o->ec_ == asio::error::no_buffer_space
+        && (flags & ASIO_OS_DEF(MSG_ZEROCOPY)) != 0)
+    {
+      flags = o->flags_;
+      result = socket_ops::non_blocking_send(o->socket_,
+          bufs.buffers(), bufs.count(), flags,
+          o->ec_, o->bytes_transferred_) ? done : not_done;
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_send",
+          o->ec_, o->bytes_transferred_));
+
+    if (result == done && !o->ec_ && o->bytes_transferred_ > 0
+        && (flags & ASIO_OS_DEF(MSG_ZEROCOPY)) != 0)
+    {
+      // The operation is complete once the kernel has released the buffers.
+      o->sent_ = true;
+      o->id_ = o->state_->next_++;
+      return wait_for_error;
+    }
+
+    return result;
+  }
+
+private:
+  socket_type socket_;
+  shared_ptr<zerocopy_send_state> state_;
+  ConstBufferSequence buffers_;
+  socket_base::message_flags flags_;
+  bool sent_;
+  uint32_t id_;
+};
+
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class reactive_socket_send_zerocopy_op :
+  public reactive_socket_send_zerocopy_op_base<ConstBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_zerocopy_op);
+
+  reactive_socket_send_zerocopy_op(const asio::error_code& success_ec,
+      socket_type socket, const shared_ptr<zerocopy_send_state>& state,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_send_zerocopy_op_base<ConstBufferSequence>(
+        success_ec, socket, state, buffers, flags,
+        &reactive_socket_send_zerocopy_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_send_zerocopy_op* o(
+        static_cast<reactive_socket_send_zerocopy_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
+          o->work_));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZEROCOPY_OP_HPP
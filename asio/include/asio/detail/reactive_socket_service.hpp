@@ -24,13 +24,18 @@
 #include "asio/execution_context.hpp"
 #include "asio/socket_base.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/datagram_batch_adapter.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/reactive_null_buffers_op.hpp"
 #include "asio/detail/reactive_socket_accept_op.hpp"
 #include "asio/detail/reactive_socket_connect_op.hpp"
 #include "asio/detail/reactive_socket_recvfrom_op.hpp"
+#include "asio/detail/reactive_socket_recvfrom_segmented_op.hpp"
+#include "asio/detail/reactive_socket_recvmmsg_op.hpp"
+#include "asio/detail/reactive_socket_sendmmsg_op.hpp"
 #include "asio/detail/reactive_socket_sendto_op.hpp"
+#include "asio/detail/reactive_socket_sendto_segmented_op.hpp"
 #include "asio/detail/reactive_socket_service_base.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -405,6 +410,195 @@ public:
     p.v = p.p = 0;
   }
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  // Send a batch of datagrams, each to its own endpoint. Returns the number of
+  // datagrams sent.
+  template <typename Record>
+  size_t send_batch(implementation_type& impl, Record* records,
+      std::size_t count, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    datagram_batch_adapter<asio::const_buffer, Record> batch(records, count);
+    size_t msgs_sent = socket_ops::sync_sendmmsg(impl.socket_,
+        impl.state_, batch.msgs(), batch.count(), flags, ec);
+
+    if (!ec)
+      batch.complete(msgs_sent);
+
+    return msgs_sent;
+  }
+
+  // Start an asynchronous send of a batch of datagrams. The records and the
+  // data being sent must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Record, typename Handler, typename IoExecutor>
+  void async_send_batch(implementation_type& impl, Record* records,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<Record, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        records, count, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_batch"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+
+  // Receive a batch of datagrams, each with the endpoint of its sender.
+  // Returns the number of datagrams received.
+  template <typename Record>
+  size_t receive_batch(implementation_type& impl, Record* records,
+      std::size_t count, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    datagram_batch_adapter<asio::mutable_buffer, Record> batch(
+        records, count);
+    size_t msgs_recvd = socket_ops::sync_recvmmsg(impl.socket_,
+        impl.state_, batch.msgs(), batch.count(), flags, ec);
+
+    if (!ec)
+      batch.complete(msgs_recvd);
+
+    return msgs_recvd;
+  }
+
+  // Start an asynchronous receive of a batch of datagrams. The records and
+  // the buffers for the data being received must be valid for the lifetime of
+  // the asynchronous operation.
+  template <typename Record, typename Handler, typename IoExecutor>
+  void async_receive_batch(implementation_type& impl, Record* records,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<Record, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        records, count, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_batch"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#if defined(ASIO_HAS_UDP_GSO)
+  // Send data to the specified endpoint, to be divided by the kernel into
+  // datagrams of the given segment size. Returns the number of bytes sent.
+  template <typename ConstBufferSequence>
+  size_t send_to_segmented(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type& destination,
+      std::size_t segment_size, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    return socket_ops::sync_sendto_segmented(impl.socket_, impl.state_,
+        bufs.buffers(), bufs.count(), flags, destination.data(),
+        destination.size(), segment_size, ec);
+  }
+
+  // Start an asynchronous segmented send. The data being sent must be valid
+  // for the lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_to_segmented(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type& destination,
+      std::size_t segment_size, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendto_segmented_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers,
+        destination, segment_size, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_to_segmented"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+
+  // Receive a datagram, or a run of datagrams coalesced by the kernel, with
+  // the endpoint of the sender and the size of the segments. Returns the
+  // number of bytes received.
+  template <typename MutableBufferSequence>
+  size_t receive_from_segmented(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    std::size_t addr_len = sender_endpoint.capacity();
+    std::size_t bytes_recvd = socket_ops::sync_recvfrom_segmented(
+        impl.socket_, impl.state_, bufs.buffers(), bufs.count(), flags,
+        sender_endpoint.data(), &addr_len, &segment_size, ec);
+
+    if (!ec)
+      sender_endpoint.resize(addr_len);
+
+    return bytes_recvd;
+  }
+
+  // Start an asynchronous segmented receive. The buffer for the data being
+  // received, the sender_endpoint object and the segment_size object must
+  // all be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_from_segmented(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvfrom_segmented_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers,
+        sender_endpoint, segment_size, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_from_segmented"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_UDP_GSO)
+
   // Accept a new connection.
   template <typename Socket>
   asio::error_code accept(implementation_type& impl,
@@ -27,9 +27,13 @@
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactive_null_buffers_op.hpp"
+#include "asio/detail/reactive_socket_connect_op.hpp"
 #include "asio/detail/reactive_socket_recv_op.hpp"
 #include "asio/detail/reactive_socket_recvmsg_op.hpp"
 #include "asio/detail/reactive_socket_send_op.hpp"
+#include "asio/detail/reactive_socket_send_zerocopy_op.hpp"
+#include "asio/detail/reactive_socket_sendfile_op.hpp"
+#include "asio/detail/reactive_socket_splice_op.hpp"
 #include "asio/detail/reactive_wait_op.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -59,6 +63,11 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // The zero-copy send state, created by the first zero-copy send.
+    shared_ptr<zerocopy_send_state> zerocopy_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
   };
 
   // Constructor.
@@ -292,6 +301,36 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Start an asynchronous zero-copy send. The data being sent must be valid
+  // until the kernel has released it, when the handler is called.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_zerocopy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_zerocopy_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        get_zerocopy_state(impl), buffers, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_zerocopy"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler, typename IoExecutor>
   void async_send(base_implementation_type& impl, const null_buffers&,
@@ -313,6 +352,74 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_SENDFILE)
+  // Send data from a file to the peer.
+  size_t sendfile(base_implementation_type& impl, int file,
+      uint64_t offset, std::size_t size, asio::error_code& ec)
+  {
+    return socket_ops::sync_sendfile(impl.socket_,
+        impl.state_, file, offset, size, ec);
+  }
+
+  // Start an asynchronous send of data from a file. The file descriptor must
+  // be valid for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_sendfile(base_implementation_type& impl, int file,
+      uint64_t offset, std::size_t size, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendfile_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        file, offset, size, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_sendfile"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, size == 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#if defined(ASIO_HAS_SPLICE)
+  // Move data received from the peer into a pipe.
+  size_t splice_to(base_implementation_type& impl, int pipe,
+      std::size_t size, asio::error_code& ec)
+  {
+    return socket_ops::sync_splice_to(impl.socket_,
+        impl.state_, pipe, size, ec);
+  }
+
+  // Send data from a pipe to the peer.
+  size_t splice_from(base_implementation_type& impl, int pipe,
+      std::size_t size, asio::error_code& ec)
+  {
+    return socket_ops::sync_splice_from(impl.socket_,
+        impl.state_, pipe, size, ec);
+  }
+
+  // Start an asynchronous move of data received from the peer into a pipe.
+  template <typename Handler, typename IoExecutor>
+  void async_splice_to(base_implementation_type& impl, int pipe,
+      std::size_t size, Handler& handler, const IoExecutor& io_ex)
+  {
+    start_splice_op(impl, pipe, true, size, handler, io_ex);
+  }
+
+  // Start an asynchronous send of data from a pipe to the peer.
+  template <typename Handler, typename IoExecutor>
+  void async_splice_from(base_implementation_type& impl, int pipe,
+      std::size_t size, Handler& handler, const IoExecutor& io_ex)
+  {
+    start_splice_op(impl, pipe, false, size, handler, io_ex);
+  }
+#endif // defined(ASIO_HAS_SPLICE)
+
   // Receive some data from the peer. Returns the number of bytes received.
   template <typename MutableBufferSequence>
   size_t receive(base_implementation_type& impl,
@@ -516,9 +623,42 @@ protected:
 
   // Start the asynchronous connect operation.
   ASIO_DECL void start_connect_op(base_implementation_type& impl,
-      reactor_op* op, bool is_continuation,
+      reactive_socket_connect_op_base* op, bool is_continuation,
       const socket_addr_type* addr, size_t addrlen);
 
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Get the zero-copy send state, enabling zero-copy sends on first use.
+  ASIO_DECL shared_ptr<zerocopy_send_state> get_zerocopy_state(
+      base_implementation_type& impl);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SPLICE)
+  // Start an asynchronous move of data between the socket and a pipe.
+  template <typename Handler, typename IoExecutor>
+  void start_splice_op(base_implementation_type& impl, int pipe,
+      bool to_pipe, std::size_t size, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_splice_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        pipe, to_pipe, size, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, to_pipe ? "async_splice_to"
+          : "async_splice_from"));
+
+    start_op(impl, to_pipe ? reactor::read_op : reactor::write_op,
+        p.p, is_continuation, true, size == 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SPLICE)
+
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
 
@@ -0,0 +1,154 @@
+//
+// detail/reactive_socket_splice_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SPLICE_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SPLICE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class reactive_socket_splice_op_base : public reactor_op
+{
+public:
+  reactive_socket_splice_op_base(const asio::error_code& success_ec,
+      socket_type socket, int pipe, bool to_pipe,
+      std::size_t size, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_splice_op_base::do_perform, complete_func),
+      socket_(socket),
+      pipe_(pipe),
+      to_pipe_(to_pipe),
+      size_(size)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_splice_op_base* o(
+        static_cast<reactive_socket_splice_op_base*>(base));
+
+    status result;
+    if (o->to_pipe_)
+    {
+      result = socket_ops::non_blocking_splice_to(o->socket_,
+          o->pipe_, o->size_, o->ec_, o->bytes_transferred_)
+        ? done : not_done;
+    }
+    else
+    {
+      result = socket_ops::non_blocking_splice_from(o->socket_,
+          o->pipe_, o->size_, o->ec_, o->bytes_transferred_)
+        ? done : not_done;
+    }
+
+    if (result == done && !o->ec_)
+      if (o->bytes_transferred_ < o->size_)
+        result = done_and_exhausted;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_splice",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+private:
+  socket_type socket_;
+  int pipe_;
+  bool to_pipe_;
+  std::size_t size_;
+};
+
+template <typename Handler, typename IoExecutor>
+class reactive_socket_splice_op :
+  public reactive_socket_splice_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_splice_op);
+
+  reactive_socket_splice_op(const asio::error_code& success_ec,
+      socket_type socket, int pipe, bool to_pipe, std::size_t size,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_splice_op_base(success_ec, socket, pipe,
+        to_pipe, size, &reactive_socket_splice_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_splice_op* o(
+        static_cast<reactive_socket_splice_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
+          o->work_));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SPLICE_OP_HPP
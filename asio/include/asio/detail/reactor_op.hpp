@@ -18,6 +18,10 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/operation.hpp"
 
+#if defined(ASIO_HAS_IO_URING)
+# include <linux/io_uring.h>
+#endif // defined(ASIO_HAS_IO_URING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -34,8 +38,13 @@ public:
   std::size_t bytes_transferred_;
 
   // Status returned by perform function. May be used to decide whether it is
-  // worth performing more operations on the descriptor immediately.
-  enum status { not_done, done, done_and_exhausted };
+  // worth performing more operations on the descriptor immediately. The
+  // wait_for_error status indicates that the operation must be performed again
+  // once the descriptor's error queue is readable, and is supported only by
+  // reactors that provide an error_op queue. Operations in that queue are not
+  // aborted by cancellation, and complete with their existing result when the
+  // descriptor is deregistered.
+  enum status { not_done, done, done_and_exhausted, wait_for_error };
 
   // Perform the operation. Returns true if it is finished.
   status perform()
@@ -43,6 +52,26 @@ public:
     return perform_func_(this);
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  // Prepare an io_uring submission queue entry that performs the operation
+  // itself, rather than waiting for the descriptor to become ready. Returns
+  // false if the operation cannot be submitted.
+  bool prepare_submission(io_uring_sqe& sqe)
+  {
+    return prepare_func_ ? prepare_func_(this, sqe) : false;
+  }
+
+  // Record the result of a submitted operation. Returns not_done if the
+  // operation did not complete, and must instead wait for readiness.
+  status complete_submission(int result)
+  {
+    return submission_func_(this, result);
+  }
+
+  // The reactor's state for the descriptor while the operation is submitted.
+  void* submission_owner_;
+#endif // defined(ASIO_HAS_IO_URING)
+
 protected:
   typedef status (*perform_func_type)(reactor_op*);
 
@@ -51,10 +80,32 @@ protected:
     : operation(complete_func),
       ec_(success_ec),
       bytes_transferred_(0),
+#if defined(ASIO_HAS_IO_URING)
+      submission_owner_(0),
+      prepare_func_(0),
+      submission_func_(0),
+#endif // defined(ASIO_HAS_IO_URING)
       perform_func_(perform_func)
   {
   }
 
+#if defined(ASIO_HAS_IO_URING)
+  typedef bool (*prepare_func_type)(reactor_op*, io_uring_sqe&);
+  typedef status (*submission_func_type)(reactor_op*, int);
+
+  // Allow the operation to be submitted to io_uring.
+  void enable_submission(prepare_func_type prepare_func,
+      submission_func_type submission_func)
+  {
+    prepare_func_ = prepare_func;
+    submission_func_ = submission_func;
+  }
+
+private:
+  prepare_func_type prepare_func_;
+  submission_func_type submission_func_;
+#endif // defined(ASIO_HAS_IO_URING)
+
 private:
   perform_func_type perform_func_;
 };
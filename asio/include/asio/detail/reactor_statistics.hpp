@@ -0,0 +1,48 @@
+//
+// detail/reactor_statistics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTOR_STATISTICS_HPP
+#define ASIO_DETAIL_REACTOR_STATISTICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Counters that describe a reactor's waits for events. Reactors that do not
+// collect events in batches leave all counters at zero.
+struct reactor_statistics
+{
+  // The number of waits that have been performed.
+  std::size_t waits;
+
+  // The total number of events returned by the waits.
+  std::size_t events;
+
+  // The number of waits that returned as many events as could be collected.
+  std::size_t full_batches;
+
+  // The number of events that a wait can currently collect.
+  std::size_t batch_size;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTOR_STATISTICS_HPP
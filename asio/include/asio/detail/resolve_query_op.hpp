@@ -22,7 +22,7 @@
 #include "asio/detail/handler_invoke_helpers.hpp"
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
-#include "asio/detail/resolve_op.hpp"
+#include "asio/detail/resolver_cache.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/error.hpp"
 #include "asio/ip/basic_resolver_query.hpp"
@@ -40,7 +40,7 @@ namespace asio {
 namespace detail {
 
 template <typename Protocol, typename Handler, typename IoExecutor>
-class resolve_query_op : public resolve_op
+class resolve_query_op : public resolve_query_op_base<Protocol>
 {
 public:
   ASIO_DEFINE_HANDLER_PTR(resolve_query_op);
@@ -54,25 +54,21 @@ public:
   typedef class scheduler scheduler_impl;
 #endif
 
+  typedef resolver_cache<Protocol> cache_type;
+
   resolve_query_op(socket_ops::weak_cancel_token_type cancel_token,
-      const query_type& query, scheduler_impl& sched,
+      const query_type& query, scheduler_impl& sched, cache_type& cache,
       Handler& handler, const IoExecutor& io_ex)
-    : resolve_op(&resolve_query_op::do_complete),
-      cancel_token_(cancel_token),
+    : resolve_query_op_base<Protocol>(
+        &resolve_query_op::do_complete, cancel_token),
       query_(query),
       scheduler_(sched),
+      cache_(cache),
       handler_(ASIO_MOVE_CAST(Handler)(handler)),
-      work_(handler_, io_ex),
-      addrinfo_(0)
+      work_(handler_, io_ex)
   {
   }
 
-  ~resolve_query_op()
-  {
-    if (addrinfo_)
-      socket_ops::freeaddrinfo(addrinfo_);
-  }
-
   static void do_complete(void* owner, operation* base,
       const asio::error_code& /*ec*/,
       std::size_t /*bytes_transferred*/)
@@ -84,12 +80,25 @@ public:
     if (owner && owner != &o->scheduler_)
     {
       // The operation is being run on the worker io_context. Time to perform
-      // the resolver operation.
-    
-      // Perform the blocking host resolution operation.
-      socket_ops::background_getaddrinfo(o->cancel_token_,
-          o->query_.host_name().c_str(), o->query_.service_name().c_str(),
-          o->query_.hints(), &o->addrinfo_, o->ec_);
+      // the resolver operation, unless an identical one is already underway.
+      if (o->cancel_token_.expired())
+        o->ec_ = asio::error::operation_aborted;
+      else
+      {
+        switch (o->cache_.start(o->query_, o))
+        {
+        case cache_type::joined:
+          // The operation will be passed back to the main io_context when the
+          // identical lookup completes.
+          p.v = p.p = 0;
+          return;
+        case cache_type::lookup:
+          o->lookup();
+          break;
+        default:
+          break;
+        }
+      }
 
       // Pass operation back to main io_context for completion.
       o->scheduler_.post_deferred_completion(o);
@@ -114,13 +123,8 @@ public:
       // is required to ensure that any owning sub-object remains valid until
       // after we have deallocated the memory here.
       detail::binder2<Handler, asio::error_code, results_type>
-        handler(o->handler_, o->ec_, results_type());
+        handler(o->handler_, o->ec_, o->results_);
       p.h = asio::detail::addressof(handler.handler_);
-      if (o->addrinfo_)
-      {
-        handler.arg2_ = results_type::create(o->addrinfo_,
-            o->query_.host_name(), o->query_.service_name());
-      }
       p.reset();
 
       if (owner)
@@ -134,12 +138,37 @@ public:
   }
 
 private:
-  socket_ops::weak_cancel_token_type cancel_token_;
+  // Perform the blocking host resolution operation, and share the result
+  // with any identical operations that are waiting for it.
+  void lookup()
+  {
+    asio::detail::addrinfo_type* address_info = 0;
+    socket_ops::getaddrinfo(query_.host_name().c_str(),
+        query_.service_name().c_str(), query_.hints(),
+        &address_info, this->ec_);
+    if (address_info)
+    {
+      this->results_ = results_type::create(address_info,
+          query_.host_name(), query_.service_name());
+      socket_ops::freeaddrinfo(address_info);
+    }
+
+    op_queue<operation> ops;
+    cache_.complete(query_, this->ec_, this->results_, ops);
+    scheduler_.post_deferred_completions(ops);
+
+    if (this->cancel_token_.expired())
+    {
+      this->ec_ = asio::error::operation_aborted;
+      this->results_ = results_type();
+    }
+  }
+
   query_type query_;
   scheduler_impl& scheduler_;
+  cache_type& cache_;
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
-  asio::detail::addrinfo_type* addrinfo_;
 };
 
 } // namespace detail
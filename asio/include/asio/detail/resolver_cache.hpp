@@ -0,0 +1,292 @@
+//
+// detail/resolver_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_RESOLVER_CACHE_HPP
+#define ASIO_DETAIL_RESOLVER_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if !defined(ASIO_WINDOWS_RUNTIME)
+
+#include <map>
+#include <string>
+#include <vector>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/resolve_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/error.hpp"
+#include "asio/ip/basic_resolver_query.hpp"
+#include "asio/ip/basic_resolver_results.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Base class for query operations, allowing the result of a single lookup to
+// be delivered to every operation that is waiting for it.
+template <typename Protocol>
+class resolve_query_op_base : public resolve_op
+{
+public:
+  // The results to be passed to the completion handler.
+  asio::ip::basic_resolver_results<Protocol> results_;
+
+  // The token used to determine whether the operation has been cancelled.
+  socket_ops::weak_cancel_token_type cancel_token_;
+
+protected:
+  resolve_query_op_base(func_type complete_func,
+      socket_ops::weak_cancel_token_type cancel_token)
+    : resolve_op(complete_func),
+      cancel_token_(cancel_token)
+  {
+  }
+};
+
+// Tracks the queries for which a lookup is in progress, so that identical
+// queries share a single lookup, and optionally keeps the results of
+// completed lookups for a limited time.
+template <typename Protocol>
+class resolver_cache
+  : private noncopyable
+{
+public:
+  typedef asio::ip::basic_resolver_query<Protocol> query_type;
+  typedef asio::ip::basic_resolver_results<Protocol> results_type;
+  typedef resolve_query_op_base<Protocol> op_type;
+
+  // The outcome of starting a query.
+  enum start_result
+  {
+    // The cached result has been stored in the operation.
+    cached,
+
+    // An identical lookup is already in progress. The operation will be
+    // returned by the call to complete() for that lookup.
+    joined,
+
+    // The caller must perform the lookup and then call complete().
+    lookup
+  };
+
+  // Constructor.
+  resolver_cache()
+    : positive_ttl_(0),
+      negative_ttl_(0)
+  {
+  }
+
+  // Set the time, in milliseconds, for which successful and unsuccessful
+  // results are kept. A zero time disables caching of those results.
+  void set_ttl(long positive_ttl, long negative_ttl)
+  {
+    mutex::scoped_lock lock(mutex_);
+    positive_ttl_ = positive_ttl > 0 ? positive_ttl : 0;
+    negative_ttl_ = negative_ttl > 0 ? negative_ttl : 0;
+
+    for (typename entry_map::iterator i = entries_.begin();
+        i != entries_.end();)
+    {
+      if (i->second.in_progress_)
+        ++i;
+      else
+        entries_.erase(i++);
+    }
+  }
+
+  // Start a query for the given operation.
+  start_result start(const query_type& query, op_type* op)
+  {
+    key k(query);
+
+    mutex::scoped_lock lock(mutex_);
+    typename entry_map::iterator i = entries_.find(k);
+    if (i == entries_.end())
+    {
+      if (entries_.size() >= max_entries)
+        purge_expired();
+      entries_[k].in_progress_ = true;
+      return lookup;
+    }
+
+    entry& e = i->second;
+    if (e.in_progress_)
+    {
+      e.waiters_.push_back(op);
+      return joined;
+    }
+
+#if defined(ASIO_HAS_CHRONO)
+    if (chrono::steady_clock::now() < e.expiry_)
+    {
+      op->ec_ = e.ec_;
+      op->results_ = e.results_;
+      return cached;
+    }
+#endif // defined(ASIO_HAS_CHRONO)
+
+    e.in_progress_ = true;
+    e.results_ = results_type();
+    return lookup;
+  }
+
+  // Record the result of a lookup, and return the operations that were
+  // waiting for it.
+  void complete(const query_type& query, const asio::error_code& ec,
+      const results_type& results, op_queue<operation>& ops)
+  {
+    key k(query);
+
+    mutex::scoped_lock lock(mutex_);
+    typename entry_map::iterator i = entries_.find(k);
+    if (i == entries_.end())
+      return;
+
+    entry& e = i->second;
+    for (std::size_t n = 0; n < e.waiters_.size(); ++n)
+    {
+      op_type* op = e.waiters_[n];
+      if (op->cancel_token_.expired())
+        op->ec_ = asio::error::operation_aborted;
+      else
+      {
+        op->ec_ = ec;
+        op->results_ = results;
+      }
+      ops.push(op);
+    }
+    e.waiters_.clear();
+
+    long ttl = !ec ? positive_ttl_ : (is_negative(ec) ? negative_ttl_ : 0);
+#if defined(ASIO_HAS_CHRONO)
+    if (ttl > 0 && entries_.size() <= max_entries)
+    {
+      e.in_progress_ = false;
+      e.ec_ = ec;
+      e.results_ = results;
+      e.expiry_ = chrono::steady_clock::now() + chrono::milliseconds(ttl);
+      return;
+    }
+#endif // defined(ASIO_HAS_CHRONO)
+
+    (void)ttl;
+    entries_.erase(i);
+  }
+
+private:
+  // The maximum number of queries that are tracked at once.
+  enum { max_entries = 1024 };
+
+  // Uniquely identifies a query.
+  struct key
+  {
+    explicit key(const query_type& query)
+      : host_name_(query.host_name()),
+        service_name_(query.service_name()),
+        flags_(query.hints().ai_flags),
+        family_(query.hints().ai_family),
+        socktype_(query.hints().ai_socktype),
+        protocol_(query.hints().ai_protocol)
+    {
+    }
+
+    friend bool operator<(const key& a, const key& b)
+    {
+      if (a.host_name_ != b.host_name_)
+        return a.host_name_ < b.host_name_;
+      if (a.service_name_ != b.service_name_)
+        return a.service_name_ < b.service_name_;
+      if (a.flags_ != b.flags_)
+        return a.flags_ < b.flags_;
+      if (a.family_ != b.family_)
+        return a.family_ < b.family_;
+      if (a.socktype_ != b.socktype_)
+        return a.socktype_ < b.socktype_;
+      return a.protocol_ < b.protocol_;
+    }
+
+    std::string host_name_;
+    std::string service_name_;
+    int flags_;
+    int family_;
+    int socktype_;
+    int protocol_;
+  };
+
+  // A query that is in progress or has a cached result.
+  struct entry
+  {
+    entry()
+      : in_progress_(false)
+    {
+    }
+
+    bool in_progress_;
+    std::vector<op_type*> waiters_;
+    asio::error_code ec_;
+    results_type results_;
+#if defined(ASIO_HAS_CHRONO)
+    chrono::steady_clock::time_point expiry_;
+#endif // defined(ASIO_HAS_CHRONO)
+  };
+
+  typedef std::map<key, entry> entry_map;
+
+  // Determine whether an error is a definitive answer that may be cached.
+  static bool is_negative(const asio::error_code& ec)
+  {
+    return ec == asio::error::host_not_found
+      || ec == asio::error::service_not_found
+      || ec == asio::error::no_data;
+  }
+
+  // Remove the cached results that have expired.
+  void purge_expired()
+  {
+#if defined(ASIO_HAS_CHRONO)
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    for (typename entry_map::iterator i = entries_.begin();
+        i != entries_.end();)
+    {
+      if (!i->second.in_progress_ && !(now < i->second.expiry_))
+        entries_.erase(i++);
+      else
+        ++i;
+    }
+#endif // defined(ASIO_HAS_CHRONO)
+  }
+
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // The times, in milliseconds, for which results are kept.
+  long positive_ttl_;
+  long negative_ttl_;
+
+  // The queries that are in progress or cached.
+  entry_map entries_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+
+#endif // ASIO_DETAIL_RESOLVER_CACHE_HPP
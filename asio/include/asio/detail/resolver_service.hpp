@@ -25,6 +25,7 @@
 #include "asio/detail/memory.hpp"
 #include "asio/detail/resolve_endpoint_op.hpp"
 #include "asio/detail/resolve_query_op.hpp"
+#include "asio/detail/resolver_cache.hpp"
 #include "asio/detail/resolver_service_base.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -70,6 +71,13 @@ public:
     this->base_notify_fork(fork_ev);
   }
 
+  // Set the times, in milliseconds, for which the results of asynchronous
+  // queries are cached.
+  void set_cache_durations(long positive_msec, long negative_msec)
+  {
+    cache_.set_ttl(positive_msec, negative_msec);
+  }
+
   // Resolve a query to a list of entries.
   results_type resolve(implementation_type&, const query_type& query,
       asio::error_code& ec)
@@ -93,7 +101,7 @@ public:
     typedef resolve_query_op<Protocol, Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
-    p.p = new (p.v) op(impl, query, scheduler_, handler, io_ex);
+    p.p = new (p.v) op(impl, query, scheduler_, cache_, handler, io_ex);
 
     ASIO_HANDLER_CREATION((scheduler_.context(),
           *p.p, "resolver", &impl, 0, "async_resolve"));
@@ -133,6 +141,10 @@ public:
     start_resolve_op(p.p);
     p.v = p.p = 0;
   }
+
+private:
+  // The queries that are in progress or cached.
+  resolver_cache<Protocol> cache_;
 };
 
 } // namespace detail
@@ -24,7 +24,7 @@
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/detail/scoped_ptr.hpp"
-#include "asio/detail/thread.hpp"
+#include "asio/detail/thread_group.hpp"
 
 #if defined(ASIO_HAS_IOCP)
 # include "asio/detail/win_iocp_io_context.hpp"
@@ -75,6 +75,9 @@ public:
   // Cancel pending asynchronous operations.
   ASIO_DECL void cancel(implementation_type& impl);
 
+  // Set the number of threads used to perform asynchronous operations.
+  ASIO_DECL void set_thread_count(std::size_t n);
+
 protected:
   // Helper function to start an asynchronous resolve operation.
   ASIO_DECL void start_resolve_op(resolve_op* op);
@@ -109,8 +112,8 @@ protected:
   // Helper class to run the work scheduler in a thread.
   class work_scheduler_runner;
 
-  // Start the work scheduler if it's not already running.
-  ASIO_DECL void start_work_thread();
+  // Start the work threads if they're not already running.
+  ASIO_DECL void start_work_threads();
 
   // The scheduler implementation used to post completions.
 #if defined(ASIO_HAS_IOCP)
@@ -127,8 +130,14 @@ private:
   // Private scheduler used for performing asynchronous host resolution.
   asio::detail::scoped_ptr<scheduler_impl> work_scheduler_;
 
-  // Thread used for running the work io_context's run loop.
-  asio::detail::scoped_ptr<asio::detail::thread> work_thread_;
+  // Threads used for running the work io_context's run loop.
+  asio::detail::thread_group work_threads_;
+
+  // The number of work threads that have been requested.
+  std::size_t work_thread_count_;
+
+  // The number of work threads that are running.
+  std::size_t running_work_threads_;
 };
 
 } // namespace detail
@@ -22,11 +22,22 @@
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/mpsc_op_queue.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/reactor_fwd.hpp"
+#include "asio/detail/reactor_statistics.hpp"
 #include "asio/detail/scheduler_operation.hpp"
 #include "asio/detail/thread.hpp"
 #include "asio/detail/thread_context.hpp"
+#include "asio/detail/work_stealing_queue.hpp"
+
+#if defined(ASIO_HAS_WORK_STEALING) \
+  || defined(ASIO_HAS_SCHEDULER_BATCHING) \
+  || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+# include <atomic>
+#endif // defined(ASIO_HAS_WORK_STEALING)
+       //   || defined(ASIO_HAS_SCHEDULER_BATCHING)
+       //   || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
 
 #include "asio/detail/push_options.hpp"
 
@@ -59,6 +70,11 @@ public:
   // Run the event loop until interrupted or no more work.
   ASIO_DECL std::size_t run(asio::error_code& ec);
 
+  // Run the event loop until interrupted or no more work. When work stealing
+  // is enabled, the calling thread steals from threads on the same node before
+  // those on other nodes.
+  ASIO_DECL std::size_t run(std::size_t node, asio::error_code& ec);
+
   // Run until interrupted or one operation is performed.
   ASIO_DECL std::size_t run_one(asio::error_code& ec);
 
@@ -133,6 +149,16 @@ public:
   // work_started() was previously called for the operations.
   ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
+  // Set the time, in microseconds, for which an idle thread in run() or
+  // run_one() polls for work before blocking.
+  ASIO_DECL void set_spin_duration(long usec);
+
+  // Set the maximum number of events collected by each reactor wait.
+  ASIO_DECL void set_reactor_batch_size(std::size_t max_events);
+
+  // Get the counters that describe the reactor's waits for events.
+  ASIO_DECL reactor_statistics get_reactor_statistics();
+
   // Get the concurrency hint that was used to initialise the scheduler.
   int concurrency_hint() const
   {
@@ -161,6 +187,32 @@ private:
   ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const asio::error_code& ec);
 
+#if defined(ASIO_HAS_SCHEDULER_BATCHING)
+  // Run a batch of up to batch_size_ operations, or the task. May block.
+  // Returns the number of operations run.
+  ASIO_DECL std::size_t do_run_batch(mutex::scoped_lock& lock,
+      thread_info& this_thread, const asio::error_code& ec);
+#endif // defined(ASIO_HAS_SCHEDULER_BATCHING)
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  // Run up to max_handlers operations without locking, for a scheduler that
+  // is run by a single thread. The task is run with the given timeout, in
+  // microseconds, at most once when there are no handlers to run, or as often
+  // as needed if the timeout is negative. The mutex must be held on entry, and
+  // is not held on return.
+  ASIO_DECL std::size_t do_run_single(mutex::scoped_lock& lock,
+      thread_info& this_thread, std::size_t max_handlers,
+      long usec, const asio::error_code& ec);
+
+  // Add the thread's private count of outstanding work to the shared count.
+  // Must only be called by the thread running a single-threaded scheduler.
+  ASIO_DECL void flush_private_work(thread_info& this_thread);
+
+  // Add operations posted from outside the running thread to the inbox, and
+  // wake the running thread if it is blocked in the task.
+  ASIO_DECL void post_to_inbox(op_queue<operation>& ops);
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
   // Stop the task and all idle threads.
   ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -168,6 +220,33 @@ private:
   ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+#if defined(ASIO_HAS_WORK_STEALING)
+  // Run at most one operation, preferring the thread's own work queue and
+  // stealing from other threads' queues when it is empty. The mutex must not
+  // be held on entry, and is not held on return. May block.
+  ASIO_DECL std::size_t do_run_one_stealing(mutex::scoped_lock& lock,
+      thread_info& this_thread, const asio::error_code& ec);
+
+  // Assign a work queue to the calling thread. The mutex must be held.
+  ASIO_DECL void acquire_work_queue(thread_info& this_thread);
+
+  // Move any operations left in the thread's work queue to the shared queue
+  // and return the work queue to the pool. The mutex must be held.
+  ASIO_DECL void release_work_queue(thread_info& this_thread);
+
+  // Add operations to the calling thread's work queue. Any operations that do
+  // not fit, or all of them if the calling thread has no work queue, are added
+  // to the shared queue instead.
+  ASIO_DECL void post_to_work_queue(op_queue<operation>& ops);
+
+  // Remove an operation from another thread's work queue, preferring threads
+  // on the same node.
+  ASIO_DECL operation* steal_work(thread_info& this_thread);
+
+  // Determine whether any thread's work queue has operations.
+  ASIO_DECL bool work_queues_empty() const;
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
   // Helper class to run the scheduler in its own thread.
   class thread_function;
   friend class thread_function;
@@ -180,6 +259,27 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to limit the time for which an idle thread polls for work.
+  class spin_wait;
+
+#if defined(ASIO_HAS_SCHEDULER_BATCHING)
+  // Helper class to finish a batch of operations on block exit.
+  struct batch_cleanup;
+  friend struct batch_cleanup;
+#endif // defined(ASIO_HAS_SCHEDULER_BATCHING)
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  // Helper class to restore a single-threaded scheduler's queue on block exit.
+  struct single_thread_cleanup;
+  friend struct single_thread_cleanup;
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
+#if defined(ASIO_HAS_WORK_STEALING)
+  // Helper class to release a thread's work queue on block exit.
+  struct work_queue_cleanup;
+  friend struct work_queue_cleanup;
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -218,6 +318,68 @@ private:
 
   // The thread that is running the scheduler.
   asio::detail::thread* thread_;
+
+  // The time, in microseconds, for which an idle thread polls for work before
+  // blocking. Protected by the mutex.
+  long spin_usec_;
+
+#if defined(ASIO_HAS_WORK_STEALING)
+  // Whether each thread running the scheduler has its own work queue.
+  const bool work_stealing_;
+
+  // The maximum number of per-thread work queues.
+  enum { max_work_queues = 256 };
+
+  // The number of operations a thread may take from its own work queue before
+  // it checks the shared queue, so that the task and handlers posted from
+  // outside the scheduler are not starved.
+  enum { work_queue_fairness_interval = 61 };
+
+  // The per-thread work queues. Queues are allocated on demand and are only
+  // destroyed with the scheduler, so other threads may always steal from them.
+  work_stealing_queue<operation>* work_queues_[max_work_queues];
+
+  // Whether each work queue is assigned to a thread. Protected by the mutex.
+  bool work_queue_in_use_[max_work_queues];
+
+  // The node of the thread to which each work queue was last assigned.
+  std::atomic<std::size_t> work_queue_node_[max_work_queues];
+
+  // The number of work queues that have been allocated.
+  std::atomic<std::size_t> num_work_queues_;
+
+  // The number of threads that are blocked waiting for work.
+  std::atomic<long> idle_threads_;
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
+#if defined(ASIO_HAS_SCHEDULER_BATCHING)
+  // The maximum number of operations taken from the queue at once by run().
+  const std::size_t batch_size_;
+#endif // defined(ASIO_HAS_SCHEDULER_BATCHING)
+
+#if defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  // Whether the scheduler is run by a single thread, which accesses the
+  // operation queue without holding the mutex.
+  const bool single_thread_;
+
+  // Operations posted from outside the thread running a single-threaded
+  // scheduler.
+  mpsc_op_queue<operation> inbox_;
+
+  // Whether the thread running a single-threaded scheduler may be blocked in
+  // the task, and so must be interrupted when operations are added to the
+  // inbox.
+  std::atomic<bool> task_sleeping_;
+#endif // defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+
+#if defined(ASIO_HAS_WORK_STEALING) \
+  || defined(ASIO_HAS_SCHEDULER_BATCHING) \
+  || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
+  // Mirrors the stopped_ flag so it may be checked without the mutex.
+  std::atomic<bool> atomic_stopped_;
+#endif // defined(ASIO_HAS_WORK_STEALING)
+       //   || defined(ASIO_HAS_SCHEDULER_BATCHING)
+       //   || defined(ASIO_HAS_SINGLE_THREADED_SCHEDULER)
 };
 
 } // namespace detail
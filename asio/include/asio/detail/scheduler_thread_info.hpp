@@ -17,6 +17,7 @@
 
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/thread_info_base.hpp"
+#include "asio/detail/work_stealing_queue.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -30,6 +31,21 @@ struct scheduler_thread_info : public thread_info_base
 {
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+
+#if defined(ASIO_HAS_WORK_STEALING)
+  scheduler_thread_info()
+    : work_queue(0),
+      work_queue_index(0),
+      work_queue_ticks(0),
+      node(0)
+  {
+  }
+
+  work_stealing_queue<scheduler_operation>* work_queue;
+  std::size_t work_queue_index;
+  std::size_t work_queue_ticks;
+  std::size_t node;
+#endif // defined(ASIO_HAS_WORK_STEALING)
 };
 
 } // namespace detail
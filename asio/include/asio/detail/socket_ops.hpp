@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/error_code.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/socket_types.hpp"
 
@@ -285,6 +286,109 @@ ASIO_DECL bool non_blocking_sendto1(socket_type s,
 
 #endif // !defined(ASIO_HAS_IOCP)
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+ASIO_DECL void init_mmsghdr(mmsghdr_type& msg, buf* b,
+    const socket_addr_type* addr, std::size_t addrlen);
+
+ASIO_DECL signed_size_type recvmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL size_t sync_recvmmsg(socket_type s, state_type state,
+    mmsghdr_type* msgs, size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    mmsghdr_type* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred);
+
+ASIO_DECL signed_size_type sendmmsg(socket_type s, mmsghdr_type* msgs,
+    size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL size_t sync_sendmmsg(socket_type s, state_type state,
+    mmsghdr_type* msgs, size_t count, int flags, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    mmsghdr_type* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& msgs_transferred);
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+ASIO_DECL signed_size_type recvfrom_segmented(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, std::size_t* segment_size, asio::error_code& ec);
+
+ASIO_DECL size_t sync_recvfrom_segmented(socket_type s, state_type state,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, std::size_t* segment_size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_recvfrom_segmented(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, std::size_t* segment_size,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+ASIO_DECL signed_size_type sendto_segmented(socket_type s,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec);
+
+ASIO_DECL size_t sync_sendto_segmented(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendto_segmented(socket_type s,
+    const buf* bufs, size_t count, int flags, const socket_addr_type* addr,
+    std::size_t addrlen, std::size_t segment_size,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+// Read the next zero-copy completion notification from the socket's error
+// queue. Returns false if there are no more notifications to be read.
+ASIO_DECL bool recv_zerocopy_notification(socket_type s,
+    uint32_t& first, uint32_t& last, asio::error_code& ec);
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+ASIO_DECL signed_size_type sendfile(socket_type s, int file,
+    uint64_t offset, size_t size, asio::error_code& ec);
+
+ASIO_DECL size_t sync_sendfile(socket_type s, state_type state, int file,
+    uint64_t offset, size_t size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendfile(socket_type s, int file,
+    uint64_t offset, size_t size, asio::error_code& ec,
+    size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#if defined(ASIO_HAS_SPLICE)
+
+ASIO_DECL signed_size_type splice(int in, int out,
+    size_t size, asio::error_code& ec);
+
+// Move data from the socket into a pipe.
+ASIO_DECL size_t sync_splice_to(socket_type s, state_type state,
+    int pipe, size_t size, asio::error_code& ec);
+
+// Move data from a pipe into the socket.
+ASIO_DECL size_t sync_splice_from(socket_type s, state_type state,
+    int pipe, size_t size, asio::error_code& ec);
+
+// The non-blocking operations fail with would_block if the pipe, rather than
+// the socket, is not ready.
+ASIO_DECL bool non_blocking_splice_to(socket_type s,
+    int pipe, size_t size, asio::error_code& ec, size_t& bytes_transferred);
+
+ASIO_DECL bool non_blocking_splice_from(socket_type s,
+    int pipe, size_t size, asio::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_SPLICE)
+
 ASIO_DECL socket_type socket(int af, int type, int protocol,
     asio::error_code& ec);
 
@@ -81,6 +81,15 @@
 # if !defined(__SYMBIAN32__)
 #  include <netinet/tcp.h>
 # endif
+# if defined(ASIO_HAS_UDP_GSO)
+#  include <netinet/udp.h>
+# endif // defined(ASIO_HAS_UDP_GSO)
+# if defined(ASIO_HAS_MSG_ZEROCOPY)
+#  include <linux/errqueue.h>
+# endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+# if defined(ASIO_HAS_SENDFILE)
+#  include <sys/sendfile.h>
+# endif // defined(ASIO_HAS_SENDFILE)
 # include <arpa/inet.h>
 # include <netdb.h>
 # include <net/if.h>
@@ -314,6 +323,15 @@ typedef sockaddr_storage sockaddr_storage_type;
 typedef sockaddr_un sockaddr_un_type;
 typedef addrinfo addrinfo_type;
 typedef ::linger linger_type;
+# if defined(ASIO_HAS_MMSG)
+typedef mmsghdr mmsghdr_type;
+# else // defined(ASIO_HAS_MMSG)
+struct mmsghdr_type
+{
+  msghdr msg_hdr;
+  unsigned int msg_len;
+};
+# endif // defined(ASIO_HAS_MMSG)
 typedef int ioctl_arg_type;
 typedef uint32_t u_long_type;
 typedef uint16_t u_short_type;
@@ -360,6 +378,48 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_SO_RCVLOWAT SO_RCVLOWAT
 # define ASIO_OS_DEF_SO_REUSEADDR SO_REUSEADDR
 # define ASIO_OS_DEF_TCP_NODELAY TCP_NODELAY
+# if defined(ASIO_HAS_UDP_GSO)
+// Older C library headers may not define the UDP offload options, even when
+// the kernel supports them.
+#  if defined(UDP_SEGMENT)
+#   define ASIO_OS_DEF_UDP_SEGMENT UDP_SEGMENT
+#  else // defined(UDP_SEGMENT)
+#   define ASIO_OS_DEF_UDP_SEGMENT 103
+#  endif // defined(UDP_SEGMENT)
+#  if defined(UDP_GRO)
+#   define ASIO_OS_DEF_UDP_GRO UDP_GRO
+#  else // defined(UDP_GRO)
+#   define ASIO_OS_DEF_UDP_GRO 104
+#  endif // defined(UDP_GRO)
+# endif // defined(ASIO_HAS_UDP_GSO)
+# if defined(ASIO_HAS_MSG_ZEROCOPY)
+// Older C library and kernel headers may not define the zero-copy constants,
+// even when the kernel supports them.
+#  if defined(SO_ZEROCOPY)
+#   define ASIO_OS_DEF_SO_ZEROCOPY SO_ZEROCOPY
+#  else // defined(SO_ZEROCOPY)
+#   define ASIO_OS_DEF_SO_ZEROCOPY 60
+#  endif // defined(SO_ZEROCOPY)
+#  if defined(MSG_ZEROCOPY)
+#   define ASIO_OS_DEF_MSG_ZEROCOPY MSG_ZEROCOPY
+#  else // defined(MSG_ZEROCOPY)
+#   define ASIO_OS_DEF_MSG_ZEROCOPY 0x4000000
+#  endif // defined(MSG_ZEROCOPY)
+#  if defined(SO_EE_ORIGIN_ZEROCOPY)
+#   define ASIO_OS_DEF_SO_EE_ORIGIN_ZEROCOPY SO_EE_ORIGIN_ZEROCOPY
+#  else // defined(SO_EE_ORIGIN_ZEROCOPY)
+#   define ASIO_OS_DEF_SO_EE_ORIGIN_ZEROCOPY 5
+#  endif // defined(SO_EE_ORIGIN_ZEROCOPY)
+# endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+# if defined(ASIO_HAS_SO_BUSY_POLL)
+// Older C library headers may not define the busy polling option, even when
+// the kernel supports it.
+#  if defined(SO_BUSY_POLL)
+#   define ASIO_OS_DEF_SO_BUSY_POLL SO_BUSY_POLL
+#  else // defined(SO_BUSY_POLL)
+#   define ASIO_OS_DEF_SO_BUSY_POLL 46
+#  endif // defined(SO_BUSY_POLL)
+# endif // defined(ASIO_HAS_SO_BUSY_POLL)
 # define ASIO_OS_DEF_IP_MULTICAST_IF IP_MULTICAST_IF
 # define ASIO_OS_DEF_IP_MULTICAST_TTL IP_MULTICAST_TTL
 # define ASIO_OS_DEF_IP_MULTICAST_LOOP IP_MULTICAST_LOOP
@@ -0,0 +1,103 @@
+//
+// detail/splice_pipe.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SPLICE_PIPE_HPP
+#define ASIO_DETAIL_SPLICE_PIPE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+#include <cerrno>
+#include <cstddef>
+#include <unistd.h>
+#include <fcntl.h>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The intermediate pipe used to splice data from one socket to another.
+class splice_pipe
+  : private noncopyable
+{
+public:
+  // The number of bytes that a pipe holds by default.
+  enum { default_capacity = 65536 };
+
+  splice_pipe()
+    : read_descriptor_(-1),
+      write_descriptor_(-1)
+  {
+  }
+
+  ~splice_pipe()
+  {
+    if (read_descriptor_ != -1)
+      ::close(read_descriptor_);
+    if (write_descriptor_ != -1)
+      ::close(write_descriptor_);
+  }
+
+  // Create the pipe, if it has not already been created.
+  bool open(asio::error_code& ec)
+  {
+    if (read_descriptor_ == -1)
+    {
+      int pipe_fds[2];
+      if (::pipe2(pipe_fds, O_CLOEXEC | O_NONBLOCK) != 0)
+      {
+        ec = asio::error_code(errno,
+            asio::error::get_system_category());
+        return false;
+      }
+      read_descriptor_ = pipe_fds[0];
+      write_descriptor_ = pipe_fds[1];
+    }
+    return true;
+  }
+
+  // Limit a transfer size to what the pipe holds by default.
+  static std::size_t clamp_size(std::size_t size)
+  {
+    return size < static_cast<std::size_t>(default_capacity)
+      ? size : static_cast<std::size_t>(default_capacity);
+  }
+
+  int read_descriptor() const
+  {
+    return read_descriptor_;
+  }
+
+  int write_descriptor() const
+  {
+    return write_descriptor_;
+  }
+
+private:
+  int read_descriptor_;
+  int write_descriptor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+#endif // ASIO_DETAIL_SPLICE_PIPE_HPP
@@ -21,6 +21,10 @@
 #include "asio/detail/memory.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
+#if defined(ASIO_HAS_LOCK_FREE_STRAND)
+# include <atomic>
+# include "asio/detail/mpsc_op_queue.hpp"
+#endif // defined(ASIO_HAS_LOCK_FREE_STRAND)
 #include "asio/detail/scheduler_operation.hpp"
 #include "asio/detail/scoped_ptr.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -46,6 +50,23 @@ public:
   private:
     friend class strand_executor_service;
 
+#if defined(ASIO_HAS_LOCK_FREE_STRAND)
+    // Indicates whether the strand is currently "locked" by a handler. This
+    // means that there is a handler upcall in progress, or that the strand
+    // itself has been scheduled in order to invoke some pending handlers. The
+    // thread that changes this from false to true is responsible for
+    // scheduling the strand.
+    std::atomic<bool> locked_;
+
+    // Indicates that the strand has been shut down and will accept no further
+    // handlers.
+    std::atomic<bool> shutdown_;
+
+    // The handlers that are waiting on the strand but should not be run until
+    // after the next time the strand is scheduled. Any thread may add to this
+    // queue, but handlers are removed only by the holder of the strand lock.
+    mpsc_op_queue<scheduler_operation> waiting_queue_;
+#else // defined(ASIO_HAS_LOCK_FREE_STRAND)
     // Mutex to protect access to internal data.
     mutex* mutex_;
 
@@ -62,6 +83,7 @@ public:
     // after the next time the strand is scheduled. This queue must only be
     // modified while the mutex is locked.
     op_queue<scheduler_operation> waiting_queue_;
+#endif // defined(ASIO_HAS_LOCK_FREE_STRAND)
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
@@ -131,6 +153,11 @@ private:
   ASIO_DECL static bool enqueue(const implementation_type& impl,
       scheduler_operation* op);
 
+  // Transfers waiting handlers to the ready queue. Returns true if one or more
+  // handlers were transferred, in which case the strand remains locked and
+  // must be scheduled again.
+  ASIO_DECL static bool push_waiting_to_ready(implementation_type& impl);
+
   // Helper function to request invocation of the given function.
   template <typename Executor, typename Function, typename Allocator>
   static void do_execute(const implementation_type& impl, Executor& ex,
@@ -139,6 +166,7 @@ private:
   // Mutex to protect access to the service-wide state.
   mutex mutex_;
 
+#if !defined(ASIO_HAS_LOCK_FREE_STRAND)
   // Number of mutexes shared between all strand objects.
   enum { num_mutexes = 193 };
 
@@ -148,6 +176,7 @@ private:
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same mutex.
   std::size_t salt_;
+#endif // !defined(ASIO_HAS_LOCK_FREE_STRAND)
 
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
@@ -0,0 +1,53 @@
+//
+// detail/thread_affinity.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_AFFINITY_HPP
+#define ASIO_DETAIL_THREAD_AFFINITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <vector>
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+namespace thread_affinity {
+
+// Obtain the processors of each NUMA node that the calling thread may use, in
+// order of node number. Nodes without any such processors are omitted. If the
+// nodes cannot be determined, a single node holds all the processors that the
+// thread may use. The result is empty if those cannot be determined either.
+ASIO_DECL void numa_nodes(std::vector<std::vector<int> >& nodes);
+
+// Parse a list of processor numbers in the form used by Linux, such as
+// "0-3,8,10-11", adding them to the given vector.
+ASIO_DECL void parse_cpu_list(const char* list, std::vector<int>& cpus);
+
+// Restrict the calling thread to the given processors.
+ASIO_DECL asio::error_code pin_current_thread(
+    const std::vector<int>& cpus, asio::error_code& ec);
+
+} // namespace thread_affinity
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/thread_affinity.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_THREAD_AFFINITY_HPP
@@ -16,7 +16,6 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
-#include <climits>
 #include <cstddef>
 #include "asio/detail/noncopyable.hpp"
 
@@ -52,20 +51,26 @@ public:
   };
 
   thread_info_base()
+    : heap_allocations_(0),
+      recycled_allocations_(0),
+      cached_bytes_(0)
 #if defined(ASIO_HAS_STD_EXCEPTION_PTR) \
   && !defined(ASIO_NO_EXCEPTIONS)
-    : has_pending_exception_(0)
+    , has_pending_exception_(0)
 #endif // defined(ASIO_HAS_STD_EXCEPTION_PTR)
        // && !defined(ASIO_NO_EXCEPTIONS)
   {
     for (int i = 0; i < max_mem_index; ++i)
-      reusable_memory_[i] = 0;
+      for (int j = 0; j < size_classes; ++j)
+        reusable_count_[i][j] = 0;
   }
 
   ~thread_info_base()
   {
     for (int i = 0; i < max_mem_index; ++i)
-      ::operator delete(reusable_memory_[i]);
+      for (int j = 0; j < size_classes; ++j)
+        for (int k = 0; k < reusable_count_[i][j]; ++k)
+          ::operator delete(reusable_memory_[i][j][k]);
   }
 
   static void* allocate(thread_info_base* this_thread, std::size_t size)
@@ -79,44 +84,49 @@ public:
     deallocate(default_tag(), this_thread, pointer, size);
   }
 
+  // Blocks are cached in a small number of slots for each power-of-two size
+  // class. A block is always allocated with the full capacity of its class so
+  // that it may be recycled by any thread that frees it.
   template <typename Purpose>
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size)
   {
-    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    int size_class = size_class_of(size);
 
-    if (this_thread && this_thread->reusable_memory_[Purpose::mem_index])
+    if (this_thread && size_class >= 0)
     {
-      void* const pointer = this_thread->reusable_memory_[Purpose::mem_index];
-      this_thread->reusable_memory_[Purpose::mem_index] = 0;
-
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= chunks)
+      int& count = this_thread->reusable_count_[Purpose::mem_index][size_class];
+      if (count > 0)
       {
-        mem[size] = mem[0];
-        return pointer;
+        ++this_thread->recycled_allocations_;
+        this_thread->cached_bytes_ -= capacity_of(size_class);
+        return this_thread->reusable_memory_[
+          Purpose::mem_index][size_class][--count];
       }
-
-      ::operator delete(pointer);
     }
 
-    void* const pointer = ::operator new(chunks * chunk_size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
-    return pointer;
+    if (this_thread)
+      ++this_thread->heap_allocations_;
+
+    return ::operator new(size_class >= 0 ? capacity_of(size_class) : size);
   }
 
   template <typename Purpose>
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= chunk_size * UCHAR_MAX)
+    int size_class = size_class_of(size);
+
+    if (this_thread && size_class >= 0)
     {
-      if (this_thread && this_thread->reusable_memory_[Purpose::mem_index] == 0)
+      int& count = this_thread->reusable_count_[Purpose::mem_index][size_class];
+      std::size_t capacity = capacity_of(size_class);
+      if (count < slots_per_class
+          && this_thread->cached_bytes_ + capacity <= max_cached_bytes)
       {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_[Purpose::mem_index] = pointer;
+        this_thread->cached_bytes_ += capacity;
+        this_thread->reusable_memory_[
+          Purpose::mem_index][size_class][count++] = pointer;
         return;
       }
     }
@@ -124,6 +134,20 @@ public:
     ::operator delete(pointer);
   }
 
+  // The number of allocations made by this thread that were satisfied from
+  // the heap.
+  std::size_t heap_allocations() const
+  {
+    return heap_allocations_;
+  }
+
+  // The number of allocations made by this thread that were satisfied by
+  // recycling a cached block.
+  std::size_t recycled_allocations() const
+  {
+    return recycled_allocations_;
+  }
+
   void capture_current_exception()
   {
 #if defined(ASIO_HAS_STD_EXCEPTION_PTR) \
@@ -163,9 +187,32 @@ public:
   }
 
 private:
-  enum { chunk_size = 4 };
+  enum { min_block_size = 16 };
+  enum { size_classes = 7 };
+  enum { slots_per_class = 4 };
+  enum { max_cached_bytes = 16384 };
   enum { max_mem_index = 3 };
-  void* reusable_memory_[max_mem_index];
+
+  // Returns the size class for a block, or -1 if it is too large to cache.
+  static int size_class_of(std::size_t size)
+  {
+    int size_class = 0;
+    for (std::size_t c = min_block_size; c < size; c <<= 1)
+      if (++size_class == size_classes)
+        return -1;
+    return size_class;
+  }
+
+  static std::size_t capacity_of(int size_class)
+  {
+    return static_cast<std::size_t>(min_block_size) << size_class;
+  }
+
+  void* reusable_memory_[max_mem_index][size_classes][slots_per_class];
+  int reusable_count_[max_mem_index][size_classes];
+  std::size_t heap_allocations_;
+  std::size_t recycled_allocations_;
+  std::size_t cached_bytes_;
 
 #if defined(ASIO_HAS_STD_EXCEPTION_PTR) \
   && !defined(ASIO_NO_EXCEPTIONS)
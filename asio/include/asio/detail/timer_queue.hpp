@@ -23,6 +23,7 @@
 #include "asio/detail/limits.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/timer_wheel_resolution.hpp"
 #include "asio/detail/wait_op.hpp"
 #include "asio/error.hpp"
 
@@ -31,6 +32,11 @@
 namespace asio {
 namespace detail {
 
+// Timers are normally held in a binary heap. If the traits class supplies a
+// non-zero timer_wheel_resolution(), a hierarchical timing wheel is used
+// instead, so that timers may be added and removed in constant time. Wheel
+// timers fire on the first tick at or after their expiry time, and so may be
+// late by up to the resolution.
 template <typename Time_Traits>
 class timer_queue
   : public timer_queue_base
@@ -58,10 +64,15 @@ public:
     // The operations waiting on the timer.
     op_queue<wait_op> op_queue_;
 
-    // The index of the timer in the heap.
+    // The index of the timer in the heap, or of its slot in the timing wheel.
     std::size_t heap_index_;
 
-    // Pointers to adjacent timers in a linked list.
+    // The time when the timer expires. The timer's heap entry or wheel slot
+    // may correspond to an earlier time if the timer has been rescheduled.
+    time_type expiry_;
+
+    // Pointers to adjacent timers in a linked list. When a timing wheel is
+    // used, this is the list of timers in the same slot.
     per_timer_data* next_;
     per_timer_data* prev_;
   };
@@ -69,8 +80,32 @@ public:
   // Constructor.
   timer_queue()
     : timers_(),
-      heap_()
+      heap_(),
+      wheel_(0)
   {
+    duration_type resolution =
+      timer_wheel_resolution<Time_Traits, duration_type>::get();
+    int64_t resolution_usec =
+      Time_Traits::to_posix_duration(resolution).total_microseconds();
+    if (resolution_usec > 0)
+    {
+      wheel_ = new timer_wheel;
+      for (std::size_t i = 0; i < wheel_num_slots; ++i)
+        wheel_->slots_[i] = 0;
+      for (std::size_t i = 0; i < wheel_root_size / 64; ++i)
+        wheel_->bits_[i] = 0;
+      wheel_->tick_ = 0;
+      wheel_->tick_time_ = Time_Traits::now();
+      wheel_->resolution_ = resolution;
+      wheel_->resolution_usec_ = resolution_usec;
+      wheel_->size_ = 0;
+    }
+  }
+
+  // Destructor.
+  ~timer_queue()
+  {
+    delete wheel_;
   }
 
   // Add a new timer to the queue. Returns true if this is the timer that is
@@ -78,9 +113,13 @@ public:
   // function call may need to be interrupted and restarted.
   bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
   {
+    if (wheel_)
+      return wheel_enqueue_timer(time, timer, op);
+
     // Enqueue the timer object.
     if (timer.prev_ == 0 && &timer != timers_)
     {
+      timer.expiry_ = time;
       if (this->is_positive_infinity(time))
       {
         // No heap entry is required for timers that never expire.
@@ -114,12 +153,25 @@ public:
   // Whether there are no timers in the queue.
   virtual bool empty() const
   {
+    if (wheel_)
+      return wheel_->size_ == 0 && wheel_->slots_[wheel_never_slot] == 0;
     return timers_ == 0;
   }
 
   // Get the time for the timer that is earliest in the queue.
   virtual long wait_duration_msec(long max_duration) const
   {
+    if (wheel_)
+    {
+      if (wheel_->size_ == 0)
+        return max_duration;
+
+      return this->to_msec(
+          Time_Traits::to_posix_duration(
+            Time_Traits::subtract(wheel_next_time(), Time_Traits::now())),
+          max_duration);
+    }
+
     if (heap_.empty())
       return max_duration;
 
@@ -132,6 +184,17 @@ public:
   // Get the time for the timer that is earliest in the queue.
   virtual long wait_duration_usec(long max_duration) const
   {
+    if (wheel_)
+    {
+      if (wheel_->size_ == 0)
+        return max_duration;
+
+      return this->to_usec(
+          Time_Traits::to_posix_duration(
+            Time_Traits::subtract(wheel_next_time(), Time_Traits::now())),
+          max_duration);
+    }
+
     if (heap_.empty())
       return max_duration;
 
@@ -144,12 +207,21 @@ public:
   // Dequeue all timers not later than the current time.
   virtual void get_ready_timers(op_queue<operation>& ops)
   {
-    if (!heap_.empty())
+    if (wheel_)
+      wheel_get_ready_timers(ops);
+    else if (!heap_.empty())
     {
       const time_type now = Time_Traits::now();
       while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
       {
         per_timer_data* timer = heap_[0].timer_;
+        if (Time_Traits::less_than(now, timer->expiry_))
+        {
+          // The timer has been rescheduled to expire later.
+          heap_[0].time_ = timer->expiry_;
+          down_heap(0);
+          continue;
+        }
         ops.push(timer->op_queue_);
         remove_timer(*timer);
       }
@@ -159,6 +231,24 @@ public:
   // Dequeue all timers.
   virtual void get_all_timers(op_queue<operation>& ops)
   {
+    if (wheel_)
+    {
+      for (std::size_t i = 0; i < wheel_num_slots; ++i)
+      {
+        while (per_timer_data* timer = wheel_->slots_[i])
+        {
+          wheel_->slots_[i] = timer->next_;
+          ops.push(timer->op_queue_);
+          timer->heap_index_ = (std::numeric_limits<std::size_t>::max)();
+          timer->next_ = 0;
+          timer->prev_ = 0;
+        }
+      }
+      for (std::size_t i = 0; i < wheel_root_size / 64; ++i)
+        wheel_->bits_[i] = 0;
+      wheel_->size_ = 0;
+    }
+
     while (timers_)
     {
       per_timer_data* timer = timers_;
@@ -176,7 +266,8 @@ public:
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
   {
     std::size_t num_cancelled = 0;
-    if (timer.prev_ != 0 || &timer == timers_)
+    if (wheel_ ? timer.heap_index_ != (std::numeric_limits<std::size_t>::max)()
+        : (timer.prev_ != 0 || &timer == timers_))
     {
       while (wait_op* op = (num_cancelled != max_cancelled)
           ? timer.op_queue_.front() : 0)
@@ -192,6 +283,61 @@ public:
     return num_cancelled;
   }
 
+  // Change the expiry time of a timer without dequeuing its operations.
+  // Returns true if the timer is now the earliest in the queue, in which case
+  // the reactor's event demultiplexing function call may need to be
+  // interrupted and restarted. A timer that is moved to a later time is left
+  // where it is, and repositioned only when its old expiry time is reached.
+  bool reschedule_timer(const time_type& time, per_timer_data& timer)
+  {
+    if (wheel_ ? timer.heap_index_ == (std::numeric_limits<std::size_t>::max)()
+        : (timer.prev_ == 0 && &timer != timers_))
+      return false;
+
+    if (this->is_positive_infinity(time)
+        || this->is_positive_infinity(timer.expiry_))
+    {
+      // Timers that never expire are held apart from the others, so the timer
+      // must be dequeued and then enqueued again. A timer that never expired
+      // has no heap entry to free, so space for the new entry is reserved
+      // first to ensure that the enqueue cannot throw after the removal.
+      if (!wheel_)
+        heap_.reserve(heap_.size() + 1);
+      op_queue<wait_op> ops;
+      ops.push(timer.op_queue_);
+      remove_timer(timer);
+      bool earliest = false;
+      while (wait_op* op = ops.front())
+      {
+        ops.pop();
+        if (enqueue_timer(time, timer, op))
+          earliest = true;
+      }
+      return earliest;
+    }
+
+    bool later = Time_Traits::less_than(timer.expiry_, time);
+    timer.expiry_ = time;
+    if (later)
+      return false;
+
+    if (wheel_)
+    {
+      uint64_t next_tick = wheel_next_tick();
+      wheel_unlink(timer);
+      return wheel_insert(timer, 0) < next_tick;
+    }
+
+    // The heap entry's time may already be earlier than the new expiry time if
+    // the timer was previously moved to a later time.
+    std::size_t index = timer.heap_index_;
+    if (!Time_Traits::less_than(time, heap_[index].time_))
+      return false;
+    heap_[index].time_ = time;
+    up_heap(index);
+    return timer.heap_index_ == 0;
+  }
+
   // Move operations from one timer to another, empty timer.
   void move_timer(per_timer_data& target, per_timer_data& source)
   {
@@ -199,8 +345,15 @@ public:
 
     target.heap_index_ = source.heap_index_;
     source.heap_index_ = (std::numeric_limits<std::size_t>::max)();
+    target.expiry_ = source.expiry_;
 
-    if (target.heap_index_ < heap_.size())
+    if (wheel_)
+    {
+      if (target.heap_index_ < wheel_num_slots
+          && wheel_->slots_[target.heap_index_] == &source)
+        wheel_->slots_[target.heap_index_] = &target;
+    }
+    else if (target.heap_index_ < heap_.size())
       heap_[target.heap_index_].timer_ = &target;
 
     if (timers_ == &source)
@@ -260,6 +413,12 @@ private:
   // Remove a timer from the heap and list of timers.
   void remove_timer(per_timer_data& timer)
   {
+    if (wheel_)
+    {
+      wheel_unlink(timer);
+      return;
+    }
+
     // Remove the timer from the heap.
     std::size_t index = timer.heap_index_;
     if (!heap_.empty() && index < heap_.size())
@@ -293,6 +452,258 @@ private:
     timer.prev_ = 0;
   }
 
+  // Add a new timer to the timing wheel.
+  bool wheel_enqueue_timer(const time_type& time,
+      per_timer_data& timer, wait_op* op)
+  {
+    bool earliest = false;
+    if (timer.heap_index_ == (std::numeric_limits<std::size_t>::max)())
+    {
+      timer.expiry_ = time;
+      if (this->is_positive_infinity(time))
+      {
+        // Timers that never expire are kept apart from the wheel's slots.
+        wheel_link(timer, wheel_never_slot);
+      }
+      else
+      {
+        // The wheel does not advance while it is empty, so bring it up to
+        // date before it is used to measure the new timer's expiry.
+        if (wheel_->size_ == 0)
+          wheel_->tick_time_ = Time_Traits::now();
+
+        uint64_t next_tick = wheel_next_tick();
+        earliest = wheel_insert(timer, 0) < next_tick;
+      }
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer is due before the next tick
+    // for which the reactor is waiting.
+    return earliest && timer.op_queue_.front() == op;
+  }
+
+  // Dequeue all timers in the wheel not later than the current time.
+  void wheel_get_ready_timers(op_queue<operation>& ops)
+  {
+    const time_type now = Time_Traits::now();
+    while (wheel_->size_ > 0)
+    {
+      // Find the next tick that has timers, or at which the upper levels must
+      // be cascaded, and stop if it lies in the future.
+      std::size_t index = static_cast<std::size_t>(
+          wheel_->tick_ & (wheel_root_size - 1));
+      std::size_t slot = wheel_find_slot(index);
+      time_type slot_time = Time_Traits::add(wheel_->tick_time_,
+          wheel_->resolution_ * static_cast<int>(slot - index));
+      if (Time_Traits::less_than(now, slot_time))
+        break;
+
+      wheel_->tick_ += slot - index;
+      wheel_->tick_time_ = slot_time;
+      if (slot == wheel_root_size)
+      {
+        wheel_cascade();
+        continue;
+      }
+
+      // Detach the slot's timers and dispatch those that have expired. Any
+      // timer that is not yet due is moved to a later tick.
+      per_timer_data* timer = wheel_->slots_[slot];
+      wheel_->slots_[slot] = 0;
+      wheel_->bits_[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+      while (timer)
+      {
+        per_timer_data* next = timer->next_;
+        --wheel_->size_;
+        timer->heap_index_ = (std::numeric_limits<std::size_t>::max)();
+        timer->next_ = 0;
+        timer->prev_ = 0;
+        if (Time_Traits::less_than(now, timer->expiry_))
+          wheel_insert(*timer, 1);
+        else
+          ops.push(timer->op_queue_);
+        timer = next;
+      }
+
+      ++wheel_->tick_;
+      wheel_->tick_time_ = Time_Traits::add(
+          wheel_->tick_time_, wheel_->resolution_);
+      if ((wheel_->tick_ & (wheel_root_size - 1)) == 0)
+        wheel_cascade();
+    }
+  }
+
+  // Redistribute the timers from the upper level slots that correspond to
+  // the current tick. Must be called when the current tick is a multiple of
+  // the root level's size.
+  void wheel_cascade()
+  {
+    for (std::size_t level = 0; level < wheel_levels; ++level)
+    {
+      std::size_t index = static_cast<std::size_t>(
+          (wheel_->tick_ >> (wheel_root_bits + level * wheel_level_bits))
+            & (wheel_level_size - 1));
+      std::size_t slot = wheel_root_size + level * wheel_level_size + index;
+      per_timer_data* timer = wheel_->slots_[slot];
+      wheel_->slots_[slot] = 0;
+      while (timer)
+      {
+        per_timer_data* next = timer->next_;
+        --wheel_->size_;
+        timer->next_ = 0;
+        timer->prev_ = 0;
+        wheel_insert(*timer, 0);
+        timer = next;
+      }
+      if (index != 0)
+        break;
+    }
+  }
+
+  // Insert a timer into the slot for the first tick at or after its expiry
+  // time, and no earlier than the given number of ticks after the current
+  // tick. Returns the tick.
+  uint64_t wheel_insert(per_timer_data& timer, uint64_t min_delta)
+  {
+    const uint64_t max_delta =
+      (uint64_t(wheel_level_size) << (wheel_root_bits
+            + (wheel_levels - 1) * wheel_level_bits)) - 1;
+
+    uint64_t delta = min_delta;
+    if (Time_Traits::less_than(wheel_->tick_time_, timer.expiry_))
+    {
+      int64_t usec = Time_Traits::to_posix_duration(
+          Time_Traits::subtract(timer.expiry_, wheel_->tick_time_)
+          ).total_microseconds();
+      uint64_t ticks = max_delta;
+      if (usec >= 0)
+      {
+        ticks = static_cast<uint64_t>(usec / wheel_->resolution_usec_);
+        if (usec % wheel_->resolution_usec_ != 0)
+          ++ticks;
+      }
+      if (ticks > delta)
+        delta = ticks;
+    }
+    if (delta > max_delta)
+      delta = max_delta;
+
+    uint64_t tick = wheel_->tick_ + delta;
+    std::size_t slot = static_cast<std::size_t>(tick & (wheel_root_size - 1));
+    if (delta >= wheel_root_size)
+    {
+      std::size_t level = 0;
+      uint64_t limit = uint64_t(wheel_root_size) << wheel_level_bits;
+      while (delta >= limit)
+      {
+        ++level;
+        limit <<= wheel_level_bits;
+      }
+      slot = wheel_root_size + level * wheel_level_size
+        + static_cast<std::size_t>((tick >> (wheel_root_bits
+                + level * wheel_level_bits)) & (wheel_level_size - 1));
+    }
+
+    wheel_link(timer, slot);
+    return tick;
+  }
+
+  // Add a timer to the linked list for a slot.
+  void wheel_link(per_timer_data& timer, std::size_t slot)
+  {
+    per_timer_data*& head = wheel_->slots_[slot];
+    timer.heap_index_ = slot;
+    timer.next_ = head;
+    timer.prev_ = 0;
+    if (head)
+      head->prev_ = &timer;
+    head = &timer;
+
+    if (slot < wheel_root_size)
+      wheel_->bits_[slot / 64] |= uint64_t(1) << (slot % 64);
+    if (slot != wheel_never_slot)
+      ++wheel_->size_;
+  }
+
+  // Remove a timer from the linked list for its slot.
+  void wheel_unlink(per_timer_data& timer)
+  {
+    std::size_t slot = timer.heap_index_;
+    if (slot >= wheel_num_slots)
+      return;
+
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    else
+      wheel_->slots_[slot] = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_ = timer.prev_;
+    timer.heap_index_ = (std::numeric_limits<std::size_t>::max)();
+    timer.next_ = 0;
+    timer.prev_ = 0;
+
+    if (slot < wheel_root_size && wheel_->slots_[slot] == 0)
+      wheel_->bits_[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    if (slot != wheel_never_slot)
+      --wheel_->size_;
+  }
+
+  // Find the first non-empty root level slot at or after the given index.
+  // Returns the size of the root level if there is no such slot.
+  std::size_t wheel_find_slot(std::size_t index) const
+  {
+    for (std::size_t word = index / 64; word < wheel_root_size / 64; ++word)
+    {
+      uint64_t bits = wheel_->bits_[word];
+      if (word == index / 64)
+        bits &= ~uint64_t(0) << (index % 64);
+      if (bits)
+        return word * 64 + lowest_bit(bits);
+    }
+    return wheel_root_size;
+  }
+
+  // Get the next tick at which the wheel must be serviced, or the largest
+  // possible tick if the wheel is empty.
+  uint64_t wheel_next_tick() const
+  {
+    if (wheel_->size_ == 0)
+      return ~uint64_t(0);
+
+    std::size_t index = static_cast<std::size_t>(
+        wheel_->tick_ & (wheel_root_size - 1));
+    return wheel_->tick_ - index + wheel_find_slot(index);
+  }
+
+  // Get the time at which the wheel must next be serviced. The wheel must not
+  // be empty.
+  time_type wheel_next_time() const
+  {
+    std::size_t index = static_cast<std::size_t>(
+        wheel_->tick_ & (wheel_root_size - 1));
+    std::size_t slot = wheel_find_slot(index);
+    return Time_Traits::add(wheel_->tick_time_,
+        wheel_->resolution_ * static_cast<int>(slot - index));
+  }
+
+  // Get the index of the lowest set bit in a non-zero value.
+  static std::size_t lowest_bit(uint64_t bits)
+  {
+    static const unsigned char table[64] =
+    {
+       0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+      62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+      63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+      46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+    };
+    const uint64_t debruijn =
+      (static_cast<uint64_t>(0x03f79d71u) << 32) | 0xb4cb0a89u;
+    return table[((bits & (0 - bits)) * debruijn) >> 58];
+  }
+
   // Determine if the specified absolute time is positive infinity.
   template <typename Time_Type>
   static bool is_positive_infinity(const Time_Type&)
@@ -350,6 +761,43 @@ private:
 
   // The heap of timers, with the earliest timer at the front.
   std::vector<heap_entry> heap_;
+
+  // The geometry of the timing wheel. The root level has one slot per tick,
+  // and each slot in an upper level spans all slots of the level below it.
+  enum
+  {
+    wheel_root_bits = 8,
+    wheel_root_size = 1 << wheel_root_bits,
+    wheel_level_bits = 6,
+    wheel_level_size = 1 << wheel_level_bits,
+    wheel_levels = 3,
+    wheel_never_slot = wheel_root_size + wheel_levels * wheel_level_size,
+    wheel_num_slots = wheel_never_slot + 1
+  };
+
+  struct timer_wheel
+  {
+    // The heads of the linked lists of timers in each slot.
+    per_timer_data* slots_[wheel_num_slots];
+
+    // A bitmap of the non-empty slots in the root level.
+    uint64_t bits_[wheel_root_size / 64];
+
+    // The current tick, and the time at which it begins.
+    uint64_t tick_;
+    time_type tick_time_;
+
+    // The duration of a tick.
+    duration_type resolution_;
+    int64_t resolution_usec_;
+
+    // The number of timers held in the wheel's slots, excluding timers that
+    // never expire.
+    std::size_t size_;
+  };
+
+  // The timing wheel, if one is used in place of the heap.
+  timer_wheel* wheel_;
 };
 
 } // namespace detail
@@ -77,6 +77,10 @@ public:
       per_timer_data& timer, op_queue<operation>& ops,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Change the expiry time of a timer without dequeuing its operations.
+  ASIO_DECL bool reschedule_timer(const time_type& time,
+      per_timer_data& timer);
+
   // Move operations from one timer to another, empty timer.
   ASIO_DECL void move_timer(per_timer_data& target,
       per_timer_data& source);
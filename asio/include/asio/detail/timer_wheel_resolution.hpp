@@ -0,0 +1,64 @@
+//
+// detail/timer_wheel_resolution.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_TIMER_WHEEL_RESOLUTION_HPP
+#define ASIO_DETAIL_TIMER_WHEEL_RESOLUTION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename T, T>
+struct timer_wheel_resolution_check
+{
+};
+
+template <typename, typename>
+char (&timer_wheel_resolution_helper(...))[2];
+
+template <typename Traits, typename Duration>
+char timer_wheel_resolution_helper(
+    timer_wheel_resolution_check<
+      Duration (*)(), &Traits::timer_wheel_resolution>*);
+
+template <typename Traits, typename Duration,
+    bool = sizeof(timer_wheel_resolution_helper<Traits, Duration>(0)) == 1>
+struct timer_wheel_resolution
+{
+  // The traits class supplies a static timer_wheel_resolution() function.
+  static Duration get()
+  {
+    return Traits::timer_wheel_resolution();
+  }
+};
+
+template <typename Traits, typename Duration>
+struct timer_wheel_resolution<Traits, Duration, false>
+{
+  // No resolution is specified, so timers are kept in a heap.
+  static Duration get()
+  {
+    return Duration();
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_TIMER_WHEEL_RESOLUTION_HPP
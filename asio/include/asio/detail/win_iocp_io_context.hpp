@@ -22,6 +22,7 @@
 #include "asio/detail/limits.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
+#include "asio/detail/reactor_statistics.hpp"
 #include "asio/detail/scoped_ptr.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/detail/thread.hpp"
@@ -200,12 +201,39 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
       typename timer_queue<Time_Traits>::per_timer_data& to,
       typename timer_queue<Time_Traits>::per_timer_data& from);
 
+  // Set the time for which idle threads poll for work. Threads wait on the
+  // completion port, so polling is not performed.
+  void set_spin_duration(long)
+  {
+  }
+
+  // Set the maximum number of events collected by each reactor wait. The
+  // completion port is not a batching reactor, so the setting has no effect.
+  void set_reactor_batch_size(std::size_t)
+  {
+  }
+
+  // Get the counters that describe the reactor's waits for events. No
+  // counters are maintained for the completion port.
+  reactor_statistics get_reactor_statistics()
+  {
+    reactor_statistics stats = { 0, 0, 0, 0 };
+    return stats;
+  }
+
   // Get the concurrency hint that was used to initialise the io_context.
   int concurrency_hint() const
   {
@@ -110,6 +110,16 @@ public:
   {
   }
 
+  // Set the number of threads used to perform asynchronous operations.
+  void set_thread_count(std::size_t)
+  {
+  }
+
+  // Set the times for which the results of asynchronous queries are cached.
+  void set_cache_durations(long, long)
+  {
+  }
+
   // Resolve a query to a list of entries.
   results_type resolve(implementation_type&,
       const query_type& query, asio::error_code& ec)
@@ -0,0 +1,115 @@
+//
+// detail/work_stealing_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_WORK_STEALING_QUEUE_HPP
+#define ASIO_DETAIL_WORK_STEALING_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_WORK_STEALING)
+
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A bounded, lock-free queue of operations. Only the owning thread may push,
+// but any thread may pop. Operations are popped in the order they were pushed.
+template <typename Operation>
+class work_stealing_queue
+  : private noncopyable
+{
+public:
+  // The maximum number of operations that may be held in the queue.
+  enum { capacity = 256 };
+
+  // Construct an empty queue.
+  work_stealing_queue()
+    : top_(0),
+      bottom_(0)
+  {
+    for (std::size_t i = 0; i < capacity; ++i)
+      slots_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // Add an operation to the back of the queue. Must only be called by the
+  // owning thread. Returns false if the queue is full.
+  bool push(Operation* op)
+  {
+    std::size_t b = bottom_.load(std::memory_order_relaxed);
+    std::size_t t = top_.load(std::memory_order_acquire);
+    if (b - t >= capacity)
+      return false;
+    slots_[b & (capacity - 1)].store(op, std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Remove the operation at the front of the queue. May be called from any
+  // thread. Returns 0 if the queue is empty.
+  Operation* pop()
+  {
+    std::size_t t = top_.load(std::memory_order_acquire);
+    for (;;)
+    {
+      std::size_t b = bottom_.load(std::memory_order_acquire);
+      if (t == b)
+        return 0;
+
+      // The slot may be overwritten by the owner once another thread has
+      // claimed it, in which case the compare-exchange below fails and the
+      // value is discarded.
+      Operation* op = slots_[t & (capacity - 1)].load(
+          std::memory_order_relaxed);
+      if (top_.compare_exchange_weak(t, t + 1,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+        return op;
+    }
+  }
+
+  // Whether the queue appears to be empty.
+  bool empty() const
+  {
+    return top_.load(std::memory_order_acquire)
+      == bottom_.load(std::memory_order_acquire);
+  }
+
+private:
+  // The index of the front of the queue. Advanced by any popping thread.
+  std::atomic<std::size_t> top_;
+
+  // Keep the indexes on separate cache lines.
+  char padding1_[64];
+
+  // The index one past the back of the queue. Advanced by the owner only.
+  std::atomic<std::size_t> bottom_;
+
+  char padding2_[64];
+
+  // The operations.
+  std::atomic<Operation*> slots_[capacity];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_WORK_STEALING)
+
+#endif // ASIO_DETAIL_WORK_STEALING_QUEUE_HPP
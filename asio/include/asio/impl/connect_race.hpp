@@ -0,0 +1,376 @@
+//
+// impl/connect_race.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_CONNECT_RACE_HPP
+#define ASIO_IMPL_CONNECT_RACE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/post.hpp"
+#include "asio/wait_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // A socket used for a single connection attempt.
+  template <typename Protocol, typename Executor>
+  class race_connect_socket : public basic_socket<Protocol, Executor>
+  {
+  public:
+    explicit race_connect_socket(const Executor& ex)
+      : basic_socket<Protocol, Executor>(ex)
+    {
+    }
+  };
+
+  // The state shared by the connection attempts and the delay timer. The
+  // attempts may complete concurrently, so all access is under the mutex.
+  template <typename Protocol, typename Executor,
+      typename ConnectCondition, typename RangeConnectHandler>
+  class race_connect_state
+    : private noncopyable
+  {
+  public:
+    typedef typename Protocol::endpoint endpoint_type;
+    typedef race_connect_socket<Protocol, Executor> socket_type;
+    typedef basic_waitable_timer<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>, Executor> timer_type;
+    typedef shared_ptr<race_connect_state> pointer;
+
+    template <typename EndpointSequence>
+    race_connect_state(basic_socket<Protocol, Executor>& sock,
+        const EndpointSequence& endpoints,
+        const chrono::steady_clock::duration& delay,
+        const ConnectCondition& connect_condition,
+        RangeConnectHandler& handler)
+      : socket_(sock),
+        timer_(sock.get_executor()),
+        delay_(delay),
+        connect_condition_(connect_condition),
+        next_(0),
+        pending_(0),
+        generation_(0),
+        done_(false),
+        handler_(ASIO_MOVE_CAST(RangeConnectHandler)(handler))
+    {
+      interleave(endpoints.begin(), endpoints.end());
+    }
+
+    ~race_connect_state()
+    {
+      for (std::size_t i = 0; i < sockets_.size(); ++i)
+        delete sockets_[i];
+    }
+
+    // Start the first connection attempt.
+    static void start(const pointer& p)
+    {
+      mutex::scoped_lock lock(p->mutex_);
+      asio::error_code ignored_ec;
+      p->socket_.close(ignored_ec);
+      p->launch(p);
+    }
+
+    // Handle the completion of a connection attempt.
+    static void on_connect(const pointer& p,
+        std::size_t index, const asio::error_code& ec)
+    {
+      mutex::scoped_lock lock(p->mutex_);
+      --p->pending_;
+      if (p->done_)
+        return;
+
+      if (!ec && p->sockets_[index]->is_open())
+      {
+        p->finish(ec, p->attempted_[index], p->sockets_[index]);
+        return;
+      }
+
+      // A failed attempt starts the next one without waiting for the delay.
+      p->last_error_ = ec ? ec : asio::error::operation_aborted;
+      asio::error_code ignored_ec;
+      p->sockets_[index]->close(ignored_ec);
+      p->launch(p);
+    }
+
+    // Handle the expiry of the delay timer.
+    static void on_timer(const pointer& p,
+        unsigned int generation, const asio::error_code& ec)
+    {
+      mutex::scoped_lock lock(p->mutex_);
+      if (!ec && !p->done_ && generation == p->generation_)
+        p->launch(p);
+    }
+
+  private:
+    // Order the endpoints so that the address families alternate, starting
+    // with the family of the first endpoint.
+    template <typename Iterator>
+    void interleave(Iterator begin, Iterator end)
+    {
+      std::vector<endpoint_type> first, second;
+      for (Iterator iter = begin; iter != end; ++iter)
+      {
+        endpoint_type endpoint = *iter;
+        if (first.empty() || endpoint.protocol() == first[0].protocol())
+          first.push_back(endpoint);
+        else
+          second.push_back(endpoint);
+      }
+
+      for (std::size_t i = 0; i < first.size() || i < second.size(); ++i)
+      {
+        if (i < first.size())
+          endpoints_.push_back(first[i]);
+        if (i < second.size())
+          endpoints_.push_back(second[i]);
+      }
+    }
+
+    // Start a connection attempt to the next endpoint that satisfies the
+    // connect condition. Completes the operation if there are no endpoints
+    // left and no attempts in progress.
+    void launch(const pointer& p)
+    {
+      typedef typename std::vector<endpoint_type>::iterator iterator;
+
+      while (next_ < endpoints_.size())
+      {
+        iterator end = endpoints_.end();
+        iterator iter = endpoints_.begin() + next_;
+        iter = detail::call_connect_condition(
+            connect_condition_, last_error_, iter, end);
+        if (iter == end)
+        {
+          next_ = endpoints_.size();
+          break;
+        }
+        next_ = (iter - endpoints_.begin()) + 1;
+
+        sockets_.push_back(0);
+        sockets_.back() = new socket_type(socket_.get_executor());
+        attempted_.push_back(*iter);
+
+        asio::error_code ec;
+        sockets_.back()->open(iter->protocol(), ec);
+        if (ec)
+        {
+          last_error_ = ec;
+          continue;
+        }
+
+        ++pending_;
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_connect_race"));
+        sockets_.back()->async_connect(*iter,
+            attempt_handler(p, sockets_.size() - 1));
+
+        ++generation_;
+        if (next_ < endpoints_.size())
+        {
+          timer_.expires_after(delay_);
+          timer_.async_wait(timer_handler(p, generation_));
+        }
+        return;
+      }
+
+      if (pending_ == 0)
+      {
+        finish(last_error_ ? last_error_
+            : asio::error_code(asio::error::not_found),
+            endpoint_type(), 0);
+      }
+    }
+
+    // Cancel the remaining attempts and deliver the result.
+    void finish(const asio::error_code& ec,
+        const endpoint_type& endpoint, socket_type* winner)
+    {
+      done_ = true;
+      ++generation_;
+      timer_.cancel();
+
+      asio::error_code ignored_ec;
+      for (std::size_t i = 0; i < sockets_.size(); ++i)
+        if (sockets_[i] != winner)
+          sockets_[i]->close(ignored_ec);
+
+      if (winner)
+      {
+        socket_.close(ignored_ec);
+        socket_ = std::move(
+            static_cast<basic_socket<Protocol, Executor>&>(*winner));
+      }
+
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_connect_race"));
+      asio::post(socket_.get_executor(),
+          detail::bind_handler(
+            ASIO_MOVE_CAST(RangeConnectHandler)(handler_), ec, endpoint));
+    }
+
+    class attempt_handler
+    {
+    public:
+      attempt_handler(const pointer& p, std::size_t index)
+        : p_(p),
+          index_(index)
+      {
+      }
+
+      void operator()(const asio::error_code& ec)
+      {
+        race_connect_state::on_connect(p_, index_, ec);
+      }
+
+    private:
+      pointer p_;
+      std::size_t index_;
+    };
+
+    class timer_handler
+    {
+    public:
+      timer_handler(const pointer& p, unsigned int generation)
+        : p_(p),
+          generation_(generation)
+      {
+      }
+
+      void operator()(const asio::error_code& ec)
+      {
+        race_connect_state::on_timer(p_, generation_, ec);
+      }
+
+    private:
+      pointer p_;
+      unsigned int generation_;
+    };
+
+    mutex mutex_;
+    basic_socket<Protocol, Executor>& socket_;
+    timer_type timer_;
+    chrono::steady_clock::duration delay_;
+    ConnectCondition connect_condition_;
+    std::vector<endpoint_type> endpoints_;
+    std::size_t next_;
+    std::vector<socket_type*> sockets_;
+    std::vector<endpoint_type> attempted_;
+    std::size_t pending_;
+    unsigned int generation_;
+    bool done_;
+    asio::error_code last_error_;
+    RangeConnectHandler handler_;
+  };
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_race_connect
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_race_connect(basic_socket<Protocol, Executor>& s)
+      : socket_(s)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename RangeConnectHandler,
+        typename EndpointSequence, typename ConnectCondition>
+    void operator()(ASIO_MOVE_ARG(RangeConnectHandler) handler,
+        const EndpointSequence& endpoints,
+        const chrono::steady_clock::duration& delay,
+        const ConnectCondition& connect_condition) const
+    {
+      // If you get an error on the following line it means that your
+      // handler does not meet the documented type requirements for an
+      // RangeConnectHandler.
+      ASIO_RANGE_CONNECT_HANDLER_CHECK(RangeConnectHandler,
+          handler, typename Protocol::endpoint) type_check;
+
+      typedef race_connect_state<Protocol, Executor, ConnectCondition,
+        typename decay<RangeConnectHandler>::type> state_type;
+
+      non_const_lvalue<RangeConnectHandler> handler2(handler);
+      typename state_type::pointer p(new state_type(socket_,
+            endpoints, delay, connect_condition, handler2.value));
+      state_type::start(p);
+    }
+
+  private:
+    basic_socket<Protocol, Executor>& socket_;
+  };
+} // namespace detail
+
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    typename Rep, typename Period,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      typename Protocol::endpoint)) RangeConnectHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_race(basic_socket<Protocol, Executor>& s,
+    const EndpointSequence& endpoints,
+    const chrono::duration<Rep, Period>& delay,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type*)
+{
+  return async_initiate<RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint)>(
+      detail::initiate_async_race_connect<Protocol, Executor>(s),
+      handler, endpoints,
+      chrono::duration_cast<chrono::steady_clock::duration>(delay),
+      detail::default_connect_condition());
+}
+
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    typename Rep, typename Period, typename ConnectCondition,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      typename Protocol::endpoint)) RangeConnectHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_race(basic_socket<Protocol, Executor>& s,
+    const EndpointSequence& endpoints,
+    const chrono::duration<Rep, Period>& delay,
+    ConnectCondition connect_condition,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type*)
+{
+  return async_initiate<RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint)>(
+      detail::initiate_async_race_connect<Protocol, Executor>(s),
+      handler, endpoints,
+      chrono::duration_cast<chrono::steady_clock::duration>(delay),
+      connect_condition);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_CONNECT_RACE_HPP
@@ -109,6 +109,14 @@ std::size_t io_context::run_one_until(
   return 0;
 }
 
+template <typename Rep, typename Period>
+void io_context::set_spin_duration(
+    const chrono::duration<Rep, Period>& spin_duration)
+{
+  impl_.set_spin_duration(static_cast<long>(chrono::duration_cast<
+        chrono::microseconds>(spin_duration).count()));
+}
+
 #endif // defined(ASIO_HAS_CHRONO)
 
 #if !defined(ASIO_NO_DEPRECATED)
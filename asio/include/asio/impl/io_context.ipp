@@ -131,6 +131,16 @@ void io_context::restart()
   impl_.restart();
 }
 
+void io_context::set_reactor_batch_size(std::size_t max_events)
+{
+  impl_.set_reactor_batch_size(max_events);
+}
+
+io_context::reactor_statistics io_context::get_reactor_statistics()
+{
+  return impl_.get_reactor_statistics();
+}
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
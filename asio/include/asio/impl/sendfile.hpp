@@ -0,0 +1,187 @@
+//
+// impl/sendfile.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_SENDFILE_HPP
+#define ASIO_IMPL_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/compose.hpp"
+#include "asio/completion_condition.hpp"
+#include "asio/detail/base_from_completion_cond.hpp"
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+template <typename Protocol, typename Executor, typename FileExecutor,
+    typename CompletionCondition>
+std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    CompletionCondition completion_condition, asio::error_code& ec)
+{
+  ec = asio::error_code();
+  std::size_t total_transferred = 0;
+  while (total_transferred < count)
+  {
+    if (std::size_t max_size = detail::adapt_completion_condition_result(
+          completion_condition(ec, total_transferred)))
+    {
+      std::size_t remaining = count - total_transferred;
+      total_transferred += s.sendfile_some(file.native_handle(),
+          offset + total_transferred,
+          max_size < remaining ? max_size : remaining, ec);
+    }
+    else
+      break;
+  }
+  return total_transferred;
+}
+
+template <typename Protocol, typename Executor, typename FileExecutor>
+inline std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = sendfile(s,
+      file, offset, count, transfer_all(), ec);
+  asio::detail::throw_error(ec, "sendfile");
+  return bytes_transferred;
+}
+
+template <typename Protocol, typename Executor, typename FileExecutor>
+inline std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count, asio::error_code& ec)
+{
+  return sendfile(s, file, offset, count, transfer_all(), ec);
+}
+
+template <typename Protocol, typename Executor, typename FileExecutor,
+    typename CompletionCondition>
+inline std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    CompletionCondition completion_condition)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = sendfile(s, file, offset, count,
+      ASIO_MOVE_CAST(CompletionCondition)(completion_condition), ec);
+  asio::detail::throw_error(ec, "sendfile");
+  return bytes_transferred;
+}
+
+namespace detail
+{
+  template <typename Protocol, typename Executor,
+      typename CompletionCondition>
+  class sendfile_op
+    : detail::base_from_completion_cond<CompletionCondition>
+  {
+  public:
+    sendfile_op(basic_stream_socket<Protocol, Executor>& socket,
+        int file, uint64_t offset, std::size_t count,
+        CompletionCondition& completion_condition)
+      : detail::base_from_completion_cond<
+          CompletionCondition>(completion_condition),
+        socket_(socket),
+        file_(file),
+        offset_(offset),
+        count_(count),
+        total_transferred_(0),
+        start_(true)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        const asio::error_code& ec = asio::error_code(),
+        std::size_t bytes_transferred = 0)
+    {
+      std::size_t max_size;
+      if (start_)
+      {
+        start_ = false;
+        max_size = this->check_for_completion(ec, total_transferred_);
+      }
+      else
+      {
+        total_transferred_ += bytes_transferred;
+        max_size = this->check_for_completion(ec, total_transferred_);
+        if ((!ec && bytes_transferred == 0)
+            || total_transferred_ == count_ || max_size == 0)
+        {
+          self.complete(ec, total_transferred_);
+          return;
+        }
+      }
+
+      // The first write is always started, even if there is nothing to be
+      // written, so that the handler is not called from the initiating
+      // function.
+      std::size_t remaining = count_ - total_transferred_;
+      socket_.async_sendfile_some(file_, offset_ + total_transferred_,
+          max_size < remaining ? max_size : remaining,
+          ASIO_MOVE_CAST(Self)(self));
+    }
+
+  private:
+    basic_stream_socket<Protocol, Executor>& socket_;
+    int file_;
+    uint64_t offset_;
+    std::size_t count_;
+    std::size_t total_transferred_;
+    bool start_;
+  };
+} // namespace detail
+
+template <typename Protocol, typename Executor, typename FileExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  return async_sendfile(s, file, offset, count, transfer_all(),
+      ASIO_MOVE_CAST(WriteHandler)(handler));
+}
+
+template <typename Protocol, typename Executor, typename FileExecutor,
+    typename CompletionCondition,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    CompletionCondition completion_condition,
+    ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  return async_compose<WriteHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::sendfile_op<Protocol, Executor, CompletionCondition>(
+        s, file.native_handle(), offset, count, completion_condition),
+      handler, s);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SENDFILE_HPP
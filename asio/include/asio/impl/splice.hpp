@@ -0,0 +1,441 @@
+//
+// impl/splice.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_SPLICE_HPP
+#define ASIO_IMPL_SPLICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/compose.hpp"
+#include "asio/completion_condition.hpp"
+#include "asio/post.hpp"
+#include "asio/detail/base_from_completion_cond.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/splice_pipe.hpp"
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Performs one step of a splice between a socket and a pipe. The socket's
+  // operation waits only for the socket, so if it is the pipe that is not
+  // ready the step waits for the pipe and tries again.
+  template <typename Socket, typename Pipe>
+  class splice_pipe_step_op
+  {
+  public:
+    splice_pipe_step_op(Socket& socket, Pipe& pipe,
+        bool to_pipe, std::size_t size)
+      : socket_(socket),
+        pipe_(pipe),
+        to_pipe_(to_pipe),
+        size_(size),
+        state_(starting)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        const asio::error_code& ec = asio::error_code(),
+        std::size_t bytes_transferred = 0)
+    {
+      switch (state_)
+      {
+      case splicing:
+        if (ec != asio::error::would_block)
+        {
+          self.complete(ec, bytes_transferred);
+          return;
+        }
+        state_ = waiting;
+        pipe_.async_wait(to_pipe_
+            ? posix::descriptor_base::wait_write
+            : posix::descriptor_base::wait_read,
+            ASIO_MOVE_CAST(Self)(self));
+        return;
+      case waiting:
+        if (ec)
+        {
+          self.complete(ec, 0);
+          return;
+        }
+        // Fall through.
+      case starting:
+      default:
+        state_ = splicing;
+        if (to_pipe_)
+        {
+          socket_.async_splice_some_to(pipe_.native_handle(),
+              size_, ASIO_MOVE_CAST(Self)(self));
+        }
+        else
+        {
+          socket_.async_splice_some_from(pipe_.native_handle(),
+              size_, ASIO_MOVE_CAST(Self)(self));
+        }
+        return;
+      }
+    }
+
+  private:
+    Socket& socket_;
+    Pipe& pipe_;
+    bool to_pipe_;
+    std::size_t size_;
+    enum { starting, splicing, waiting } state_;
+  };
+
+  // Performs one step of a splice between two sockets, by filling the
+  // intermediate pipe from the source and then draining it to the sink.
+  template <typename SourceSocket, typename SinkSocket>
+  class splice_sockets_step_op
+  {
+  public:
+    splice_sockets_step_op(SourceSocket& from, SinkSocket& to,
+        const shared_ptr<splice_pipe>& pipe, std::size_t size)
+      : from_(from),
+        to_(to),
+        pipe_(pipe),
+        size_(splice_pipe::clamp_size(size)),
+        pending_(0),
+        total_transferred_(0),
+        state_(starting)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        const asio::error_code& ec = asio::error_code(),
+        std::size_t bytes_transferred = 0)
+    {
+      switch (state_)
+      {
+      case starting:
+        {
+          asio::error_code open_ec;
+          if (!pipe_->open(open_ec))
+          {
+            state_ = failed;
+            asio::post(from_.get_executor(),
+                detail::bind_handler(ASIO_MOVE_CAST(Self)(self),
+                  open_ec, std::size_t(0)));
+            return;
+          }
+        }
+        state_ = filling;
+        from_.async_splice_some_to(pipe_->write_descriptor(),
+            size_, ASIO_MOVE_CAST(Self)(self));
+        return;
+      case filling:
+        pending_ = bytes_transferred;
+        if (ec || pending_ == 0)
+        {
+          self.complete(ec, 0);
+          return;
+        }
+        state_ = draining;
+        to_.async_splice_some_from(pipe_->read_descriptor(),
+            pending_, ASIO_MOVE_CAST(Self)(self));
+        return;
+      case draining:
+        pending_ -= bytes_transferred;
+        total_transferred_ += bytes_transferred;
+        if (ec || pending_ == 0)
+        {
+          self.complete(ec, total_transferred_);
+          return;
+        }
+        to_.async_splice_some_from(pipe_->read_descriptor(),
+            pending_, ASIO_MOVE_CAST(Self)(self));
+        return;
+      case failed:
+      default:
+        self.complete(ec, 0);
+        return;
+      }
+    }
+
+  private:
+    SourceSocket& from_;
+    SinkSocket& to_;
+    shared_ptr<splice_pipe> pipe_;
+    std::size_t size_;
+    std::size_t pending_;
+    std::size_t total_transferred_;
+    enum { starting, filling, draining, failed } state_;
+  };
+
+  // Adapts a source and a sink to a single interface for moving some data
+  // from one to the other.
+  template <typename Source, typename Sink>
+  class splice_channel;
+
+  template <typename Protocol, typename Executor, typename PipeExecutor>
+  class splice_channel<basic_stream_socket<Protocol, Executor>,
+      posix::basic_stream_descriptor<PipeExecutor> >
+  {
+  public:
+    typedef basic_stream_socket<Protocol, Executor> socket_type;
+    typedef posix::basic_stream_descriptor<PipeExecutor> pipe_type;
+
+    splice_channel(socket_type& from, pipe_type& to)
+      : socket_(from),
+        pipe_(to)
+    {
+    }
+
+    std::size_t splice_some(std::size_t size, asio::error_code& ec)
+    {
+      return socket_.splice_some_to(pipe_.native_handle(), size, ec);
+    }
+
+    template <typename Handler>
+    void async_splice_some(std::size_t size, Handler& handler)
+    {
+      async_compose<Handler, void (asio::error_code, std::size_t)>(
+          splice_pipe_step_op<socket_type, pipe_type>(
+            socket_, pipe_, true, size), handler, socket_, pipe_);
+    }
+
+  private:
+    socket_type& socket_;
+    pipe_type& pipe_;
+  };
+
+  template <typename PipeExecutor, typename Protocol, typename Executor>
+  class splice_channel<posix::basic_stream_descriptor<PipeExecutor>,
+      basic_stream_socket<Protocol, Executor> >
+  {
+  public:
+    typedef posix::basic_stream_descriptor<PipeExecutor> pipe_type;
+    typedef basic_stream_socket<Protocol, Executor> socket_type;
+
+    splice_channel(pipe_type& from, socket_type& to)
+      : pipe_(from),
+        socket_(to)
+    {
+    }
+
+    std::size_t splice_some(std::size_t size, asio::error_code& ec)
+    {
+      return socket_.splice_some_from(pipe_.native_handle(), size, ec);
+    }
+
+    template <typename Handler>
+    void async_splice_some(std::size_t size, Handler& handler)
+    {
+      async_compose<Handler, void (asio::error_code, std::size_t)>(
+          splice_pipe_step_op<socket_type, pipe_type>(
+            socket_, pipe_, false, size), handler, socket_, pipe_);
+    }
+
+  private:
+    pipe_type& pipe_;
+    socket_type& socket_;
+  };
+
+  template <typename Protocol1, typename Executor1,
+      typename Protocol2, typename Executor2>
+  class splice_channel<basic_stream_socket<Protocol1, Executor1>,
+      basic_stream_socket<Protocol2, Executor2> >
+  {
+  public:
+    typedef basic_stream_socket<Protocol1, Executor1> source_type;
+    typedef basic_stream_socket<Protocol2, Executor2> sink_type;
+
+    splice_channel(source_type& from, sink_type& to)
+      : from_(from),
+        to_(to),
+        pipe_(new splice_pipe)
+    {
+    }
+
+    std::size_t splice_some(std::size_t size, asio::error_code& ec)
+    {
+      if (!pipe_->open(ec))
+        return 0;
+
+      std::size_t pending = from_.splice_some_to(pipe_->write_descriptor(),
+          splice_pipe::clamp_size(size), ec);
+
+      std::size_t total_transferred = 0;
+      while (!ec && total_transferred < pending)
+      {
+        total_transferred += to_.splice_some_from(pipe_->read_descriptor(),
+            pending - total_transferred, ec);
+      }
+      return total_transferred;
+    }
+
+    template <typename Handler>
+    void async_splice_some(std::size_t size, Handler& handler)
+    {
+      async_compose<Handler, void (asio::error_code, std::size_t)>(
+          splice_sockets_step_op<source_type, sink_type>(
+            from_, to_, pipe_, size), handler, from_, to_);
+    }
+
+  private:
+    source_type& from_;
+    sink_type& to_;
+    shared_ptr<splice_pipe> pipe_;
+  };
+} // namespace detail
+
+template <typename SyncSource, typename SyncSink,
+    typename CompletionCondition>
+std::size_t splice(SyncSource& from, SyncSink& to, std::size_t count,
+    CompletionCondition completion_condition, asio::error_code& ec)
+{
+  ec = asio::error_code();
+  detail::splice_channel<SyncSource, SyncSink> channel(from, to);
+  std::size_t total_transferred = 0;
+  while (total_transferred < count)
+  {
+    if (std::size_t max_size = detail::adapt_completion_condition_result(
+          completion_condition(ec, total_transferred)))
+    {
+      std::size_t remaining = count - total_transferred;
+      total_transferred += channel.splice_some(
+          max_size < remaining ? max_size : remaining, ec);
+    }
+    else
+      break;
+  }
+  return total_transferred;
+}
+
+template <typename SyncSource, typename SyncSink>
+inline std::size_t splice(SyncSource& from,
+    SyncSink& to, std::size_t count)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = splice(from, to, count, transfer_all(), ec);
+  asio::detail::throw_error(ec, "splice");
+  return bytes_transferred;
+}
+
+template <typename SyncSource, typename SyncSink>
+inline std::size_t splice(SyncSource& from, SyncSink& to,
+    std::size_t count, asio::error_code& ec)
+{
+  return splice(from, to, count, transfer_all(), ec);
+}
+
+template <typename SyncSource, typename SyncSink,
+    typename CompletionCondition>
+inline std::size_t splice(SyncSource& from, SyncSink& to, std::size_t count,
+    CompletionCondition completion_condition)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = splice(from, to, count,
+      ASIO_MOVE_CAST(CompletionCondition)(completion_condition), ec);
+  asio::detail::throw_error(ec, "splice");
+  return bytes_transferred;
+}
+
+namespace detail
+{
+  template <typename AsyncSource, typename AsyncSink,
+      typename CompletionCondition>
+  class splice_op
+    : detail::base_from_completion_cond<CompletionCondition>
+  {
+  public:
+    splice_op(AsyncSource& from, AsyncSink& to, std::size_t count,
+        CompletionCondition& completion_condition)
+      : detail::base_from_completion_cond<
+          CompletionCondition>(completion_condition),
+        channel_(from, to),
+        count_(count),
+        total_transferred_(0),
+        start_(true)
+    {
+    }
+
+    template <typename Self>
+    void operator()(Self& self,
+        const asio::error_code& ec = asio::error_code(),
+        std::size_t bytes_transferred = 0)
+    {
+      std::size_t max_size;
+      if (start_)
+      {
+        start_ = false;
+        max_size = this->check_for_completion(ec, total_transferred_);
+      }
+      else
+      {
+        total_transferred_ += bytes_transferred;
+        max_size = this->check_for_completion(ec, total_transferred_);
+        if ((!ec && bytes_transferred == 0)
+            || total_transferred_ == count_ || max_size == 0)
+        {
+          self.complete(ec, total_transferred_);
+          return;
+        }
+      }
+
+      // The first step is always started, even if there is nothing to be
+      // moved, so that the handler is not called from the initiating
+      // function.
+      std::size_t remaining = count_ - total_transferred_;
+      channel_.async_splice_some(
+          max_size < remaining ? max_size : remaining, self);
+    }
+
+  private:
+    splice_channel<AsyncSource, AsyncSink> channel_;
+    std::size_t count_;
+    std::size_t total_transferred_;
+    bool start_;
+  };
+} // namespace detail
+
+template <typename AsyncSource, typename AsyncSink,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SpliceHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(SpliceHandler,
+    void (asio::error_code, std::size_t))
+async_splice(AsyncSource& from, AsyncSink& to, std::size_t count,
+    ASIO_MOVE_ARG(SpliceHandler) handler)
+{
+  return async_splice(from, to, count, transfer_all(),
+      ASIO_MOVE_CAST(SpliceHandler)(handler));
+}
+
+template <typename AsyncSource, typename AsyncSink,
+    typename CompletionCondition,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SpliceHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(SpliceHandler,
+    void (asio::error_code, std::size_t))
+async_splice(AsyncSource& from, AsyncSink& to, std::size_t count,
+    CompletionCondition completion_condition,
+    ASIO_MOVE_ARG(SpliceHandler) handler)
+{
+  return async_compose<SpliceHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::splice_op<AsyncSource, AsyncSink, CompletionCondition>(
+        from, to, count, completion_condition),
+      handler, from, to);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SPLICE_HPP
@@ -196,30 +196,34 @@ void thread_pool::basic_executor_type<Allocator, Bits>::do_bulk_execute(
   typedef typename decay<Function>::type function_type;
   typedef detail::bulk_executor_op<function_type, Allocator> op;
 
-  // Allocate and construct operations to wrap the function.
+  if (n == 0)
+    return;
+
+  // Divide the indices into chunks that are shared between at most one
+  // operation per pool thread, all allocated in a single block.
+  std::size_t num_threads = static_cast<std::size_t>(pool_->num_threads_);
+  std::size_t runners = 0;
+  op* block = op::create(ASIO_MOVE_CAST(Function)(f), allocator_,
+      n, num_threads > 0 ? num_threads : 1, runners);
+
   detail::op_queue<detail::scheduler_operation> ops;
-  for (std::size_t i = 0; i < n; ++i)
+  for (std::size_t i = 0; i < runners; ++i)
   {
-    typename op::ptr p = { detail::addressof(allocator_),
-        op::ptr::allocate(allocator_), 0 };
-    p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f), allocator_, i);
-    ops.push(p.p);
+    ops.push(block + i);
 
     if ((bits_ & relationship_continuation) != 0)
     {
-      ASIO_HANDLER_CREATION((*pool_, *p.p,
+      ASIO_HANDLER_CREATION((*pool_, block[i],
             "thread_pool", pool_, 0, "bulk_execute(blk=never,rel=cont)"));
     }
     else
     {
-      ASIO_HANDLER_CREATION((*pool_, *p.p,
-            "thread_pool", pool_, 0, "bulk)execute(blk=never,rel=fork)"));
+      ASIO_HANDLER_CREATION((*pool_, block[i],
+            "thread_pool", pool_, 0, "bulk_execute(blk=never,rel=fork)"));
     }
-
-    p.v = p.p = 0;
   }
 
-  pool_->scheduler_.post_immediate_completions(n,
+  pool_->scheduler_.post_immediate_completions(runners,
       ops, (bits_ & relationship_continuation) != 0);
 }
 
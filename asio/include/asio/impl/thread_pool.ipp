@@ -18,6 +18,8 @@
 #include "asio/detail/config.hpp"
 #include <stdexcept>
 #include "asio/thread_pool.hpp"
+#include "asio/detail/concurrency_hint.hpp"
+#include "asio/detail/thread_affinity.hpp"
 #include "asio/detail/throw_exception.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -27,15 +29,21 @@ namespace asio {
 struct thread_pool::thread_function
 {
   detail::scheduler* scheduler_;
+  const std::vector<int>* cpus_;
+  std::size_t node_;
 
   void operator()()
   {
+    // A thread that cannot be pinned runs on any processor.
+    asio::error_code ec;
+    if (cpus_)
+      detail::thread_affinity::pin_current_thread(*cpus_, ec);
+
 #if !defined(ASIO_NO_EXCEPTIONS)
     try
     {
 #endif// !defined(ASIO_NO_EXCEPTIONS)
-      asio::error_code ec;
-      scheduler_->run(ec);
+      scheduler_->run(node_, ec);
 #if !defined(ASIO_NO_EXCEPTIONS)
     }
     catch (...)
@@ -60,11 +68,12 @@ inline long default_thread_pool_size()
 
 thread_pool::thread_pool()
   : scheduler_(add_scheduler(new detail::scheduler(*this, 0, false))),
-    num_threads_(detail::default_thread_pool_size())
+    num_threads_(detail::default_thread_pool_size()),
+    node_occupancy_(0)
 {
   scheduler_.work_started();
 
-  thread_function f = { &scheduler_ };
+  thread_function f = { &scheduler_, 0, 0 };
   threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
 }
 #endif // !defined(ASIO_NO_TS_EXECUTORS)
@@ -86,14 +95,47 @@ inline long clamp_thread_pool_size(std::size_t n)
 thread_pool::thread_pool(std::size_t num_threads)
   : scheduler_(add_scheduler(new detail::scheduler(
           *this, num_threads == 1 ? 1 : 0, false))),
-    num_threads_(detail::clamp_thread_pool_size(num_threads))
+    num_threads_(detail::clamp_thread_pool_size(num_threads)),
+    node_occupancy_(0)
 {
   scheduler_.work_started();
 
-  thread_function f = { &scheduler_ };
+  thread_function f = { &scheduler_, 0, 0 };
   threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
 }
 
+thread_pool::thread_pool(std::size_t num_threads, const affinity& a)
+  : scheduler_(add_scheduler(new detail::scheduler(*this,
+          a.node_count() > 1 ? ASIO_CONCURRENCY_HINT_WORK_STEALING
+            : num_threads == 1 ? 1 : 0, false))),
+    num_threads_(detail::clamp_thread_pool_size(num_threads)),
+    affinity_(a),
+    node_occupancy_(0)
+{
+  scheduler_.work_started();
+
+  // Threads are assigned to nodes in contiguous blocks, so that when there are
+  // fewer threads than nodes they are spread across the nodes.
+  std::size_t num_nodes = affinity_.node_count();
+  std::vector<std::size_t> node_threads(num_nodes);
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    if (num_nodes == 0)
+    {
+      thread_function f = { &scheduler_, 0, 0 };
+      threads_.create_thread(f);
+    }
+    else
+    {
+      std::size_t node = i * num_nodes / num_threads;
+      thread_function f = { &scheduler_, &affinity_.node_cpus(node), node };
+      threads_.create_thread(f);
+      if (++node_threads[node] > node_occupancy_ && num_nodes > 1)
+        node_occupancy_ = node_threads[node];
+    }
+  }
+}
+
 thread_pool::~thread_pool()
 {
   stop();
@@ -108,7 +150,7 @@ void thread_pool::stop()
 void thread_pool::attach()
 {
   ++num_threads_;
-  thread_function f = { &scheduler_ };
+  thread_function f = { &scheduler_, 0, 0 };
   f();
 }
 
@@ -134,6 +176,13 @@ void thread_pool::wait()
   threads_.join();
 }
 
+thread_pool::affinity thread_pool::affinity::numa()
+{
+  affinity a;
+  detail::thread_affinity::numa_nodes(a.nodes_);
+  return a;
+}
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
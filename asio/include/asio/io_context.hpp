@@ -24,6 +24,7 @@
 #include "asio/error_code.hpp"
 #include "asio/execution.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/detail/reactor_statistics.hpp"
 
 #if defined(ASIO_HAS_CHRONO)
 # include "asio/detail/chrono.hpp"
@@ -243,6 +244,18 @@ public:
   /// The type used to count the number of handlers executed by the context.
   typedef std::size_t count_type;
 
+  /// Counters that describe the reactor's waits for events.
+  /**
+   * The structure has the following @c std::size_t members:
+   * @li @c waits: The number of waits that have been performed.
+   * @li @c events: The total number of events returned by the waits.
+   * @li @c full_batches: The number of waits that returned as many events as
+   * could be collected.
+   * @li @c batch_size: The number of events that a wait can currently
+   * collect.
+   */
+  typedef detail::reactor_statistics reactor_statistics;
+
   /// Constructor.
   ASIO_DECL io_context();
 
@@ -535,6 +548,53 @@ public:
    */
   ASIO_DECL void restart();
 
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Set the time for which idle threads poll for handlers before blocking.
+  /**
+   * By default, a thread in run() or run_one() that finds no handlers ready to
+   * run blocks until it is woken. Waking a blocked thread adds the latency of
+   * a system call and a context switch. This function may be used to have
+   * idle threads first poll the reactor, and check for newly queued handlers,
+   * for up to the given duration. The spin period restarts each time a
+   * handler is run.
+   *
+   * @param spin_duration The time for which an idle thread polls before
+   * blocking. A zero duration, the default, disables polling.
+   *
+   * @note Polling keeps a CPU busy for the whole spin period, even when there
+   * is no work. It has no effect when the io_context is constructed with
+   * ASIO_CONCURRENCY_HINT_WORK_STEALING, or on Windows.
+   */
+  template <typename Rep, typename Period>
+  void set_spin_duration(const chrono::duration<Rep, Period>& spin_duration);
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+  /// Set the maximum number of events collected by each reactor wait.
+  /**
+   * The reactor collects ready events in batches. Each wait starts with room
+   * for up to 128 events, or @c max_events if that is smaller. The batch
+   * doubles in size after each wait that fills it, up to @c max_events, so
+   * that a busy reactor makes fewer system calls.
+   *
+   * @param max_events The largest number of events collected by a single
+   * wait. The value is limited to between 1 and 65536. The default is 1024.
+   *
+   * @note Only the epoll reactor collects events in batches. On other
+   * platforms this function has no effect.
+   */
+  ASIO_DECL void set_reactor_batch_size(std::size_t max_events);
+
+  /// Get the counters that describe the reactor's waits for events.
+  /**
+   * The counters may be used to choose a batch size for
+   * set_reactor_batch_size(). The number of events per wait is given by
+   * dividing @c events by @c waits.
+   *
+   * @note Only the epoll reactor maintains the counters. On other platforms
+   * all counters are zero.
+   */
+  ASIO_DECL reactor_statistics get_reactor_statistics();
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
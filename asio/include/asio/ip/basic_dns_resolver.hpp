@@ -0,0 +1,411 @@
+//
+// ip/basic_dns_resolver.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_BASIC_DNS_RESOLVER_HPP
+#define ASIO_IP_BASIC_DNS_RESOLVER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#include <string>
+#include <vector>
+#include "asio/any_io_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/compose.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/string_view.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/ip/address.hpp"
+#include "asio/ip/basic_resolver_results.hpp"
+#include "asio/ip/detail/dns_message.hpp"
+#include "asio/ip/detail/dns_resolve_op.hpp"
+#include "asio/ip/detail/resolv_conf.hpp"
+#include "asio/ip/udp.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Provides endpoint resolution by querying DNS servers directly.
+/**
+ * The basic_dns_resolver class template resolves host names by sending DNS
+ * queries to the configured name servers, using the I/O executor's sockets
+ * and timers. Unlike basic_resolver, it does not use the operating system's
+ * resolver functions and so does not need a background thread to perform an
+ * asynchronous resolve operation.
+ *
+ * Queries are sent using UDP, and are repeated using TCP if the response is
+ * truncated. Each server is tried in turn until one answers, or until every
+ * server has been tried the configured number of times.
+ *
+ * The resolver does not consult local host name databases, such as
+ * <tt>/etc/hosts</tt>, does not apply search domains, and accepts only
+ * numeric service names.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+template <typename InternetProtocol, typename Executor = any_io_executor>
+class basic_dns_resolver
+{
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// Rebinds the resolver type to another executor.
+  template <typename Executor1>
+  struct rebind_executor
+  {
+    /// The resolver type when rebound to the specified executor.
+    typedef basic_dns_resolver<InternetProtocol, Executor1> other;
+  };
+
+  /// The protocol type.
+  typedef InternetProtocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename InternetProtocol::endpoint endpoint_type;
+
+  /// The results type.
+  typedef basic_resolver_results<InternetProtocol> results_type;
+
+  /// Construct with executor.
+  /**
+   * This constructor creates a basic_dns_resolver that uses the name servers
+   * listed in <tt>/etc/resolv.conf</tt>. If that file cannot be read, a name
+   * server on the local machine is used.
+   *
+   * @param ex The I/O executor that the resolver will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on the
+   * resolver.
+   */
+  explicit basic_dns_resolver(const executor_type& ex)
+    : executor_(ex)
+  {
+    init();
+  }
+
+  /// Construct with execution context.
+  /**
+   * This constructor creates a basic_dns_resolver that uses the name servers
+   * listed in <tt>/etc/resolv.conf</tt>. If that file cannot be read, a name
+   * server on the local machine is used.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the resolver will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on the resolver.
+   */
+  template <typename ExecutionContext>
+  explicit basic_dns_resolver(ExecutionContext& context,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+    : executor_(context.get_executor())
+  {
+    init();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  /// Load the configuration from a file.
+  /**
+   * This function replaces the name servers, timeout and number of attempts
+   * with those given in a file using the format of <tt>resolv.conf</tt>. The
+   * @c nameserver lines and the @c timeout and @c attempts options are used.
+   *
+   * @param path The name of the file.
+   *
+   * @throws asio::system_error Thrown on failure, in which case the
+   * configuration is unchanged.
+   */
+  void load_configuration(const std::string& path)
+  {
+    asio::error_code ec;
+    load_configuration(path, ec);
+    asio::detail::throw_error(ec, "load_configuration");
+  }
+
+  /// Load the configuration from a file.
+  /**
+   * This function replaces the name servers, timeout and number of attempts
+   * with those given in a file using the format of <tt>resolv.conf</tt>. The
+   * @c nameserver lines and the @c timeout and @c attempts options are used.
+   *
+   * @param path The name of the file.
+   *
+   * @param ec Set to indicate what error occurred, if any. On failure the
+   * configuration is unchanged.
+   */
+  ASIO_SYNC_OP_VOID load_configuration(
+      const std::string& path, asio::error_code& ec)
+  {
+    detail::resolv_conf conf;
+    conf.load(path.c_str(), ec);
+    if (!ec)
+      apply(conf);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Set the name servers to be queried.
+  /**
+   * The servers are tried in the order given.
+   */
+  void set_servers(const std::vector<udp::endpoint>& servers)
+  {
+    servers_ = servers;
+  }
+
+  /// Get the name servers to be queried.
+  const std::vector<udp::endpoint>& servers() const
+  {
+    return servers_;
+  }
+
+  /// Set the time to wait for a response from each server.
+  template <typename Rep, typename Period>
+  void set_timeout(const chrono::duration<Rep, Period>& timeout)
+  {
+    timeout_ = chrono::duration_cast<
+      chrono::steady_clock::duration>(timeout);
+  }
+
+  /// Set the number of times that each server is tried.
+  void set_attempts(int attempts)
+  {
+    attempts_ = attempts > 0 ? attempts : 1;
+  }
+
+  /// Asynchronously resolve a host name to a list of endpoints.
+  /**
+   * This function is used to resolve a host name into a list of endpoints of
+   * any supported address family. The IPv6 endpoints, if any, are listed
+   * before the IPv4 endpoints.
+   *
+   * @param host A host name or a numeric address string.
+   *
+   * @param service A numeric string corresponding to a port number. May be an
+   * empty string, in which case all resolved endpoints will have a port number
+   * of 0.
+   *
+   * @param handler The handler to be called when the resolve operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   results_type results // Resolved endpoints as a range.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * A successful resolve operation is guaranteed to pass a non-empty range to
+   * the handler. If no server answers, the handler is passed the error of the
+   * last failed attempt, such as asio::error::timed_out.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        results_type)) ResolveHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ResolveHandler,
+      void (asio::error_code, results_type))
+  async_resolve(ASIO_STRING_VIEW_PARAM host,
+      ASIO_STRING_VIEW_PARAM service,
+      ASIO_MOVE_ARG(ResolveHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_compose<ResolveHandler,
+      void (asio::error_code, results_type)>(
+        op_type(prepare(0, static_cast<std::string>(host),
+            static_cast<std::string>(service))), handler, executor_);
+  }
+
+  /// Asynchronously resolve a host name to a list of endpoints.
+  /**
+   * This function is used to resolve a host name into a list of endpoints of
+   * the given protocol's address family.
+   *
+   * @param protocol A protocol object, normally representing either the IPv4
+   * or IPv6 version of an internet protocol.
+   *
+   * @param host A host name or a numeric address string.
+   *
+   * @param service A numeric string corresponding to a port number. May be an
+   * empty string, in which case all resolved endpoints will have a port number
+   * of 0.
+   *
+   * @param handler The handler to be called when the resolve operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   results_type results // Resolved endpoints as a range.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * A successful resolve operation is guaranteed to pass a non-empty range to
+   * the handler. If no server answers, the handler is passed the error of the
+   * last failed attempt, such as asio::error::timed_out.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        results_type)) ResolveHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ResolveHandler,
+      void (asio::error_code, results_type))
+  async_resolve(const protocol_type& protocol,
+      ASIO_STRING_VIEW_PARAM host, ASIO_STRING_VIEW_PARAM service,
+      ASIO_MOVE_ARG(ResolveHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_compose<ResolveHandler,
+      void (asio::error_code, results_type)>(
+        op_type(prepare(&protocol, static_cast<std::string>(host),
+            static_cast<std::string>(service))), handler, executor_);
+  }
+
+private:
+  typedef detail::dns_resolve_state<InternetProtocol, Executor> state_type;
+  typedef detail::dns_resolve_op<InternetProtocol, Executor> op_type;
+
+  // Apply the system configuration.
+  void init()
+  {
+    detail::resolv_conf conf;
+    asio::error_code ignored_ec;
+    conf.load("/etc/resolv.conf", ignored_ec);
+    apply(conf);
+  }
+
+  void apply(const detail::resolv_conf& conf)
+  {
+    servers_.clear();
+    for (std::size_t i = 0; i < conf.nameservers.size(); ++i)
+      servers_.push_back(udp::endpoint(conf.nameservers[i], 53));
+    timeout_ = chrono::seconds(conf.timeout);
+    attempts_ = conf.attempts;
+  }
+
+  // Create the state for a resolve operation. The operation completes
+  // immediately if the state has no queries.
+  asio::detail::shared_ptr<state_type> prepare(const protocol_type* protocol,
+      const std::string& host, const std::string& service)
+  {
+    asio::detail::shared_ptr<state_type> state(new state_type(executor_));
+    state_type& s = *state;
+    s.host_name = host;
+    s.service_name = service;
+    s.servers = servers_;
+    s.timeout = timeout_;
+    s.attempts = attempts_;
+
+    unsigned long port = 0;
+    for (std::size_t i = 0; i < service.size(); ++i)
+    {
+      if (service[i] < '0' || service[i] > '9' || port > 0xFFFF)
+        port = 0x10000;
+      else
+        port = port * 10 + (service[i] - '0');
+    }
+    if (port > 0xFFFF)
+    {
+      s.result_ec = asio::error::service_not_found;
+      return state;
+    }
+    s.port = static_cast<unsigned short>(port);
+
+    int v4_family = InternetProtocol::v4().family();
+    bool want_v4 = !protocol || protocol->family() == v4_family;
+    bool want_v6 = !protocol || protocol->family() != v4_family;
+
+    // A numeric address needs no query.
+    asio::error_code addr_ec;
+    address addr = make_address(host, addr_ec);
+    if (!addr_ec)
+    {
+      if (addr.is_v4() ? want_v4 : want_v6)
+      {
+        endpoint_type endpoint(addr, s.port);
+        s.results = results_type::create(endpoint, host, service);
+      }
+      else
+        s.result_ec = asio::error::host_not_found;
+      return state;
+    }
+
+    if (s.servers.empty())
+    {
+      s.result_ec = asio::error::host_not_found_try_again;
+      return state;
+    }
+
+    asio::error_code ec;
+    if (want_v6)
+      add_query(s, detail::dns_message::type_aaaa, ec);
+    if (want_v4 && !ec)
+      add_query(s, detail::dns_message::type_a, ec);
+    if (ec)
+    {
+      s.queries.clear();
+      s.result_ec = ec;
+    }
+
+    return state;
+  }
+
+  // Add a query with an unpredictable identifier, so that responses cannot
+  // easily be forged.
+  void add_query(state_type& s, int type, asio::error_code& ec)
+  {
+    unsigned short id = detail::dns_message::random_id(ec);
+    if (ec)
+      return;
+
+    s.queries.push_back(detail::dns_query());
+    detail::dns_query& q = s.queries.back();
+    q.done = false;
+    q.use_tcp = false;
+    detail::dns_message::encode_query(s.host_name, id, type, q.message, ec);
+    if (ec)
+      ec = asio::error::host_not_found;
+  }
+
+  executor_type executor_;
+  std::vector<udp::endpoint> servers_;
+  chrono::steady_clock::duration timeout_;
+  int attempts_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_IP_BASIC_DNS_RESOLVER_HPP
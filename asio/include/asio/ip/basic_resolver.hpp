@@ -19,6 +19,7 @@
 #include <string>
 #include "asio/any_io_executor.hpp"
 #include "asio/async_result.hpp"
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/io_object_impl.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
@@ -188,6 +189,57 @@ public:
     return impl_.get_service().cancel(impl_.get_implementation());
   }
 
+  /// Set the number of threads used to perform asynchronous resolution.
+  /**
+   * Asynchronous resolve operations are performed as blocking calls on
+   * private threads that are shared by all resolvers for the same protocol in
+   * the same execution context. By default a single thread is used, so that a
+   * slow lookup delays all of those queued behind it. This function may be
+   * used to allow lookups to run in parallel. Identical forward queries that
+   * are outstanding at the same time always share a single lookup.
+   *
+   * @param n The number of threads. The number of threads that are running
+   * is never reduced.
+   *
+   * @note Has no effect on Windows Runtime.
+   */
+  void set_thread_count(std::size_t n)
+  {
+    impl_.get_service().set_thread_count(n);
+  }
+
+#if defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+  /// Enable caching of the results of asynchronous forward resolution.
+  /**
+   * By default, every asynchronous forward resolution performs a new lookup.
+   * This function enables a cache of results that is shared by all resolvers
+   * for the same protocol in the same execution context. Synchronous
+   * resolution and reverse resolution of endpoints are not cached.
+   *
+   * @param positive_duration The time for which a successful result is kept.
+   *
+   * @param negative_duration The time for which the failure of a lookup is
+   * kept, when the failure is because the host or service does not exist.
+   * Other failures are never cached.
+   *
+   * A zero duration disables caching of the corresponding results. Changing
+   * the durations discards all cached results.
+   *
+   * @note Has no effect on Windows Runtime.
+   */
+  template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+  void set_cache_durations(
+      const chrono::duration<Rep1, Period1>& positive_duration,
+      const chrono::duration<Rep2, Period2>& negative_duration)
+  {
+    impl_.get_service().set_cache_durations(
+        static_cast<long>(chrono::duration_cast<
+          chrono::milliseconds>(positive_duration).count()),
+        static_cast<long>(chrono::duration_cast<
+          chrono::milliseconds>(negative_duration).count()));
+  }
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use overload with separate host and service parameters.)
   /// Perform forward resolution of a query to a list of entries.
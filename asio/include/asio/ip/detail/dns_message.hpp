@@ -0,0 +1,110 @@
+//
+// ip/detail/dns_message.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_DNS_MESSAGE_HPP
+#define ASIO_IP_DETAIL_DNS_MESSAGE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "asio/error_code.hpp"
+#include "asio/ip/address.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// Helper class for encoding and decoding the messages exchanged by a DNS stub
+// resolver.
+class dns_message
+{
+public:
+  // The record types that may be queried.
+  enum { type_a = 1, type_aaaa = 28 };
+
+  // The largest message that may be sent or received over UDP.
+  enum { max_udp_size = 512 };
+
+  // Generate a query identifier using the operating system's cryptographically
+  // secure random number generator.
+  ASIO_DECL static unsigned short random_id(asio::error_code& ec);
+
+  // Encode a recursive query for records of the given type.
+  ASIO_DECL static void encode_query(const std::string& name,
+      unsigned short id, unsigned short type,
+      std::vector<unsigned char>& query, asio::error_code& ec);
+
+  // Decode a response to a query. Returns false if the response does not
+  // answer the query. Otherwise, sets the error code to the result of the
+  // query and, unless the response is truncated, adds the addresses found.
+  ASIO_DECL static bool decode_response(
+      const std::vector<unsigned char>& query,
+      const unsigned char* data, std::size_t size, bool& truncated,
+      std::vector<asio::ip::address>& addresses, asio::error_code& ec);
+
+  // Determine whether an error means that the query may succeed if it is sent
+  // to another server.
+  ASIO_DECL static bool is_retryable(const asio::error_code& ec);
+
+private:
+  enum
+  {
+    header_size = 12,
+    flag_response = 0x80,
+    flag_truncated = 0x02,
+    flag_recursion_desired = 0x01,
+    rcode_mask = 0x0F,
+    rcode_name_error = 3,
+    class_in = 1,
+    max_label_size = 63,
+    max_name_size = 255
+  };
+
+  static unsigned short read_u16(const unsigned char* p)
+  {
+    return static_cast<unsigned short>((p[0] << 8) | p[1]);
+  }
+
+  static void write_u16(std::vector<unsigned char>& v, unsigned short n)
+  {
+    v.push_back(static_cast<unsigned char>(n >> 8));
+    v.push_back(static_cast<unsigned char>(n & 0xFF));
+  }
+
+  static unsigned char to_lower(unsigned char c)
+  {
+    return (c >= 'A' && c <= 'Z')
+      ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+  }
+
+  // Skip over a possibly compressed name, returning the offset that follows
+  // it or 0 if the name is malformed.
+  ASIO_DECL static std::size_t skip_name(const unsigned char* data,
+      std::size_t size, std::size_t offset);
+};
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ip/detail/impl/dns_message.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IP_DETAIL_DNS_MESSAGE_HPP
@@ -0,0 +1,550 @@
+//
+// ip/detail/dns_resolve_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_DNS_RESOLVE_OP_HPP
+#define ASIO_IP_DETAIL_DNS_RESOLVE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include <string>
+#include <vector>
+#include "asio/basic_datagram_socket.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/error.hpp"
+#include "asio/ip/basic_resolver_results.hpp"
+#include "asio/ip/detail/dns_message.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/post.hpp"
+#include "asio/read.hpp"
+#include "asio/wait_traits.hpp"
+#include "asio/write.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// A single question sent to the name servers.
+struct dns_query
+{
+  std::vector<unsigned char> message;
+  bool done;
+  bool use_tcp;
+  asio::error_code ec;
+  std::vector<asio::ip::address> addresses;
+};
+
+// The state of a DNS resolve operation, which is shared between the
+// operation and any outstanding timeout.
+template <typename InternetProtocol, typename Executor>
+struct dns_resolve_state
+{
+  typedef basic_resolver_results<InternetProtocol> results_type;
+
+  enum phase_type
+  {
+    starting,
+    completing,
+    receiving,
+    connecting,
+    writing,
+    reading_length,
+    reading_body
+  };
+
+  dns_resolve_state(const Executor& ex)
+    : udp_socket(ex),
+      tcp_socket(ex),
+      timer(ex),
+      phase(starting),
+      port(0),
+      attempts(0),
+      server(0),
+      attempt(0),
+      timer_generation(0),
+      timed_out(false),
+      started(false),
+      tcp_query(0)
+  {
+  }
+
+  basic_datagram_socket<udp, Executor> udp_socket;
+  basic_stream_socket<tcp, Executor> tcp_socket;
+  basic_waitable_timer<chrono::steady_clock,
+    wait_traits<chrono::steady_clock>, Executor> timer;
+
+  phase_type phase;
+  std::string host_name;
+  std::string service_name;
+  unsigned short port;
+  std::vector<udp::endpoint> servers;
+  chrono::steady_clock::duration timeout;
+  int attempts;
+  std::vector<dns_query> queries;
+
+  std::size_t server;
+  int attempt;
+  unsigned int timer_generation;
+  bool timed_out;
+  asio::error_code last_error;
+
+  // Whether an asynchronous operation has been started. Until one has, the
+  // handler must not be invoked directly.
+  bool started;
+
+  std::vector<unsigned char> buffer;
+  udp::endpoint sender;
+  std::size_t tcp_query;
+  unsigned char tcp_length[2];
+
+  asio::error_code result_ec;
+  results_type results;
+};
+
+// Cancels the socket operations of a DNS resolve operation when the server
+// fails to respond in time.
+template <typename InternetProtocol, typename Executor>
+class dns_timeout_handler
+{
+public:
+  dns_timeout_handler(const asio::detail::shared_ptr<
+      dns_resolve_state<InternetProtocol, Executor> >& state,
+      unsigned int generation)
+    : state_(state),
+      generation_(generation)
+  {
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    if (!ec && generation_ == state_->timer_generation)
+    {
+      asio::error_code ignored_ec;
+      state_->timed_out = true;
+      state_->udp_socket.cancel(ignored_ec);
+      state_->tcp_socket.cancel(ignored_ec);
+    }
+  }
+
+private:
+  asio::detail::shared_ptr<
+    dns_resolve_state<InternetProtocol, Executor> > state_;
+  unsigned int generation_;
+};
+
+// Sends the queries to each server in turn until all are answered, switching
+// to TCP for any query whose UDP response is truncated.
+template <typename InternetProtocol, typename Executor>
+class dns_resolve_op
+{
+public:
+  typedef dns_resolve_state<InternetProtocol, Executor> state_type;
+
+  explicit dns_resolve_op(
+      const asio::detail::shared_ptr<state_type>& state)
+    : state_(state)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self,
+      const asio::error_code& ec = asio::error_code(),
+      std::size_t bytes_transferred = 0)
+  {
+    state_type& s = *state_;
+    switch (s.phase)
+    {
+    case state_type::starting:
+      start(self);
+      break;
+    case state_type::completing:
+      self.complete(s.result_ec, s.results);
+      break;
+    case state_type::receiving:
+      on_receive(self, ec, bytes_transferred);
+      break;
+    case state_type::connecting:
+      on_connect(self, ec);
+      break;
+    case state_type::writing:
+      on_write(self, ec);
+      break;
+    case state_type::reading_length:
+      on_read_length(self, ec);
+      break;
+    case state_type::reading_body:
+      on_read_body(self, ec, bytes_transferred);
+      break;
+    }
+  }
+
+private:
+  // Begin the operation. If the result is already known then the operation
+  // is completed as if by post().
+  template <typename Self>
+  void start(Self& self)
+  {
+    state_type& s = *state_;
+    if (s.queries.empty())
+    {
+      s.phase = state_type::completing;
+      asio::post(s.udp_socket.get_executor(), ASIO_MOVE_CAST(Self)(self));
+      return;
+    }
+
+    s.buffer.resize(dns_message::max_udp_size);
+    send_udp(self);
+  }
+
+  // Send the unanswered queries to the current server.
+  template <typename Self>
+  void send_udp(Self& self)
+  {
+    state_type& s = *state_;
+    while (s.attempt < s.attempts)
+    {
+      const udp::endpoint& server = s.servers[s.server];
+      asio::error_code ec;
+      s.udp_socket.close(ec);
+      s.udp_socket.open(server.protocol(), ec);
+
+      // Each attempt uses a new socket bound to an ephemeral port assigned by
+      // the operating system, so that the source port cannot be predicted.
+      if (!ec)
+        s.udp_socket.bind(udp::endpoint(server.protocol(), 0), ec);
+
+      for (std::size_t i = 0; !ec && i < s.queries.size(); ++i)
+      {
+        if (!s.queries[i].done)
+        {
+          s.queries[i].use_tcp = false;
+          s.udp_socket.send_to(asio::buffer(s.queries[i].message),
+              server, 0, ec);
+        }
+      }
+
+      if (!ec)
+      {
+        arm_timer();
+        s.phase = state_type::receiving;
+        s.started = true;
+        s.udp_socket.async_receive_from(asio::buffer(s.buffer),
+            s.sender, ASIO_MOVE_CAST(Self)(self));
+        return;
+      }
+
+      s.last_error = ec;
+      next_server();
+    }
+
+    finish(self);
+  }
+
+  template <typename Self>
+  void on_receive(Self& self, const asio::error_code& ec,
+      std::size_t bytes_transferred)
+  {
+    state_type& s = *state_;
+    if (ec)
+    {
+      fail_server(self, ec);
+      return;
+    }
+
+    // Ignore datagrams that do not come from the server or that do not answer
+    // one of the outstanding queries.
+    bool server_failed = false;
+    if (s.sender == s.servers[s.server])
+    {
+      for (std::size_t i = 0; i < s.queries.size(); ++i)
+      {
+        dns_query& q = s.queries[i];
+        if (q.done || q.use_tcp)
+          continue;
+
+        bool truncated = false;
+        asio::error_code query_ec;
+        std::vector<asio::ip::address> addresses;
+        if (dns_message::decode_response(q.message, &s.buffer[0],
+              bytes_transferred, truncated, addresses, query_ec))
+        {
+          if (dns_message::is_retryable(query_ec))
+          {
+            s.last_error = query_ec;
+            server_failed = true;
+          }
+          else if (truncated)
+            q.use_tcp = true;
+          else
+            answer(q, query_ec, addresses);
+          break;
+        }
+      }
+    }
+
+    if (server_failed)
+    {
+      fail_server(self, s.last_error);
+      return;
+    }
+
+    for (std::size_t i = 0; i < s.queries.size(); ++i)
+    {
+      if (!s.queries[i].done && !s.queries[i].use_tcp)
+      {
+        s.udp_socket.async_receive_from(asio::buffer(s.buffer),
+            s.sender, ASIO_MOVE_CAST(Self)(self));
+        return;
+      }
+    }
+
+    disarm_timer();
+    send_tcp(self);
+  }
+
+  // Send the next query that needs TCP to the current server.
+  template <typename Self>
+  void send_tcp(Self& self)
+  {
+    state_type& s = *state_;
+    for (s.tcp_query = 0; s.tcp_query < s.queries.size(); ++s.tcp_query)
+    {
+      if (!s.queries[s.tcp_query].done)
+      {
+        const udp::endpoint& server = s.servers[s.server];
+        asio::error_code ignored_ec;
+        s.tcp_socket.close(ignored_ec);
+        arm_timer();
+        s.phase = state_type::connecting;
+        s.started = true;
+        s.tcp_socket.async_connect(
+            tcp::endpoint(server.address(), server.port()),
+            ASIO_MOVE_CAST(Self)(self));
+        return;
+      }
+    }
+
+    finish(self);
+  }
+
+  template <typename Self>
+  void on_connect(Self& self, const asio::error_code& ec)
+  {
+    state_type& s = *state_;
+    if (ec)
+    {
+      fail_server(self, ec);
+      return;
+    }
+
+    // Prefix the message with its length.
+    const std::vector<unsigned char>& message = s.queries[s.tcp_query].message;
+    s.buffer.resize(2);
+    s.buffer[0] = static_cast<unsigned char>(message.size() >> 8);
+    s.buffer[1] = static_cast<unsigned char>(message.size() & 0xFF);
+    s.buffer.insert(s.buffer.end(), message.begin(), message.end());
+
+    s.phase = state_type::writing;
+    asio::async_write(s.tcp_socket, asio::buffer(s.buffer),
+        ASIO_MOVE_CAST(Self)(self));
+  }
+
+  template <typename Self>
+  void on_write(Self& self, const asio::error_code& ec)
+  {
+    state_type& s = *state_;
+    if (ec)
+    {
+      fail_server(self, ec);
+      return;
+    }
+
+    s.phase = state_type::reading_length;
+    asio::async_read(s.tcp_socket, asio::buffer(s.tcp_length),
+        ASIO_MOVE_CAST(Self)(self));
+  }
+
+  template <typename Self>
+  void on_read_length(Self& self, const asio::error_code& ec)
+  {
+    state_type& s = *state_;
+    std::size_t length = (s.tcp_length[0] << 8) | s.tcp_length[1];
+    if (ec || length == 0)
+    {
+      fail_server(self, ec ? ec : asio::error::no_recovery);
+      return;
+    }
+
+    s.buffer.resize(length);
+    s.phase = state_type::reading_body;
+    asio::async_read(s.tcp_socket, asio::buffer(s.buffer),
+        ASIO_MOVE_CAST(Self)(self));
+  }
+
+  template <typename Self>
+  void on_read_body(Self& self, const asio::error_code& ec,
+      std::size_t bytes_transferred)
+  {
+    state_type& s = *state_;
+    if (ec)
+    {
+      fail_server(self, ec);
+      return;
+    }
+
+    disarm_timer();
+    asio::error_code ignored_ec;
+    s.tcp_socket.close(ignored_ec);
+
+    dns_query& q = s.queries[s.tcp_query];
+    bool truncated = false;
+    asio::error_code query_ec;
+    std::vector<asio::ip::address> addresses;
+    if (!dns_message::decode_response(q.message, &s.buffer[0],
+          bytes_transferred, truncated, addresses, query_ec))
+      query_ec = asio::error::no_recovery;
+    else if (truncated && !query_ec)
+      query_ec = asio::error::message_size;
+
+    if (dns_message::is_retryable(query_ec))
+    {
+      fail_server(self, query_ec);
+      return;
+    }
+
+    answer(q, query_ec, addresses);
+    send_tcp(self);
+  }
+
+  // Abandon the current server and try the next one.
+  template <typename Self>
+  void fail_server(Self& self, const asio::error_code& ec)
+  {
+    state_type& s = *state_;
+    s.last_error = s.timed_out ? asio::error::timed_out : ec;
+    disarm_timer();
+    asio::error_code ignored_ec;
+    s.tcp_socket.close(ignored_ec);
+    next_server();
+    s.buffer.resize(dns_message::max_udp_size);
+    send_udp(self);
+  }
+
+  // Complete the operation with the answers that have been received.
+  template <typename Self>
+  void finish(Self& self)
+  {
+    state_type& s = *state_;
+    disarm_timer();
+    asio::error_code ignored_ec;
+    s.udp_socket.close(ignored_ec);
+    s.tcp_socket.close(ignored_ec);
+
+    // Any address found means success. Otherwise, report that the name does
+    // not exist, that a server failed, or that there are no addresses, in
+    // that order of precedence.
+    std::vector<typename InternetProtocol::endpoint> endpoints;
+    asio::error_code failure_ec;
+    asio::error_code answer_ec;
+    for (std::size_t i = 0; i < s.queries.size(); ++i)
+    {
+      const dns_query& q = s.queries[i];
+      for (std::size_t j = 0; j < q.addresses.size(); ++j)
+      {
+        endpoints.push_back(typename InternetProtocol::endpoint(
+              q.addresses[j], s.port));
+      }
+
+      if (!q.done)
+        failure_ec = s.last_error ? s.last_error : asio::error::timed_out;
+      else if (q.ec && (!answer_ec || q.ec == asio::error::host_not_found))
+        answer_ec = q.ec;
+    }
+
+    if (!endpoints.empty())
+    {
+      s.result_ec = asio::error_code();
+      s.results = basic_resolver_results<InternetProtocol>::create(
+          endpoints.begin(), endpoints.end(), s.host_name, s.service_name);
+    }
+    else if (answer_ec == asio::error::host_not_found || !failure_ec)
+      s.result_ec = answer_ec ? answer_ec : asio::error::no_data;
+    else
+      s.result_ec = failure_ec;
+
+    // If every attempt failed without starting an asynchronous operation then
+    // we are still within the initiating function, so the handler is invoked
+    // as if by post().
+    s.phase = state_type::completing;
+    if (s.started)
+      self.complete(s.result_ec, s.results);
+    else
+      asio::post(s.udp_socket.get_executor(), ASIO_MOVE_CAST(Self)(self));
+  }
+
+  static void answer(dns_query& q, const asio::error_code& ec,
+      const std::vector<asio::ip::address>& addresses)
+  {
+    q.done = true;
+    q.use_tcp = false;
+    q.ec = ec;
+    q.addresses = addresses;
+  }
+
+  void next_server()
+  {
+    state_type& s = *state_;
+    if (++s.server == s.servers.size())
+    {
+      s.server = 0;
+      ++s.attempt;
+    }
+  }
+
+  void arm_timer()
+  {
+    state_type& s = *state_;
+    s.timed_out = false;
+    s.timer.expires_after(s.timeout);
+    s.timer.async_wait(dns_timeout_handler<InternetProtocol, Executor>(
+          state_, ++s.timer_generation));
+  }
+
+  void disarm_timer()
+  {
+    state_type& s = *state_;
+    ++s.timer_generation;
+    s.timer.cancel();
+  }
+
+  asio::detail::shared_ptr<state_type> state_;
+};
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+#endif // ASIO_IP_DETAIL_DNS_RESOLVE_OP_HPP
@@ -0,0 +1,240 @@
+//
+// ip/detail/impl/dns_message.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_IMPL_DNS_MESSAGE_IPP
+#define ASIO_IP_DETAIL_IMPL_DNS_MESSAGE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_WINDOWS)
+# include <random>
+#else // defined(ASIO_WINDOWS)
+# include <cerrno>
+# include <fcntl.h>
+# include <unistd.h>
+#endif // defined(ASIO_WINDOWS)
+
+#include "asio/error.hpp"
+#include "asio/ip/address_v4.hpp"
+#include "asio/ip/address_v6.hpp"
+#include "asio/ip/detail/dns_message.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+unsigned short dns_message::random_id(asio::error_code& ec)
+{
+#if defined(ASIO_WINDOWS)
+  std::random_device device;
+  ec = asio::error_code();
+  return static_cast<unsigned short>(device() & 0xFFFF);
+#else // defined(ASIO_WINDOWS)
+  unsigned char bytes[2] = { 0, 0 };
+  int result = -1;
+  int fd = ::open("/dev/urandom", O_RDONLY);
+  if (fd != -1)
+  {
+    do
+      result = static_cast<int>(::read(fd, bytes, sizeof(bytes)));
+    while (result == -1 && errno == EINTR);
+  }
+
+  if (result == static_cast<int>(sizeof(bytes)))
+    ec = asio::error_code();
+  else if (result == -1)
+    ec = asio::error_code(errno, asio::error::get_system_category());
+  else
+    ec = asio::error::no_recovery;
+
+  if (fd != -1)
+    ::close(fd);
+
+  return read_u16(bytes);
+#endif // defined(ASIO_WINDOWS)
+}
+
+std::size_t dns_message::skip_name(const unsigned char* data,
+    std::size_t size, std::size_t offset)
+{
+  while (offset < size)
+  {
+    unsigned char length = data[offset];
+    if (length == 0)
+      return offset + 1;
+    if ((length & 0xC0) == 0xC0)
+      return offset + 2 <= size ? offset + 2 : 0;
+    if ((length & 0xC0) != 0)
+      return 0;
+    offset += 1 + length;
+  }
+  return 0;
+}
+
+void dns_message::encode_query(const std::string& name,
+    unsigned short id, unsigned short type,
+    std::vector<unsigned char>& query, asio::error_code& ec)
+{
+  query.clear();
+  query.reserve(header_size + name.size() + 6);
+
+  write_u16(query, id);
+  query.push_back(flag_recursion_desired);
+  query.push_back(0);
+  write_u16(query, 1); // Question count.
+  write_u16(query, 0); // Answer count.
+  write_u16(query, 0); // Authority count.
+  write_u16(query, 0); // Additional count.
+
+  // Encode the name as a sequence of labels. A single trailing dot is
+  // permitted, but empty labels are not.
+  std::size_t start = 0;
+  std::size_t end = name.size();
+  if (end > 0 && name[end - 1] == '.')
+    --end;
+  if (end == 0 || end + 2 > max_name_size)
+  {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+  while (start <= end)
+  {
+    std::size_t dot = name.find('.', start);
+    if (dot == std::string::npos || dot > end)
+      dot = end;
+    std::size_t length = dot - start;
+    if (length == 0 || length > max_label_size)
+    {
+      ec = asio::error::invalid_argument;
+      return;
+    }
+    query.push_back(static_cast<unsigned char>(length));
+    query.insert(query.end(), name.begin() + start, name.begin() + dot);
+    start = dot + 1;
+  }
+  query.push_back(0);
+
+  write_u16(query, type);
+  write_u16(query, class_in);
+
+  ec = asio::error_code();
+}
+
+bool dns_message::decode_response(const std::vector<unsigned char>& query,
+    const unsigned char* data, std::size_t size, bool& truncated,
+    std::vector<asio::ip::address>& addresses, asio::error_code& ec)
+{
+  // The response must have the same ID and repeat the question, with the
+  // name compared without regard to case.
+  if (query.size() < header_size + 5 || size < query.size()
+      || data[0] != query[0] || data[1] != query[1]
+      || (data[2] & flag_response) == 0 || read_u16(data + 4) != 1)
+    return false;
+
+  std::size_t question_end = query.size();
+  for (std::size_t i = header_size; i < question_end - 4; ++i)
+    if (to_lower(data[i]) != to_lower(query[i]))
+      return false;
+  for (std::size_t i = question_end - 4; i < question_end; ++i)
+    if (data[i] != query[i])
+      return false;
+
+  truncated = (data[2] & flag_truncated) != 0;
+
+  int rcode = data[3] & rcode_mask;
+  if (rcode == rcode_name_error)
+  {
+    ec = asio::error::host_not_found;
+    return true;
+  }
+  else if (rcode != 0)
+  {
+    ec = asio::error::host_not_found_try_again;
+    return true;
+  }
+
+  ec = asio::error_code();
+  if (truncated)
+    return true;
+
+  // Collect the addresses from the answer records of the requested type,
+  // which may follow a chain of CNAME records.
+  unsigned short type = read_u16(&query[question_end - 4]);
+  std::size_t answers = read_u16(data + 6);
+  std::size_t offset = question_end;
+  std::size_t found = 0;
+  for (std::size_t i = 0; i < answers; ++i)
+  {
+    offset = skip_name(data, size, offset);
+    if (offset == 0 || offset + 10 > size)
+    {
+      ec = asio::error::no_recovery;
+      return true;
+    }
+
+    unsigned short record_type = read_u16(data + offset);
+    unsigned short record_class = read_u16(data + offset + 2);
+    std::size_t length = read_u16(data + offset + 8);
+    offset += 10;
+    if (offset + length > size)
+    {
+      ec = asio::error::no_recovery;
+      return true;
+    }
+
+    if (record_class == class_in && record_type == type)
+    {
+      if (type == type_a && length == 4)
+      {
+        asio::ip::address_v4::bytes_type bytes;
+        for (std::size_t j = 0; j < 4; ++j)
+          bytes[j] = data[offset + j];
+        addresses.push_back(asio::ip::address_v4(bytes));
+        ++found;
+      }
+      else if (type == type_aaaa && length == 16)
+      {
+        asio::ip::address_v6::bytes_type bytes;
+        for (std::size_t j = 0; j < 16; ++j)
+          bytes[j] = data[offset + j];
+        addresses.push_back(asio::ip::address_v6(bytes));
+        ++found;
+      }
+    }
+
+    offset += length;
+  }
+
+  if (found == 0)
+    ec = asio::error::no_data;
+  return true;
+}
+
+bool dns_message::is_retryable(const asio::error_code& ec)
+{
+  return ec && ec != asio::error::host_not_found
+    && ec != asio::error::no_data && ec != asio::error::invalid_argument
+    && ec != asio::error::operation_aborted;
+}
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_IMPL_DNS_MESSAGE_IPP
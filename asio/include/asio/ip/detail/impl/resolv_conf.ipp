@@ -0,0 +1,121 @@
+//
+// ip/detail/impl/resolv_conf.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_IMPL_RESOLV_CONF_IPP
+#define ASIO_IP_DETAIL_IMPL_RESOLV_CONF_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include "asio/error.hpp"
+#include "asio/ip/detail/resolv_conf.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+resolv_conf::resolv_conf()
+  : nameservers(1, asio::ip::address(asio::ip::address_v4::loopback())),
+    timeout(5),
+    attempts(2)
+{
+}
+
+void resolv_conf::load(const char* path, asio::error_code& ec)
+{
+  std::FILE* file = std::fopen(path, "r");
+  if (!file)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return;
+  }
+
+  std::string text;
+  char buffer[1024];
+  while (std::size_t n = std::fread(buffer, 1, sizeof(buffer), file))
+    text.append(buffer, n);
+  std::fclose(file);
+
+  parse(text);
+  ec = asio::error_code();
+}
+
+void resolv_conf::parse(const std::string& text)
+{
+  nameservers.clear();
+  timeout = 5;
+  attempts = 2;
+
+  const char* whitespace = " \t\r";
+  std::size_t line_start = 0;
+  while (line_start < text.size())
+  {
+    std::size_t line_end = text.find('\n', line_start);
+    if (line_end == std::string::npos)
+      line_end = text.size();
+
+    // Split the line into whitespace-separated words, ignoring comments.
+    std::string line = text.substr(line_start, line_end - line_start);
+    line = line.substr(0, line.find_first_of("#;"));
+    std::vector<std::string> words;
+    std::size_t word_start = line.find_first_not_of(whitespace);
+    while (word_start != std::string::npos)
+    {
+      std::size_t word_end = line.find_first_of(whitespace, word_start);
+      words.push_back(line.substr(word_start, word_end - word_start));
+      word_start = line.find_first_not_of(whitespace, word_end);
+    }
+
+    if (words.size() >= 2 && words[0] == "nameserver")
+    {
+      asio::error_code ec;
+      asio::ip::address address = asio::ip::make_address(words[1], ec);
+      if (!ec && nameservers.size() < max_nameservers)
+        nameservers.push_back(address);
+    }
+    else if (!words.empty() && words[0] == "options")
+    {
+      for (std::size_t i = 1; i < words.size(); ++i)
+      {
+        if (words[i].compare(0, 8, "timeout:") == 0)
+        {
+          int n = std::atoi(words[i].c_str() + 8);
+          timeout = n < 1 ? 1 : (n > max_timeout ? max_timeout : n);
+        }
+        else if (words[i].compare(0, 9, "attempts:") == 0)
+        {
+          int n = std::atoi(words[i].c_str() + 9);
+          attempts = n < 1 ? 1 : (n > max_attempts ? max_attempts : n);
+        }
+      }
+    }
+
+    line_start = line_end + 1;
+  }
+
+  // Use a server on the local machine if none is specified.
+  if (nameservers.empty())
+    nameservers.push_back(asio::ip::address_v4::loopback());
+}
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_IMPL_RESOLV_CONF_IPP
@@ -0,0 +1,67 @@
+//
+// ip/detail/resolv_conf.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_DETAIL_RESOLV_CONF_HPP
+#define ASIO_IP_DETAIL_RESOLV_CONF_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <string>
+#include <vector>
+#include "asio/error_code.hpp"
+#include "asio/ip/address.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// The configuration of a DNS stub resolver, in the form used by resolv.conf.
+class resolv_conf
+{
+public:
+  // Construct with the defaults that apply when there is no configuration.
+  ASIO_DECL resolv_conf();
+
+  // Replace the configuration with that read from the named file. The
+  // configuration is unchanged if the file cannot be read.
+  ASIO_DECL void load(const char* path, asio::error_code& ec);
+
+  // Replace the configuration with that given by the text of a file.
+  ASIO_DECL void parse(const std::string& text);
+
+  // The addresses of the name servers.
+  std::vector<asio::ip::address> nameservers;
+
+  // The time to wait for a response from a server, in seconds.
+  int timeout;
+
+  // The number of times to try each server.
+  int attempts;
+
+private:
+  enum { max_nameservers = 3, max_timeout = 30, max_attempts = 5 };
+};
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ip/detail/impl/resolv_conf.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IP_DETAIL_RESOLV_CONF_HPP
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/basic_datagram_socket.hpp"
+#include "asio/detail/socket_option.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_endpoint.hpp"
 #include "asio/ip/basic_resolver.hpp"
@@ -81,6 +82,84 @@ public:
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
+#if defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the default segment size used when sending.
+  /**
+   * Implements the IPPROTO_UDP/UDP_SEGMENT socket option. When the value is
+   * non-zero, the kernel divides each send into datagrams of this size. A
+   * segment size given to basic_datagram_socket::send_to_segmented()
+   * overrides this value for a single send.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::segment_size option(1200);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::segment_size option;
+   * socket.get_option(option);
+   * int size = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   *
+   * @note Only available on Linux.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined segment_size;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_UDP), ASIO_OS_DEF(UDP_SEGMENT)> segment_size;
+#endif
+
+  /// Socket option to permit the kernel to coalesce received datagrams.
+  /**
+   * Implements the IPPROTO_UDP/UDP_GRO socket option. When enabled, datagrams
+   * of equal size from the same sender may be delivered by a single receive.
+   * Use basic_datagram_socket::receive_from_segmented() to obtain the size
+   * of the coalesced segments.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::generic_receive_offload option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::generic_receive_offload option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   *
+   * @note Only available on Linux.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined generic_receive_offload;
+#else
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_UDP), ASIO_OS_DEF(UDP_GRO)> generic_receive_offload;
+#endif
+#endif // defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two protocols for equality.
   friend bool operator==(const udp& p1, const udp& p2)
   {
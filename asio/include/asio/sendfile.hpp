@@ -0,0 +1,360 @@
+//
+// sendfile.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SENDFILE_HPP
+#define ASIO_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/error.hpp"
+#include "asio/posix/basic_stream_descriptor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup sendfile asio::sendfile
+ *
+ * @brief The @c sendfile function is a composed operation that writes a
+ * certain amount of data from a file to a stream socket before returning.
+ */
+/*@{*/
+
+/// Write a range of a file to a stream socket before returning.
+/**
+ * This function is used to write a certain number of bytes of data from a file
+ * to a stream socket, without copying the data through user memory. The call
+ * will block until one of the following conditions is true:
+ *
+ * @li The requested number of bytes has been written.
+ *
+ * @li An error occurred. An error code of asio::error::eof indicates
+ * that the end of the file was reached.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's sendfile_some function.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param file The file from which the data is read. The descriptor's file
+ * position is neither used nor changed.
+ *
+ * @param offset The offset within the file at which to start.
+ *
+ * @param count The number of bytes to write.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws asio::system_error Thrown on failure.
+ *
+ * @note This overload is equivalent to calling:
+ * @code asio::sendfile(
+ *     s, file, offset, count,
+ *     asio::transfer_all()); @endcode
+ */
+template <typename Protocol, typename Executor, typename FileExecutor>
+std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count);
+
+/// Write a range of a file to a stream socket before returning.
+/**
+ * This function is used to write a certain number of bytes of data from a file
+ * to a stream socket, without copying the data through user memory. The call
+ * will block until one of the following conditions is true:
+ *
+ * @li The requested number of bytes has been written.
+ *
+ * @li An error occurred. An error code of asio::error::eof indicates
+ * that the end of the file was reached.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's sendfile_some function.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param file The file from which the data is read. The descriptor's file
+ * position is neither used nor changed.
+ *
+ * @param offset The offset within the file at which to start.
+ *
+ * @param count The number of bytes to write.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @note This overload is equivalent to calling:
+ * @code asio::sendfile(
+ *     s, file, offset, count,
+ *     asio::transfer_all(), ec); @endcode
+ */
+template <typename Protocol, typename Executor, typename FileExecutor>
+std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count, asio::error_code& ec);
+
+/// Write a range of a file to a stream socket before returning.
+/**
+ * This function is used to write a certain number of bytes of data from a file
+ * to a stream socket, without copying the data through user memory. The call
+ * will block until one of the following conditions is true:
+ *
+ * @li The requested number of bytes has been written.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's sendfile_some function.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param file The file from which the data is read. The descriptor's file
+ * position is neither used nor changed.
+ *
+ * @param offset The offset within the file at which to start.
+ *
+ * @param count The maximum number of bytes to write.
+ *
+ * @param completion_condition The function object to be called to determine
+ * whether the write operation is complete. The signature of the function object
+ * must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest sendfile_some operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the write operation is complete. A
+ * non-zero return value indicates the maximum number of bytes to be written on
+ * the next call to the socket's sendfile_some function.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename Protocol, typename Executor, typename FileExecutor,
+    typename CompletionCondition>
+std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    CompletionCondition completion_condition);
+
+/// Write a range of a file to a stream socket before returning.
+/**
+ * This function is used to write a certain number of bytes of data from a file
+ * to a stream socket, without copying the data through user memory. The call
+ * will block until one of the following conditions is true:
+ *
+ * @li The requested number of bytes has been written.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's sendfile_some function.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param file The file from which the data is read. The descriptor's file
+ * position is neither used nor changed.
+ *
+ * @param offset The offset within the file at which to start.
+ *
+ * @param count The maximum number of bytes to write.
+ *
+ * @param completion_condition The function object to be called to determine
+ * whether the write operation is complete. The signature of the function object
+ * must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest sendfile_some operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the write operation is complete. A
+ * non-zero return value indicates the maximum number of bytes to be written on
+ * the next call to the socket's sendfile_some function.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes transferred.
+ */
+template <typename Protocol, typename Executor, typename FileExecutor,
+    typename CompletionCondition>
+std::size_t sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    CompletionCondition completion_condition, asio::error_code& ec);
+
+/*@}*/
+/**
+ * @defgroup async_sendfile asio::async_sendfile
+ *
+ * @brief The @c async_sendfile function is a composed asynchronous operation
+ * that writes a certain amount of data from a file to a stream socket before
+ * completion.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to write a range of a file to a stream
+/// socket.
+/**
+ * This function is used to asynchronously write a certain number of bytes of
+ * data from a file to a stream socket, without copying the data through user
+ * memory. The function call always returns immediately. The asynchronous
+ * operation will continue until one of the following conditions is true:
+ *
+ * @li The requested number of bytes has been written.
+ *
+ * @li An error occurred. An error code of asio::error::eof indicates
+ * that the end of the file was reached.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's async_sendfile_some function, and is known as a <em>composed
+ * operation</em>. The program must ensure that the socket performs no other
+ * write operations until this operation completes.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param file The file from which the data is read. The descriptor must remain
+ * open until the handler is called. Its file position is neither used nor
+ * changed.
+ *
+ * @param offset The offset within the file at which to start.
+ *
+ * @param count The number of bytes to write.
+ *
+ * @param handler The handler to be called when the write operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes written from the
+ *                                           // file. If an error occurred,
+ *                                           // this will be less than count.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Example
+ * @code
+ * asio::posix::stream_descriptor file(io_context,
+ *     ::open("index.html", O_RDONLY));
+ * asio::async_sendfile(socket, file, 0, file_size, handler);
+ * @endcode
+ */
+template <typename Protocol, typename Executor, typename FileExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    ASIO_MOVE_ARG(WriteHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor));
+
+/// Start an asynchronous operation to write a range of a file to a stream
+/// socket.
+/**
+ * This function is used to asynchronously write a certain number of bytes of
+ * data from a file to a stream socket, without copying the data through user
+ * memory. The function call always returns immediately. The asynchronous
+ * operation will continue until one of the following conditions is true:
+ *
+ * @li The requested number of bytes has been written.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * This operation is implemented in terms of zero or more calls to the
+ * socket's async_sendfile_some function, and is known as a <em>composed
+ * operation</em>. The program must ensure that the socket performs no other
+ * write operations until this operation completes.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param file The file from which the data is read. The descriptor must remain
+ * open until the handler is called. Its file position is neither used nor
+ * changed.
+ *
+ * @param offset The offset within the file at which to start.
+ *
+ * @param count The maximum number of bytes to write.
+ *
+ * @param completion_condition The function object to be called to determine
+ * whether the write operation is complete. The signature of the function object
+ * must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest async_sendfile_some operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the write operation is complete. A
+ * non-zero return value indicates the maximum number of bytes to be written on
+ * the next call to the socket's async_sendfile_some function.
+ *
+ * @param handler The handler to be called when the write operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes written from the
+ *                                           // file.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ */
+template <typename Protocol, typename Executor, typename FileExecutor,
+    typename CompletionCondition,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_sendfile(basic_stream_socket<Protocol, Executor>& s,
+    posix::basic_stream_descriptor<FileExecutor>& file,
+    uint64_t offset, std::size_t count,
+    CompletionCondition completion_condition,
+    ASIO_MOVE_ARG(WriteHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor));
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/sendfile.hpp"
+
+#endif // defined(ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SENDFILE_HPP
@@ -225,6 +225,49 @@ public:
     ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_KEEPALIVE)> keep_alive;
 #endif
 
+#if defined(ASIO_HAS_SO_BUSY_POLL) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the time for which a blocking receive busy polls the
+  /// device queue.
+  /**
+   * Implements the SOL_SOCKET/SO_BUSY_POLL socket option. The value is the
+   * number of microseconds for which the kernel polls the network device for
+   * new packets when the socket has none, rather than waiting for an
+   * interrupt.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::busy_poll option(50);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::busy_poll option;
+   * socket.get_option(option);
+   * int usec = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   *
+   * @note Only available on Linux. Increasing the value beyond its default,
+   * the @c net.core.busy_read setting, requires the @c CAP_NET_ADMIN
+   * capability.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined busy_poll;
+#else
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_BUSY_POLL)> busy_poll;
+#endif
+#endif // defined(ASIO_HAS_SO_BUSY_POLL) || defined(GENERATING_DOCUMENTATION)
+
   /// Socket option for the send buffer size of a socket.
   /**
    * Implements the SOL_SOCKET/SO_SNDBUF socket option.
@@ -0,0 +1,332 @@
+//
+// splice.hpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SPLICE_HPP
+#define ASIO_SPLICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SPLICE) || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/error.hpp"
+#include "asio/posix/basic_stream_descriptor.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup splice asio::splice
+ *
+ * @brief The @c splice function is a composed operation that moves a certain
+ * amount of data between a stream socket and a pipe, or between two stream
+ * sockets, before returning.
+ *
+ * The data is moved within the kernel, without being copied through user
+ * memory. The supported combinations of source and sink are:
+ *
+ * @li A @c basic_stream_socket and a @c posix::basic_stream_descriptor that
+ * refers to the write end of a pipe.
+ *
+ * @li A @c posix::basic_stream_descriptor that refers to the read end of a
+ * pipe and a @c basic_stream_socket.
+ *
+ * @li Two @c basic_stream_socket objects. The data is moved through an
+ * intermediate pipe that is owned by the operation.
+ */
+/*@{*/
+
+/// Move data from a source to a sink before returning.
+/**
+ * This function is used to move a certain number of bytes of data from a
+ * source to a sink. The call will block until one of the following conditions
+ * is true:
+ *
+ * @li The requested number of bytes has been moved.
+ *
+ * @li An error occurred. An error code of asio::error::eof indicates
+ * that the source has no more data.
+ *
+ * @param from The stream socket or pipe from which the data is read.
+ *
+ * @param to The stream socket or pipe to which the data is written.
+ *
+ * @param count The number of bytes to move.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws asio::system_error Thrown on failure.
+ *
+ * @note This overload is equivalent to calling:
+ * @code asio::splice(
+ *     from, to, count,
+ *     asio::transfer_all()); @endcode
+ */
+template <typename SyncSource, typename SyncSink>
+std::size_t splice(SyncSource& from, SyncSink& to, std::size_t count);
+
+/// Move data from a source to a sink before returning.
+/**
+ * This function is used to move a certain number of bytes of data from a
+ * source to a sink. The call will block until one of the following conditions
+ * is true:
+ *
+ * @li The requested number of bytes has been moved.
+ *
+ * @li An error occurred. An error code of asio::error::eof indicates
+ * that the source has no more data.
+ *
+ * @param from The stream socket or pipe from which the data is read.
+ *
+ * @param to The stream socket or pipe to which the data is written.
+ *
+ * @param count The number of bytes to move.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @note This overload is equivalent to calling:
+ * @code asio::splice(
+ *     from, to, count,
+ *     asio::transfer_all(), ec); @endcode
+ */
+template <typename SyncSource, typename SyncSink>
+std::size_t splice(SyncSource& from, SyncSink& to,
+    std::size_t count, asio::error_code& ec);
+
+/// Move data from a source to a sink before returning.
+/**
+ * This function is used to move a certain number of bytes of data from a
+ * source to a sink. The call will block until one of the following conditions
+ * is true:
+ *
+ * @li The requested number of bytes has been moved.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * @param from The stream socket or pipe from which the data is read.
+ *
+ * @param to The stream socket or pipe to which the data is written.
+ *
+ * @param count The maximum number of bytes to move.
+ *
+ * @param completion_condition The function object to be called to determine
+ * whether the operation is complete. The signature of the function object
+ * must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest step of the operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the operation is complete. A non-zero
+ * return value indicates the maximum number of bytes to be moved by the next
+ * step of the operation.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename SyncSource, typename SyncSink,
+    typename CompletionCondition>
+std::size_t splice(SyncSource& from, SyncSink& to, std::size_t count,
+    CompletionCondition completion_condition);
+
+/// Move data from a source to a sink before returning.
+/**
+ * This function is used to move a certain number of bytes of data from a
+ * source to a sink. The call will block until one of the following conditions
+ * is true:
+ *
+ * @li The requested number of bytes has been moved.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * @param from The stream socket or pipe from which the data is read.
+ *
+ * @param to The stream socket or pipe to which the data is written.
+ *
+ * @param count The maximum number of bytes to move.
+ *
+ * @param completion_condition The function object to be called to determine
+ * whether the operation is complete. The signature of the function object
+ * must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest step of the operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the operation is complete. A non-zero
+ * return value indicates the maximum number of bytes to be moved by the next
+ * step of the operation.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes transferred.
+ */
+template <typename SyncSource, typename SyncSink,
+    typename CompletionCondition>
+std::size_t splice(SyncSource& from, SyncSink& to, std::size_t count,
+    CompletionCondition completion_condition, asio::error_code& ec);
+
+/*@}*/
+/**
+ * @defgroup async_splice asio::async_splice
+ *
+ * @brief The @c async_splice function is a composed asynchronous operation
+ * that moves a certain amount of data between a stream socket and a pipe, or
+ * between two stream sockets, before completion.
+ *
+ * The supported combinations of source and sink are the same as for the
+ * @ref splice function.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to move data from a source to a sink.
+/**
+ * This function is used to asynchronously move a certain number of bytes of
+ * data from a source to a sink. The function call always returns immediately.
+ * The asynchronous operation will continue until one of the following
+ * conditions is true:
+ *
+ * @li The requested number of bytes has been moved.
+ *
+ * @li An error occurred. An error code of asio::error::eof indicates
+ * that the source has no more data.
+ *
+ * This operation is known as a <em>composed operation</em>. The program must
+ * ensure that the source performs no other read operations, and the sink no
+ * other write operations, until this operation completes.
+ *
+ * @param from The stream socket or pipe from which the data is read.
+ *
+ * @param to The stream socket or pipe to which the data is written.
+ *
+ * @param count The number of bytes to move.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes written to the
+ *                                           // sink.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Example
+ * To forward all data from one socket to another until the connection is
+ * closed:
+ * @code
+ * asio::async_splice(client_socket, server_socket,
+ *     std::numeric_limits<std::size_t>::max(), handler);
+ * @endcode
+ */
+template <typename AsyncSource, typename AsyncSink,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SpliceHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename AsyncSource::executor_type)>
+ASIO_INITFN_AUTO_RESULT_TYPE(SpliceHandler,
+    void (asio::error_code, std::size_t))
+async_splice(AsyncSource& from, AsyncSink& to, std::size_t count,
+    ASIO_MOVE_ARG(SpliceHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename AsyncSource::executor_type));
+
+/// Start an asynchronous operation to move data from a source to a sink.
+/**
+ * This function is used to asynchronously move a certain number of bytes of
+ * data from a source to a sink. The function call always returns immediately.
+ * The asynchronous operation will continue until one of the following
+ * conditions is true:
+ *
+ * @li The requested number of bytes has been moved.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * This operation is known as a <em>composed operation</em>. The program must
+ * ensure that the source performs no other read operations, and the sink no
+ * other write operations, until this operation completes.
+ *
+ * @param from The stream socket or pipe from which the data is read.
+ *
+ * @param to The stream socket or pipe to which the data is written.
+ *
+ * @param count The maximum number of bytes to move.
+ *
+ * @param completion_condition The function object to be called to determine
+ * whether the operation is complete. The signature of the function object
+ * must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest step of the operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the operation is complete. A non-zero
+ * return value indicates the maximum number of bytes to be moved by the next
+ * step of the operation.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes written to the
+ *                                           // sink.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ */
+template <typename AsyncSource, typename AsyncSink,
+    typename CompletionCondition,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) SpliceHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename AsyncSource::executor_type)>
+ASIO_INITFN_AUTO_RESULT_TYPE(SpliceHandler,
+    void (asio::error_code, std::size_t))
+async_splice(AsyncSource& from, AsyncSink& to, std::size_t count,
+    CompletionCondition completion_condition,
+    ASIO_MOVE_ARG(SpliceHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename AsyncSource::executor_type));
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/splice.hpp"
+
+#endif // defined(ASIO_HAS_SPLICE) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SPLICE_HPP
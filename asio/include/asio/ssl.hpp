@@ -20,6 +20,7 @@
 #include "asio/ssl/error.hpp"
 #include "asio/ssl/rfc2818_verification.hpp"
 #include "asio/ssl/host_name_verification.hpp"
+#include "asio/ssl/session_cache.hpp"
 #include "asio/ssl/stream.hpp"
 #include "asio/ssl/stream_base.hpp"
 #include "asio/ssl/verify_context.hpp"
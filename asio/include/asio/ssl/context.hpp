@@ -25,6 +25,7 @@
 #include "asio/ssl/detail/openssl_init.hpp"
 #include "asio/ssl/detail/password_callback.hpp"
 #include "asio/ssl/detail/verify_callback.hpp"
+#include "asio/ssl/session_cache.hpp"
 #include "asio/ssl/verify_mode.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -244,6 +245,110 @@ public:
   ASIO_SYNC_OP_VOID set_verify_callback(VerifyCallback callback,
       asio::error_code& ec);
 
+  /// Enable or disable kernel TLS offload for streams using the context.
+  /**
+   * When enabled, a stream whose next layer is a TCP socket attempts to hand
+   * record protection to the operating system once its handshake completes.
+   * Subsequent reads and writes then bypass the SSL engine, and data may be
+   * transferred using ordinary socket operations. If the session's protocol
+   * version or cipher suite is not supported by the kernel, the stream
+   * continues to use the SSL engine.
+   *
+   * Only TLS 1.2 and TLS 1.3 sessions using AES-GCM or ChaCha20-Poly1305 may
+   * be offloaded. Enabling offload installs a key logging callback, disables
+   * renegotiation, and prevents a server from sending TLS 1.3 session
+   * tickets. Any key logging callback that the context already had is still
+   * called for each line. Disabling offload restores the key logging callback,
+   * renegotiation and session ticket settings that the context had when
+   * offload was enabled. A key logging callback installed while offload is
+   * enabled prevents TLS 1.3 sessions from being offloaded, until offload is
+   * enabled again. A shutdown of an offloaded stream sends a close_notify
+   * alert but does not wait for the peer's alert.
+   *
+   * @param enabled Whether offload should be attempted.
+   *
+   * @throws asio::system_error Thrown on failure. The error
+   * asio::error::operation_not_supported is reported if kernel TLS is not
+   * available on the platform.
+   *
+   * @note Calls @c SSL_CTX_set_keylog_callback.
+   */
+  ASIO_DECL void set_kernel_tls(bool enabled);
+
+  /// Enable or disable kernel TLS offload for streams using the context.
+  /**
+   * When enabled, a stream whose next layer is a TCP socket attempts to hand
+   * record protection to the operating system once its handshake completes.
+   * Subsequent reads and writes then bypass the SSL engine, and data may be
+   * transferred using ordinary socket operations. If the session's protocol
+   * version or cipher suite is not supported by the kernel, the stream
+   * continues to use the SSL engine.
+   *
+   * Only TLS 1.2 and TLS 1.3 sessions using AES-GCM or ChaCha20-Poly1305 may
+   * be offloaded. Enabling offload installs a key logging callback, disables
+   * renegotiation, and prevents a server from sending TLS 1.3 session
+   * tickets. Any key logging callback that the context already had is still
+   * called for each line. Disabling offload restores the key logging callback,
+   * renegotiation and session ticket settings that the context had when
+   * offload was enabled. A key logging callback installed while offload is
+   * enabled prevents TLS 1.3 sessions from being offloaded, until offload is
+   * enabled again. A shutdown of an offloaded stream sends a close_notify
+   * alert but does not wait for the peer's alert.
+   *
+   * @param enabled Whether offload should be attempted.
+   *
+   * @param ec Set to indicate what error occurred, if any. The error
+   * asio::error::operation_not_supported is reported if kernel TLS is not
+   * available on the platform.
+   *
+   * @note Calls @c SSL_CTX_set_keylog_callback.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_kernel_tls(
+      bool enabled, asio::error_code& ec);
+
+  /// Use a session cache to resume handshakes.
+  /**
+   * This function attaches a session cache to the context. Servers created
+   * from the context store their sessions in the cache and protect session
+   * tickets using its keys. Client streams created from the context store
+   * and resume sessions using a key given to
+   * ssl::stream::set_session_cache_key().
+   *
+   * @param cache The session cache. It must outlive the context and the
+   * streams created from it.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c SSL_CTX_set_session_cache_mode,
+   * @c SSL_CTX_sess_set_new_cb, @c SSL_CTX_sess_set_get_cb,
+   * @c SSL_CTX_sess_set_remove_cb and
+   * @c SSL_CTX_set_tlsext_ticket_key_evp_cb.
+   */
+  ASIO_DECL void set_session_cache(session_cache& cache);
+
+  /// Use a session cache to resume handshakes.
+  /**
+   * This function attaches a session cache to the context. Servers created
+   * from the context store their sessions in the cache and protect session
+   * tickets using its keys. Client streams created from the context store
+   * and resume sessions using a key given to
+   * ssl::stream::set_session_cache_key().
+   *
+   * @param cache The session cache. It must outlive the context and the
+   * streams created from it.
+   *
+   * @param ec Set to indicate what error occurred, if any. The error
+   * asio::error::operation_not_supported is reported if the SSL library
+   * does not support external session caches.
+   *
+   * @note Calls @c SSL_CTX_set_session_cache_mode,
+   * @c SSL_CTX_sess_set_new_cb, @c SSL_CTX_sess_set_get_cb,
+   * @c SSL_CTX_sess_set_remove_cb and
+   * @c SSL_CTX_set_tlsext_ticket_key_evp_cb.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID set_session_cache(
+      session_cache& cache, asio::error_code& ec);
+
   /// Load a certification authority file for performing verification.
   /**
    * This function is used to load one or more trusted certification authorities
@@ -24,6 +24,14 @@
 #include "asio/ssl/stream_base.hpp"
 #include "asio/ssl/verify_mode.hpp"
 
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) \
+  && !defined(OPENSSL_IS_BORINGSSL) \
+  && !defined(ASIO_USE_WOLFSSL)
+# define ASIO_HAS_SSL_DIRECT_IO 1
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+       //   && !defined(OPENSSL_IS_BORINGSSL)
+       //   && !defined(ASIO_USE_WOLFSSL)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -105,6 +113,19 @@ public:
   ASIO_DECL asio::const_buffer put_input(
       const asio::const_buffer& data);
 
+  // Release the output data obtained by the last call to get_output(), once
+  // it has been written to the transport.
+  ASIO_DECL void release_output();
+
+  // Transfer data directly between the SSL session and the given buffer
+  // space, instead of through an internal BIO pair. In this mode get_output()
+  // returns data from the output space and ignores its argument, and input
+  // that lies within the input space is not copied. Must be called before
+  // the session is started.
+  ASIO_DECL asio::error_code use_direct_io(
+      const asio::mutable_buffer& input_space,
+      const asio::mutable_buffer& output_space, asio::error_code& ec);
+
   // Map an error::eof code returned by the underlying transport according to
   // the type and state of the SSL session. Returns a const reference to the
   // error code object, suitable for passing to a completion handler.
@@ -148,8 +169,51 @@ private:
   // Adapt the SSL_write function to the signature needed for perform().
   ASIO_DECL int do_write(void* data, std::size_t length);
 
+  // Get the amount of output that has not yet been obtained by get_output().
+  ASIO_DECL std::size_t pending_output() const;
+
+  // Get the amount of input that has not yet been consumed by the session.
+  ASIO_DECL std::size_t pending_input() const;
+
+  // The state of a BIO that transfers data directly between the session and
+  // the transport's buffers.
+  struct direct_bio
+  {
+    // The space into which input is read from the transport.
+    unsigned char* input_space;
+    std::size_t input_capacity;
+
+    // The input that has not yet been consumed by the session.
+    const unsigned char* input;
+    std::size_t input_size;
+
+    // The space in which output is prepared for the transport.
+    unsigned char* output_space;
+    std::size_t output_capacity;
+
+    // The amount of output prepared, and how much of it has been obtained
+    // by get_output().
+    std::size_t output_size;
+    std::size_t output_taken;
+  };
+
+#if defined(ASIO_HAS_SSL_DIRECT_IO)
+  // Get the method used to create direct BIOs.
+  ASIO_DECL static BIO_METHOD* direct_bio_method();
+
+  // Write to a direct BIO's output space.
+  ASIO_DECL static int direct_bio_write(BIO* bio, const char* data, int size);
+
+  // Read from a direct BIO's input.
+  ASIO_DECL static int direct_bio_read(BIO* bio, char* data, int size);
+
+  // Control a direct BIO.
+  ASIO_DECL static long direct_bio_ctrl(BIO* bio, int cmd, long, void*);
+#endif // defined(ASIO_HAS_SSL_DIRECT_IO)
+
   SSL* ssl_;
   BIO* ext_bio_;
+  direct_bio* direct_bio_;
 };
 
 } // namespace detail
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 
+#include <cstring>
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 #include "asio/ssl/detail/engine.hpp"
@@ -30,7 +31,8 @@ namespace ssl {
 namespace detail {
 
 engine::engine(SSL_CTX* context)
-  : ssl_(::SSL_new(context))
+  : ssl_(::SSL_new(context)),
+    direct_bio_(0)
 {
   if (!ssl_)
   {
@@ -58,10 +60,12 @@ engine::engine(SSL_CTX* context)
 #if defined(ASIO_HAS_MOVE)
 engine::engine(engine&& other) ASIO_NOEXCEPT
   : ssl_(other.ssl_),
-    ext_bio_(other.ext_bio_)
+    ext_bio_(other.ext_bio_),
+    direct_bio_(other.direct_bio_)
 {
   other.ssl_ = 0;
   other.ext_bio_ = 0;
+  other.direct_bio_ = 0;
 }
 #endif // defined(ASIO_HAS_MOVE)
 
@@ -78,6 +82,8 @@ engine::~engine()
 
   if (ssl_)
     ::SSL_free(ssl_);
+
+  delete direct_bio_;
 }
 
 SSL* engine::native_handle()
@@ -183,6 +189,13 @@ engine::want engine::read(const asio::mutable_buffer& data,
 asio::mutable_buffer engine::get_output(
     const asio::mutable_buffer& data)
 {
+  if (direct_bio_)
+  {
+    direct_bio_->output_taken = direct_bio_->output_size;
+    return asio::buffer(direct_bio_->output_space,
+        direct_bio_->output_size);
+  }
+
   int length = ::BIO_read(ext_bio_,
       data.data(), static_cast<int>(data.size()));
 
@@ -193,6 +206,33 @@ asio::mutable_buffer engine::get_output(
 asio::const_buffer engine::put_input(
     const asio::const_buffer& data)
 {
+  if (direct_bio_)
+  {
+    // New input is only needed once the previous input has been consumed.
+    if (data.size() == 0 || direct_bio_->input_size != 0)
+      return data;
+
+    // Input that was read into the input space is consumed where it lies.
+    // Anything else, such as data passed to a buffered handshake, must be
+    // copied since it may not outlive the call.
+    const unsigned char* p = static_cast<const unsigned char*>(data.data());
+    if (p >= direct_bio_->input_space && p + data.size()
+        <= direct_bio_->input_space + direct_bio_->input_capacity)
+    {
+      direct_bio_->input = p;
+      direct_bio_->input_size = data.size();
+      return asio::buffer(data + data.size());
+    }
+
+    using namespace std; // For memcpy.
+    std::size_t length = data.size() < direct_bio_->input_capacity
+      ? data.size() : direct_bio_->input_capacity;
+    memcpy(direct_bio_->input_space, p, length);
+    direct_bio_->input = direct_bio_->input_space;
+    direct_bio_->input_size = length;
+    return asio::buffer(data + length);
+  }
+
   int length = ::BIO_write(ext_bio_,
       data.data(), static_cast<int>(data.size()));
 
@@ -200,6 +240,95 @@ asio::const_buffer engine::put_input(
       (length > 0 ? static_cast<std::size_t>(length) : 0));
 }
 
+void engine::release_output()
+{
+  if (direct_bio_)
+  {
+    // Any output prepared after the last get_output() call is moved to the
+    // start of the output space. This only happens when an operation runs
+    // while another operation's output is being written.
+    std::size_t remaining =
+      direct_bio_->output_size - direct_bio_->output_taken;
+    if (remaining != 0)
+    {
+      using namespace std; // For memmove.
+      memmove(direct_bio_->output_space, direct_bio_->output_space
+          + direct_bio_->output_taken, remaining);
+    }
+
+    direct_bio_->output_size = remaining;
+    direct_bio_->output_taken = 0;
+  }
+}
+
+asio::error_code engine::use_direct_io(
+    const asio::mutable_buffer& input_space,
+    const asio::mutable_buffer& output_space, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_SSL_DIRECT_IO)
+  if (input_space.size() == 0 || output_space.size() == 0)
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  if (!::SSL_in_before(ssl_) || pending_input() || pending_output())
+  {
+    ec = asio::error::already_started;
+    return ec;
+  }
+
+  if (direct_bio_)
+  {
+    direct_bio_->input_space =
+      static_cast<unsigned char*>(input_space.data());
+    direct_bio_->input_capacity = input_space.size();
+    direct_bio_->output_space =
+      static_cast<unsigned char*>(output_space.data());
+    direct_bio_->output_capacity = output_space.size();
+    ec = asio::error_code();
+    return ec;
+  }
+
+  BIO_METHOD* method = direct_bio_method();
+  ::BIO* bio = method ? ::BIO_new(method) : 0;
+  if (!bio)
+  {
+    ec = asio::error_code(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    return ec;
+  }
+
+  direct_bio* state = new direct_bio;
+  state->input_space = static_cast<unsigned char*>(input_space.data());
+  state->input_capacity = input_space.size();
+  state->input = state->input_space;
+  state->input_size = 0;
+  state->output_space = static_cast<unsigned char*>(output_space.data());
+  state->output_capacity = output_space.size();
+  state->output_size = 0;
+  state->output_taken = 0;
+
+  ::BIO_set_data(bio, state);
+  ::BIO_set_init(bio, 1);
+
+  // The session releases its end of the BIO pair when the new BIO is set.
+  ::SSL_set_bio(ssl_, bio, bio);
+  ::BIO_free(ext_bio_);
+  ext_bio_ = 0;
+  direct_bio_ = state;
+
+  ec = asio::error_code();
+  return ec;
+#else // defined(ASIO_HAS_SSL_DIRECT_IO)
+  (void)input_space;
+  (void)output_space;
+  ec = asio::error::operation_not_supported;
+  return ec;
+#endif // defined(ASIO_HAS_SSL_DIRECT_IO)
+}
+
 const asio::error_code& engine::map_error_code(
     asio::error_code& ec) const
 {
@@ -208,7 +337,7 @@ const asio::error_code& engine::map_error_code(
     return ec;
 
   // If there's data yet to be read, it's an error.
-  if (BIO_wpending(ext_bio_))
+  if (pending_input())
   {
     ec = asio::ssl::error::stream_truncated;
     return ec;
@@ -242,12 +371,12 @@ engine::want engine::perform(int (engine::* op)(void*, std::size_t),
     void* data, std::size_t length, asio::error_code& ec,
     std::size_t* bytes_transferred)
 {
-  std::size_t pending_output_before = ::BIO_ctrl_pending(ext_bio_);
+  std::size_t pending_output_before = pending_output();
   ::ERR_clear_error();
   int result = (this->*op)(data, length);
   int ssl_error = ::SSL_get_error(ssl_, result);
   int sys_error = static_cast<int>(::ERR_get_error());
-  std::size_t pending_output_after = ::BIO_ctrl_pending(ext_bio_);
+  std::size_t pending_output_after = pending_output();
 
   if (ssl_error == SSL_ERROR_SSL)
   {
@@ -340,6 +469,101 @@ int engine::do_write(void* data, std::size_t length)
       length < INT_MAX ? static_cast<int>(length) : INT_MAX);
 }
 
+std::size_t engine::pending_output() const
+{
+  if (direct_bio_)
+    return direct_bio_->output_size - direct_bio_->output_taken;
+  return ::BIO_ctrl_pending(ext_bio_);
+}
+
+std::size_t engine::pending_input() const
+{
+  if (direct_bio_)
+    return direct_bio_->input_size;
+  return BIO_wpending(ext_bio_);
+}
+
+#if defined(ASIO_HAS_SSL_DIRECT_IO)
+BIO_METHOD* engine::direct_bio_method()
+{
+  static asio::detail::static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  static BIO_METHOD* method = 0;
+  mutex.init();
+  asio::detail::static_mutex::scoped_lock lock(mutex);
+  if (!method)
+  {
+    int type = ::BIO_get_new_index();
+    if (type == -1)
+      return 0;
+
+    method = ::BIO_meth_new(type | BIO_TYPE_SOURCE_SINK, "asio direct");
+    if (method)
+    {
+      ::BIO_meth_set_write(method, &engine::direct_bio_write);
+      ::BIO_meth_set_read(method, &engine::direct_bio_read);
+      ::BIO_meth_set_ctrl(method, &engine::direct_bio_ctrl);
+    }
+  }
+  return method;
+}
+
+int engine::direct_bio_write(BIO* bio, const char* data, int size)
+{
+  direct_bio* state = static_cast<direct_bio*>(::BIO_get_data(bio));
+  BIO_clear_retry_flags(bio);
+
+  std::size_t space = state->output_capacity - state->output_size;
+  if (space == 0 || size <= 0)
+  {
+    BIO_set_retry_write(bio);
+    return -1;
+  }
+
+  std::size_t length = static_cast<std::size_t>(size) < space
+    ? static_cast<std::size_t>(size) : space;
+  using namespace std; // For memcpy.
+  memcpy(state->output_space + state->output_size, data, length);
+  state->output_size += length;
+  return static_cast<int>(length);
+}
+
+int engine::direct_bio_read(BIO* bio, char* data, int size)
+{
+  direct_bio* state = static_cast<direct_bio*>(::BIO_get_data(bio));
+  BIO_clear_retry_flags(bio);
+
+  if (state->input_size == 0 || size <= 0)
+  {
+    BIO_set_retry_read(bio);
+    return -1;
+  }
+
+  std::size_t length = static_cast<std::size_t>(size) < state->input_size
+    ? static_cast<std::size_t>(size) : state->input_size;
+  using namespace std; // For memcpy.
+  memcpy(data, state->input, length);
+  state->input += length;
+  state->input_size -= length;
+  return static_cast<int>(length);
+}
+
+long engine::direct_bio_ctrl(BIO* bio, int cmd, long, void*)
+{
+  direct_bio* state = static_cast<direct_bio*>(::BIO_get_data(bio));
+  switch (cmd)
+  {
+  case BIO_CTRL_PENDING:
+    return static_cast<long>(state->input_size);
+  case BIO_CTRL_WPENDING:
+    return static_cast<long>(state->output_size - state->output_taken);
+  case BIO_CTRL_FLUSH:
+    return 1;
+  default:
+    return 0;
+  }
+}
+#endif // defined(ASIO_HAS_SSL_DIRECT_IO)
+
 } // namespace detail
 } // namespace ssl
 } // namespace asio
@@ -0,0 +1,685 @@
+//
+// ssl/detail/impl/kernel_tls.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_IMPL_KERNEL_TLS_IPP
+#define ASIO_SSL_DETAIL_IMPL_KERNEL_TLS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/ssl/detail/kernel_tls.hpp"
+
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+# include <cstring>
+# include <new>
+# include <sys/socket.h>
+# include <sys/uio.h>
+# include <netinet/tcp.h>
+# include <linux/tls.h>
+# include <openssl/kdf.h>
+# include "asio/detail/static_mutex.hpp"
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+#include "asio/detail/push_options.hpp"
+
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+# if !defined(SOL_TLS)
+#  define SOL_TLS 282
+# endif // !defined(SOL_TLS)
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+namespace kernel_tls_ops {
+
+// The traffic secrets captured during a TLS 1.3 handshake.
+struct secrets
+{
+  unsigned char client[EVP_MAX_MD_SIZE];
+  std::size_t client_length;
+  unsigned char server[EVP_MAX_MD_SIZE];
+  std::size_t server_length;
+};
+
+// The context settings changed by enabling kernel TLS, restored when it is
+// disabled again.
+struct saved_settings
+{
+  std::size_t num_tickets;
+  bool renegotiation_disabled;
+
+  // The key logging callback that the context had, which is passed each line
+  // after the secrets have been captured.
+  SSL_CTX_keylog_cb_func keylog_callback;
+};
+
+// The key material accepted by the kernel for a single direction.
+union crypto_info
+{
+  tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+  tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+# if defined(TLS_CIPHER_CHACHA20_POLY1305)
+  tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+# endif // defined(TLS_CIPHER_CHACHA20_POLY1305)
+};
+
+inline int hex_digit(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+// Decode a hexadecimal string, returning the number of bytes written.
+inline std::size_t decode_hex(const char* hex,
+    unsigned char* out, std::size_t max_length)
+{
+  std::size_t length = 0;
+  while (length < max_length)
+  {
+    int high = hex_digit(hex[0]);
+    int low = high < 0 ? -1 : hex_digit(hex[1]);
+    if (low < 0)
+      break;
+    out[length++] = static_cast<unsigned char>((high << 4) | low);
+    hex += 2;
+  }
+  return length;
+}
+
+// The HKDF-Expand-Label function defined by RFC 8446.
+inline bool expand_label(const EVP_MD* md, const unsigned char* secret,
+    std::size_t secret_length, const char* label,
+    unsigned char* out, std::size_t out_length)
+{
+  using namespace std; // For memcpy and strlen.
+
+  std::size_t label_length = strlen(label);
+  unsigned char info[32];
+  info[0] = static_cast<unsigned char>(out_length >> 8);
+  info[1] = static_cast<unsigned char>(out_length & 0xFF);
+  info[2] = static_cast<unsigned char>(6 + label_length);
+  memcpy(info + 3, "tls13 ", 6);
+  memcpy(info + 9, label, label_length);
+  info[9 + label_length] = 0;
+
+  EVP_PKEY_CTX* pctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, 0);
+  bool result = pctx
+    && ::EVP_PKEY_derive_init(pctx) > 0
+    && ::EVP_PKEY_CTX_hkdf_mode(pctx, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0
+    && ::EVP_PKEY_CTX_set_hkdf_md(pctx, md) > 0
+    && ::EVP_PKEY_CTX_set1_hkdf_key(pctx,
+        secret, static_cast<int>(secret_length)) > 0
+    && ::EVP_PKEY_CTX_add1_hkdf_info(pctx,
+        info, static_cast<int>(10 + label_length)) > 0
+    && ::EVP_PKEY_derive(pctx, out, &out_length) > 0;
+  ::EVP_PKEY_CTX_free(pctx);
+  return result;
+}
+
+// Derive the TLS 1.2 key block from the session's master secret.
+inline bool derive_key_block(SSL* ssl, const EVP_MD* md,
+    unsigned char* out, std::size_t out_length)
+{
+  unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  std::size_t master_key_length = ::SSL_SESSION_get_master_key(
+      ::SSL_get_session(ssl), master_key, sizeof(master_key));
+  unsigned char server_random[SSL3_RANDOM_SIZE];
+  ::SSL_get_server_random(ssl, server_random, sizeof(server_random));
+  unsigned char client_random[SSL3_RANDOM_SIZE];
+  ::SSL_get_client_random(ssl, client_random, sizeof(client_random));
+
+  EVP_PKEY_CTX* pctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, 0);
+  bool result = pctx
+    && master_key_length > 0
+    && ::EVP_PKEY_derive_init(pctx) > 0
+    && ::EVP_PKEY_CTX_set_tls1_prf_md(pctx, md) > 0
+    && ::EVP_PKEY_CTX_set1_tls1_prf_secret(pctx,
+        master_key, static_cast<int>(master_key_length)) > 0
+    && ::EVP_PKEY_CTX_add1_tls1_prf_seed(pctx,
+        reinterpret_cast<const unsigned char*>("key expansion"), 13) > 0
+    && ::EVP_PKEY_CTX_add1_tls1_prf_seed(pctx,
+        server_random, static_cast<int>(sizeof(server_random))) > 0
+    && ::EVP_PKEY_CTX_add1_tls1_prf_seed(pctx,
+        client_random, static_cast<int>(sizeof(client_random))) > 0
+    && ::EVP_PKEY_derive(pctx, out, &out_length) > 0;
+  ::EVP_PKEY_CTX_free(pctx);
+  ::OPENSSL_cleanse(master_key, sizeof(master_key));
+  return result;
+}
+
+// Produce the key material for one direction of an established session.
+inline bool make_crypto_info(SSL* ssl, const secrets* s,
+    bool for_send, crypto_info& info, socklen_t& info_length)
+{
+  using namespace std; // For memcpy and memset.
+
+  int version = ::SSL_version(ssl);
+  if (version != TLS1_2_VERSION && version != TLS1_3_VERSION)
+    return false;
+
+  const SSL_CIPHER* cipher = ::SSL_get_current_cipher(ssl);
+  if (!cipher)
+    return false;
+  const EVP_MD* md = ::SSL_CIPHER_get_handshake_digest(cipher);
+  if (!md)
+    return false;
+
+  int cipher_type = 0;
+  std::size_t key_length = 0;
+  std::size_t fixed_iv_length = 4;
+  switch (::SSL_CIPHER_get_cipher_nid(cipher))
+  {
+  case NID_aes_128_gcm:
+    cipher_type = TLS_CIPHER_AES_GCM_128;
+    key_length = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    cipher_type = TLS_CIPHER_AES_GCM_256;
+    key_length = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    break;
+# if defined(TLS_CIPHER_CHACHA20_POLY1305)
+  case NID_chacha20_poly1305:
+    cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+    key_length = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+    fixed_iv_length = TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE;
+    break;
+# endif // defined(TLS_CIPHER_CHACHA20_POLY1305)
+  default:
+    return false;
+  }
+
+  // The keys written by the server are the ones it sends and the client
+  // receives.
+  bool server_writes = (::SSL_is_server(ssl) != 0) == for_send;
+
+  unsigned char key[32];
+  unsigned char iv[12];
+  bool result = false;
+  if (version == TLS1_3_VERSION)
+  {
+    if (!s)
+      return false;
+    const unsigned char* secret = server_writes ? s->server : s->client;
+    std::size_t secret_length =
+      server_writes ? s->server_length : s->client_length;
+    result = secret_length > 0
+      && expand_label(md, secret, secret_length, "key", key, key_length)
+      && expand_label(md, secret, secret_length, "iv", iv, sizeof(iv));
+  }
+  else
+  {
+    // The key block holds the client key, the server key, the client IV and
+    // the server IV, in that order.
+    unsigned char key_block[2 * 32 + 2 * 12];
+    std::size_t key_block_length = 2 * (key_length + fixed_iv_length);
+    result = derive_key_block(ssl, md, key_block, key_block_length);
+    if (result)
+    {
+      memcpy(key, key_block + (server_writes ? key_length : 0), key_length);
+      memcpy(iv, key_block + 2 * key_length
+          + (server_writes ? fixed_iv_length : 0), fixed_iv_length);
+    }
+    ::OPENSSL_cleanse(key_block, sizeof(key_block));
+  }
+
+  if (result)
+  {
+    // The first record protected by the kernel follows the Finished message
+    // in TLS 1.2, and is the first application data record in TLS 1.3.
+    unsigned char rec_seq[8];
+    memset(rec_seq, 0, sizeof(rec_seq));
+    if (version == TLS1_2_VERSION)
+      rec_seq[7] = 1;
+
+    memset(&info, 0, sizeof(info));
+    switch (cipher_type)
+    {
+    case TLS_CIPHER_AES_GCM_128:
+      info.aes_gcm_128.info.version = static_cast<unsigned short>(version);
+      info.aes_gcm_128.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+      memcpy(info.aes_gcm_128.key, key, key_length);
+      memcpy(info.aes_gcm_128.salt, iv, 4);
+      memcpy(info.aes_gcm_128.iv, version == TLS1_3_VERSION
+          ? iv + 4 : rec_seq, TLS_CIPHER_AES_GCM_128_IV_SIZE);
+      memcpy(info.aes_gcm_128.rec_seq, rec_seq, sizeof(rec_seq));
+      info_length = sizeof(info.aes_gcm_128);
+      break;
+    case TLS_CIPHER_AES_GCM_256:
+      info.aes_gcm_256.info.version = static_cast<unsigned short>(version);
+      info.aes_gcm_256.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+      memcpy(info.aes_gcm_256.key, key, key_length);
+      memcpy(info.aes_gcm_256.salt, iv, 4);
+      memcpy(info.aes_gcm_256.iv, version == TLS1_3_VERSION
+          ? iv + 4 : rec_seq, TLS_CIPHER_AES_GCM_256_IV_SIZE);
+      memcpy(info.aes_gcm_256.rec_seq, rec_seq, sizeof(rec_seq));
+      info_length = sizeof(info.aes_gcm_256);
+      break;
+# if defined(TLS_CIPHER_CHACHA20_POLY1305)
+    case TLS_CIPHER_CHACHA20_POLY1305:
+      info.chacha20_poly1305.info.version =
+        static_cast<unsigned short>(version);
+      info.chacha20_poly1305.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+      memcpy(info.chacha20_poly1305.key, key, key_length);
+      memcpy(info.chacha20_poly1305.iv, iv,
+          TLS_CIPHER_CHACHA20_POLY1305_IV_SIZE);
+      memcpy(info.chacha20_poly1305.rec_seq, rec_seq, sizeof(rec_seq));
+      info_length = sizeof(info.chacha20_poly1305);
+      break;
+# endif // defined(TLS_CIPHER_CHACHA20_POLY1305)
+    default:
+      break;
+    }
+  }
+
+  ::OPENSSL_cleanse(key, sizeof(key));
+  ::OPENSSL_cleanse(iv, sizeof(iv));
+  return result;
+}
+
+} // namespace kernel_tls_ops
+
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+asio::error_code kernel_tls::set_enabled(
+    SSL_CTX* ctx, bool enabled, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+  int index = settings_index();
+  kernel_tls_ops::saved_settings* saved = index < 0 ? 0
+    : static_cast<kernel_tls_ops::saved_settings*>(
+        ::SSL_CTX_get_ex_data(ctx, index));
+
+  if (enabled && !saved)
+  {
+    if (index < 0 || secrets_index() < 0)
+    {
+      ec = asio::error_code(
+          static_cast<int>(::ERR_get_error()),
+          asio::error::get_ssl_category());
+      return ec;
+    }
+
+    saved = new kernel_tls_ops::saved_settings;
+    saved->num_tickets = ::SSL_CTX_get_num_tickets(ctx);
+    saved->renegotiation_disabled = false;
+# if defined(SSL_OP_NO_RENEGOTIATION)
+    saved->renegotiation_disabled =
+      (::SSL_CTX_get_options(ctx) & SSL_OP_NO_RENEGOTIATION) != 0;
+# endif // defined(SSL_OP_NO_RENEGOTIATION)
+    saved->keylog_callback = ::SSL_CTX_get_keylog_callback(ctx);
+    if (!::SSL_CTX_set_ex_data(ctx, index, saved))
+    {
+      delete saved;
+      ec = asio::error_code(
+          static_cast<int>(::ERR_get_error()),
+          asio::error::get_ssl_category());
+      return ec;
+    }
+
+    // The TLS 1.3 traffic secrets are only made available through the key
+    // logging callback. Renegotiation and post-handshake session tickets are
+    // disabled, as they would change the keys or record sequence numbers
+    // after the keys have been handed to the kernel.
+    ::SSL_CTX_set_keylog_callback(ctx, &kernel_tls::keylog_callback);
+# if defined(SSL_OP_NO_RENEGOTIATION)
+    ::SSL_CTX_set_options(ctx, SSL_OP_NO_RENEGOTIATION);
+# endif // defined(SSL_OP_NO_RENEGOTIATION)
+    ::SSL_CTX_set_num_tickets(ctx, 0);
+  }
+  else if (enabled)
+  {
+    // A callback installed since offload was enabled replaced ours, so it is
+    // chained behind ours instead.
+    SSL_CTX_keylog_cb_func callback = ::SSL_CTX_get_keylog_callback(ctx);
+    if (callback != &kernel_tls::keylog_callback)
+    {
+      saved->keylog_callback = callback;
+      ::SSL_CTX_set_keylog_callback(ctx, &kernel_tls::keylog_callback);
+    }
+  }
+  else if (saved)
+  {
+    // Restore the settings that the context had before offload was enabled,
+    // keeping any key logging callback installed since.
+    if (::SSL_CTX_get_keylog_callback(ctx) == &kernel_tls::keylog_callback)
+      ::SSL_CTX_set_keylog_callback(ctx, saved->keylog_callback);
+    ::SSL_CTX_set_num_tickets(ctx, saved->num_tickets);
+# if defined(SSL_OP_NO_RENEGOTIATION)
+    if (!saved->renegotiation_disabled)
+      ::SSL_CTX_clear_options(ctx, SSL_OP_NO_RENEGOTIATION);
+# endif // defined(SSL_OP_NO_RENEGOTIATION)
+    ::SSL_CTX_set_ex_data(ctx, index, 0);
+    delete saved;
+  }
+
+  ec = asio::error_code();
+  return ec;
+#else // defined(ASIO_HAS_SSL_KERNEL_TLS)
+  (void)ctx;
+  ec = enabled ? asio::error::operation_not_supported : asio::error_code();
+  return ec;
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+}
+
+bool kernel_tls::is_enabled(SSL_CTX* ctx)
+{
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+  int index = settings_index();
+  return index >= 0 && ::SSL_CTX_get_ex_data(ctx, index) != 0;
+#else // defined(ASIO_HAS_SSL_KERNEL_TLS)
+  (void)ctx;
+  return false;
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+}
+
+void kernel_tls::install(SSL* ssl, int descriptor, bool input_buffered)
+{
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+  int index = secrets_index();
+  kernel_tls_ops::secrets* s = index < 0 ? 0
+    : static_cast<kernel_tls_ops::secrets*>(::SSL_get_ex_data(ssl, index));
+
+  // A TLS 1.3 server sends its session tickets immediately after the
+  // handshake, so the record sequence number is only known when none are
+  // sent.
+  bool tls13_server = ::SSL_version(ssl) == TLS1_3_VERSION
+    && ::SSL_is_server(ssl) && ::SSL_get_num_tickets(ssl) != 0;
+
+  if (!send_ && descriptor != -1 && !tls13_server
+      && BIO_wpending(::SSL_get_wbio(ssl)) == 0)
+  {
+    kernel_tls_ops::crypto_info info;
+    socklen_t info_length = 0;
+    if (kernel_tls_ops::make_crypto_info(ssl, s, true, info, info_length)
+        && ::setsockopt(descriptor, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0
+        && ::setsockopt(descriptor, SOL_TLS, TLS_TX, &info, info_length) == 0)
+    {
+      send_ = true;
+
+      // Records that have already been received must be decrypted by the
+      // engine, so the receive direction is only offloaded if there are none.
+      if (!input_buffered
+          && ::BIO_ctrl_pending(::SSL_get_rbio(ssl)) == 0
+          && !::SSL_has_pending(ssl)
+          && kernel_tls_ops::make_crypto_info(
+            ssl, s, false, info, info_length)
+          && ::setsockopt(descriptor, SOL_TLS,
+            TLS_RX, &info, info_length) == 0)
+      {
+        receive_ = true;
+      }
+    }
+    ::OPENSSL_cleanse(&info, sizeof(info));
+  }
+
+  if (s)
+  {
+    ::SSL_set_ex_data(ssl, index, 0);
+    ::OPENSSL_cleanse(s, sizeof(kernel_tls_ops::secrets));
+    delete s;
+  }
+#else // defined(ASIO_HAS_SSL_KERNEL_TLS)
+  (void)ssl;
+  (void)descriptor;
+  (void)input_buffered;
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+}
+
+asio::error_code kernel_tls::send_close_notify(
+    int descriptor, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+  using namespace std; // For memset.
+
+  unsigned char alert[2] = { SSL3_AL_WARNING, SSL_AD_CLOSE_NOTIFY };
+  iovec iov;
+  iov.iov_base = alert;
+  iov.iov_len = sizeof(alert);
+
+  union
+  {
+    cmsghdr header;
+    char data[CMSG_SPACE(sizeof(unsigned char))];
+  } control;
+  memset(&control, 0, sizeof(control));
+
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+  *CMSG_DATA(cmsg) = SSL3_RT_ALERT;
+
+  if (::sendmsg(descriptor, &msg, MSG_DONTWAIT | MSG_NOSIGNAL) < 0)
+    ec = asio::error_code(errno, asio::error::get_system_category());
+  else
+    ec = asio::error_code();
+  return ec;
+#else // defined(ASIO_HAS_SSL_KERNEL_TLS)
+  (void)descriptor;
+  ec = asio::error::operation_not_supported;
+  return ec;
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+}
+
+bool kernel_tls::read_control_record(int descriptor, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+  using namespace std; // For memset.
+
+  unsigned char record[16384];
+  iovec iov;
+  iov.iov_base = record;
+  iov.iov_len = sizeof(record);
+
+  union
+  {
+    cmsghdr header;
+    char data[CMSG_SPACE(sizeof(unsigned char))];
+  } control;
+  memset(&control, 0, sizeof(control));
+
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.data;
+  msg.msg_controllen = sizeof(control.data);
+
+  ssize_t n = ::recvmsg(descriptor, &msg, MSG_DONTWAIT);
+  if (n < 0)
+  {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+    {
+      ec = asio::error_code();
+      return true;
+    }
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return false;
+  }
+
+  if (n == 0)
+  {
+    ec = asio::error::eof;
+    return false;
+  }
+
+  int record_type = SSL3_RT_APPLICATION_DATA;
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg && cmsg->cmsg_level == SOL_TLS
+      && cmsg->cmsg_type == TLS_GET_RECORD_TYPE)
+    record_type = *CMSG_DATA(cmsg);
+
+  if (record_type == SSL3_RT_ALERT && n >= 2)
+  {
+    if (record[1] == SSL_AD_CLOSE_NOTIFY)
+    {
+      close_notify_received_ = true;
+      ec = asio::error::eof;
+    }
+    else
+    {
+      ec = asio::error_code(
+          static_cast<int>(ERR_PACK(ERR_LIB_SSL, 0,
+              SSL_AD_REASON_OFFSET + record[1])),
+          asio::error::get_ssl_category());
+    }
+    return false;
+  }
+
+  // Session tickets may be sent to a client at any time, and are discarded.
+  // Any other handshake message, such as a key update, cannot be handled.
+  if (record_type == SSL3_RT_HANDSHAKE
+      && record[0] == SSL3_MT_NEWSESSION_TICKET)
+  {
+    ec = asio::error_code();
+    return true;
+  }
+
+  ec = asio::error_code(
+      static_cast<int>(ERR_PACK(ERR_LIB_SSL, 0, SSL_R_UNEXPECTED_RECORD)),
+      asio::error::get_ssl_category());
+  return false;
+#else // defined(ASIO_HAS_SSL_KERNEL_TLS)
+  (void)descriptor;
+  ec = asio::error::operation_not_supported;
+  return false;
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+}
+
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+int kernel_tls::secrets_index()
+{
+  static asio::detail::static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  static int index = -1;
+  mutex.init();
+  asio::detail::static_mutex::scoped_lock lock(mutex);
+  if (index < 0)
+    index = ::SSL_get_ex_new_index(0, 0, 0, 0, &kernel_tls::free_secrets);
+  return index;
+}
+
+void kernel_tls::free_secrets(void*, void* ptr,
+    CRYPTO_EX_DATA*, int, long, void*)
+{
+  if (kernel_tls_ops::secrets* s = static_cast<kernel_tls_ops::secrets*>(ptr))
+  {
+    ::OPENSSL_cleanse(s, sizeof(kernel_tls_ops::secrets));
+    delete s;
+  }
+}
+
+int kernel_tls::settings_index()
+{
+  static asio::detail::static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  static int index = -1;
+  mutex.init();
+  asio::detail::static_mutex::scoped_lock lock(mutex);
+  if (index < 0)
+    index = ::SSL_CTX_get_ex_new_index(0, 0, 0, 0, &kernel_tls::free_settings);
+  return index;
+}
+
+void kernel_tls::free_settings(void*, void* ptr,
+    CRYPTO_EX_DATA*, int, long, void*)
+{
+  delete static_cast<kernel_tls_ops::saved_settings*>(ptr);
+}
+
+void kernel_tls::keylog_callback(const SSL* ssl, const char* line)
+{
+  save_secret(ssl, line);
+
+  // Pass the line on to the callback that the context had before offload was
+  // enabled.
+  int index = settings_index();
+  kernel_tls_ops::saved_settings* saved = index < 0 ? 0
+    : static_cast<kernel_tls_ops::saved_settings*>(
+        ::SSL_CTX_get_ex_data(::SSL_get_SSL_CTX(ssl), index));
+  if (saved && saved->keylog_callback)
+    saved->keylog_callback(ssl, line);
+}
+
+void kernel_tls::save_secret(const SSL* ssl, const char* line)
+{
+  using namespace std; // For strchr and strncmp.
+
+  static const char client_label[] = "CLIENT_TRAFFIC_SECRET_0 ";
+  static const char server_label[] = "SERVER_TRAFFIC_SECRET_0 ";
+
+  bool client = false;
+  if (strncmp(line, client_label, sizeof(client_label) - 1) == 0)
+    client = true;
+  else if (strncmp(line, server_label, sizeof(server_label) - 1) != 0)
+    return;
+
+  // The label is followed by the client random and then the secret.
+  const char* secret = strchr(line + sizeof(client_label) - 1, ' ');
+  if (!secret)
+    return;
+
+  int index = secrets_index();
+  if (index < 0)
+    return;
+
+  kernel_tls_ops::secrets* s = static_cast<kernel_tls_ops::secrets*>(
+      ::SSL_get_ex_data(ssl, index));
+  if (!s)
+  {
+    s = new (std::nothrow) kernel_tls_ops::secrets();
+    if (!s)
+      return;
+    if (!::SSL_set_ex_data(const_cast<SSL*>(ssl), index, s))
+    {
+      delete s;
+      return;
+    }
+  }
+
+  if (client)
+  {
+    s->client_length = kernel_tls_ops::decode_hex(
+        secret + 1, s->client, sizeof(s->client));
+  }
+  else
+  {
+    s->server_length = kernel_tls_ops::decode_hex(
+        secret + 1, s->server, sizeof(s->server));
+  }
+}
+
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_DETAIL_IMPL_KERNEL_TLS_IPP
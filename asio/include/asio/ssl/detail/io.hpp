@@ -60,6 +60,7 @@ std::size_t io(Stream& next_layer, stream_core& core,
     // transport.
     asio::write(next_layer,
         core.engine_.get_output(core.output_buffer_), io_ec);
+    core.engine_.release_output();
     if (!ec)
       ec = io_ec;
 
@@ -72,6 +73,7 @@ std::size_t io(Stream& next_layer, stream_core& core,
     // transport.
     asio::write(next_layer,
         core.engine_.get_output(core.output_buffer_), io_ec);
+    core.engine_.release_output();
     if (!ec)
       ec = io_ec;
 
@@ -247,8 +249,16 @@ public:
         default:
         if (bytes_transferred == ~std::size_t(0))
           bytes_transferred = 0; // Timer cancellation, no data transferred.
-        else if (!ec_)
-          ec_ = ec;
+        else
+        {
+          if (!ec_)
+            ec_ = ec;
+
+          // The engine's output has been written to the transport.
+          if (want_ == engine::want_output_and_retry
+              || want_ == engine::want_output)
+            core_.engine_.release_output();
+        }
 
         switch (want_)
         {
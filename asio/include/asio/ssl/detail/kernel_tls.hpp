@@ -0,0 +1,152 @@
+//
+// ssl/detail/kernel_tls.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_KERNEL_TLS_HPP
+#define ASIO_SSL_DETAIL_KERNEL_TLS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <cerrno>
+#include "asio/error.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+#include "asio/ssl/error.hpp"
+
+#if defined(ASIO_HAS_KERNEL_TLS) \
+  && (OPENSSL_VERSION_NUMBER >= 0x10101000L) \
+  && !defined(OPENSSL_IS_BORINGSSL) \
+  && !defined(ASIO_USE_WOLFSSL)
+# define ASIO_HAS_SSL_KERNEL_TLS 1
+#endif // defined(ASIO_HAS_KERNEL_TLS)
+       //   && (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+       //   && !defined(OPENSSL_IS_BORINGSSL)
+       //   && !defined(ASIO_USE_WOLFSSL)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// Moves record protection for an established SSL session into the kernel,
+// after which application data may be sent and received using ordinary
+// socket operations.
+class kernel_tls
+{
+public:
+  // Construct in the state where the kernel is not used.
+  kernel_tls()
+    : send_(false),
+      receive_(false),
+      close_notify_received_(false)
+  {
+  }
+
+  // Request, or stop requesting, kernel TLS for sessions that are created
+  // from the given context.
+  ASIO_DECL static asio::error_code set_enabled(
+      SSL_CTX* ctx, bool enabled, asio::error_code& ec);
+
+  // Whether kernel TLS has been requested for sessions created from the
+  // given context.
+  ASIO_DECL static bool is_enabled(SSL_CTX* ctx);
+
+  // Attempt to install the session's keys on the socket. Must be called once
+  // the handshake is complete and all of its output has been written. If the
+  // keys cannot be installed, the session is left unchanged. The receive
+  // direction is offloaded only if no received data remains buffered.
+  ASIO_DECL void install(SSL* ssl, int descriptor, bool input_buffered);
+
+  // Whether the kernel protects data sent on the socket.
+  bool send() const
+  {
+    return send_;
+  }
+
+  // Whether the kernel protects data received on the socket.
+  bool receive() const
+  {
+    return receive_;
+  }
+
+  // Send a close_notify alert, once the kernel protects sent data.
+  ASIO_DECL asio::error_code send_close_notify(
+      int descriptor, asio::error_code& ec);
+
+  // Consume a received record that is not application data. This must be
+  // called when a receive fails with EIO. Returns true if the receive should
+  // be retried, or false with ec set to the result of the receive.
+  ASIO_DECL bool read_control_record(int descriptor, asio::error_code& ec);
+
+  // Whether an error returned by a receive indicates that the next record is
+  // not application data.
+  static bool is_control_record(const asio::error_code& ec)
+  {
+    return ec == asio::error_code(EIO,
+        asio::error::get_system_category());
+  }
+
+  // Map an error::eof code returned by a receive according to whether the
+  // peer sent a close_notify alert.
+  const asio::error_code& map_error_code(asio::error_code& ec) const
+  {
+    if (ec == asio::error::eof && !close_notify_received_)
+      ec = asio::ssl::error::stream_truncated;
+    return ec;
+  }
+
+private:
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+  // Get the SSL ex_data index used to hold a session's secrets.
+  ASIO_DECL static int secrets_index();
+
+  // Free the secrets held by a session.
+  ASIO_DECL static void free_secrets(void* parent, void* ptr,
+      CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  // Get the SSL_CTX ex_data index used to hold the settings to be restored
+  // when kernel TLS is disabled.
+  ASIO_DECL static int settings_index();
+
+  // Free the settings held by a context.
+  ASIO_DECL static void free_settings(void* parent, void* ptr,
+      CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  // Callback used to capture the secrets for a TLS 1.3 session.
+  ASIO_DECL static void keylog_callback(const SSL* ssl, const char* line);
+
+  // Capture a secret from a line passed to the key logging callback.
+  ASIO_DECL static void save_secret(const SSL* ssl, const char* line);
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+  // Whether the kernel protects data sent on the socket.
+  bool send_;
+
+  // Whether the kernel protects data received on the socket.
+  bool receive_;
+
+  // Whether the peer's close_notify alert has been received by the kernel.
+  bool close_notify_received_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/detail/impl/kernel_tls.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_DETAIL_KERNEL_TLS_HPP
@@ -0,0 +1,282 @@
+//
+// ssl/detail/kernel_tls_io.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_KERNEL_TLS_IO_HPP
+#define ASIO_SSL_DETAIL_KERNEL_TLS_IO_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/basic_stream_socket.hpp"
+#include "asio/compose.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/post.hpp"
+#include "asio/ssl/detail/io.hpp"
+#include "asio/ssl/detail/kernel_tls.hpp"
+#include "asio/ssl/detail/stream_core.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// Get the descriptor on which kernel TLS may be installed. Only TCP sockets
+// are supported, so other stream types never have one.
+template <typename Stream>
+inline int kernel_tls_descriptor(Stream&)
+{
+  return -1;
+}
+
+#if defined(ASIO_HAS_SSL_KERNEL_TLS)
+template <typename Protocol, typename Executor>
+inline int kernel_tls_descriptor(basic_stream_socket<Protocol, Executor>& s)
+{
+  return s.is_open() ? s.native_handle() : -1;
+}
+#endif // defined(ASIO_HAS_SSL_KERNEL_TLS)
+
+// Whether kernel TLS should be installed once the handshake completes.
+template <typename Stream>
+inline bool kernel_tls_requested(Stream& next_layer, stream_core& core)
+{
+  return kernel_tls::is_enabled(
+      ::SSL_get_SSL_CTX(core.engine_.native_handle()))
+    && kernel_tls_descriptor(next_layer) != -1;
+}
+
+// Install kernel TLS following a successful handshake.
+template <typename Stream>
+inline void kernel_tls_install(Stream& next_layer, stream_core& core)
+{
+  core.kernel_tls_.install(core.engine_.native_handle(),
+      kernel_tls_descriptor(next_layer), core.input_.size() != 0);
+}
+
+template <typename Stream, typename Operation>
+std::size_t kernel_tls_handshake(Stream& next_layer, stream_core& core,
+    const Operation& op, asio::error_code& ec)
+{
+  std::size_t bytes_transferred = io(next_layer, core, op, ec);
+  if (!ec && kernel_tls_requested(next_layer, core))
+    kernel_tls_install(next_layer, core);
+  return bytes_transferred;
+}
+
+template <typename Stream, typename MutableBufferSequence>
+std::size_t kernel_tls_read_some(Stream& next_layer, stream_core& core,
+    const MutableBufferSequence& buffers, asio::error_code& ec)
+{
+  for (;;)
+  {
+    std::size_t bytes_transferred = next_layer.read_some(buffers, ec);
+    if (!kernel_tls::is_control_record(ec))
+    {
+      core.kernel_tls_.map_error_code(ec);
+      return bytes_transferred;
+    }
+
+    if (!core.kernel_tls_.read_control_record(
+          kernel_tls_descriptor(next_layer), ec))
+    {
+      core.kernel_tls_.map_error_code(ec);
+      return 0;
+    }
+  }
+}
+
+template <typename Stream>
+void kernel_tls_shutdown(Stream&, stream_core&, asio::error_code& ec)
+{
+  ec = asio::error::operation_not_supported;
+}
+
+template <typename Protocol, typename Executor>
+void kernel_tls_shutdown(basic_stream_socket<Protocol, Executor>& s,
+    stream_core& core, asio::error_code& ec)
+{
+  while (core.kernel_tls_.send_close_notify(kernel_tls_descriptor(s), ec)
+      == asio::error::would_block)
+  {
+    s.wait(socket_base::wait_write, ec);
+    if (ec)
+      return;
+  }
+}
+
+// Wait until the socket is ready to send. Only sockets use kernel TLS, so the
+// generic form is never used.
+template <typename Stream, typename Handler>
+void kernel_tls_async_wait_write(Stream& next_layer, Handler& handler)
+{
+  asio::post(next_layer.get_executor(),
+      asio::detail::bind_handler(ASIO_MOVE_CAST(Handler)(handler),
+        asio::error_code(asio::error::operation_not_supported)));
+}
+
+template <typename Protocol, typename Executor, typename Handler>
+void kernel_tls_async_wait_write(
+    basic_stream_socket<Protocol, Executor>& s, Handler& handler)
+{
+  s.async_wait(socket_base::wait_write, ASIO_MOVE_CAST(Handler)(handler));
+}
+
+// Adapts the completion of a handshake operation to a composed operation.
+template <typename Self>
+class kernel_tls_completion
+{
+public:
+  explicit kernel_tls_completion(Self& self)
+    : self_(self)
+  {
+  }
+
+  void operator()(const asio::error_code& ec)
+  {
+    self_.complete(ec);
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t bytes_transferred)
+  {
+    self_.complete(ec, bytes_transferred);
+  }
+
+private:
+  Self& self_;
+};
+
+template <typename Stream, typename Operation>
+class kernel_tls_handshake_op
+{
+public:
+  kernel_tls_handshake_op(Stream& next_layer,
+      stream_core& core, const Operation& op)
+    : next_layer_(next_layer),
+      core_(core),
+      op_(op),
+      start_(true)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self,
+      const asio::error_code& ec = asio::error_code(),
+      std::size_t bytes_transferred = 0)
+  {
+    if (start_)
+    {
+      start_ = false;
+      async_io(next_layer_, core_, op_, self);
+      return;
+    }
+
+    if (!ec)
+      kernel_tls_install(next_layer_, core_);
+
+    kernel_tls_completion<Self> completion(self);
+    op_.call_handler(completion, ec, bytes_transferred);
+  }
+
+private:
+  Stream& next_layer_;
+  stream_core& core_;
+  Operation op_;
+  bool start_;
+};
+
+template <typename Stream, typename MutableBufferSequence>
+class kernel_tls_read_op
+{
+public:
+  kernel_tls_read_op(Stream& next_layer,
+      stream_core& core, const MutableBufferSequence& buffers)
+    : next_layer_(next_layer),
+      core_(core),
+      buffers_(buffers),
+      start_(true)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self,
+      asio::error_code ec = asio::error_code(),
+      std::size_t bytes_transferred = 0)
+  {
+    if (start_)
+    {
+      start_ = false;
+      next_layer_.async_read_some(buffers_, ASIO_MOVE_CAST(Self)(self));
+      return;
+    }
+
+    if (kernel_tls::is_control_record(ec)
+        && core_.kernel_tls_.read_control_record(
+          kernel_tls_descriptor(next_layer_), ec))
+    {
+      next_layer_.async_read_some(buffers_, ASIO_MOVE_CAST(Self)(self));
+      return;
+    }
+
+    core_.kernel_tls_.map_error_code(ec);
+    self.complete(ec, bytes_transferred);
+  }
+
+private:
+  Stream& next_layer_;
+  stream_core& core_;
+  MutableBufferSequence buffers_;
+  bool start_;
+};
+
+template <typename Stream>
+class kernel_tls_shutdown_op
+{
+public:
+  kernel_tls_shutdown_op(Stream& next_layer, stream_core& core)
+    : next_layer_(next_layer),
+      core_(core),
+      start_(true)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code())
+  {
+    // The alert is sent once the socket is ready, so that the handler is not
+    // called from the initiating function.
+    if (start_ || (!ec && core_.kernel_tls_.send_close_notify(
+            kernel_tls_descriptor(next_layer_), ec)
+          == asio::error::would_block))
+    {
+      start_ = false;
+      kernel_tls_async_wait_write(next_layer_, self);
+      return;
+    }
+
+    self.complete(ec);
+  }
+
+private:
+  Stream& next_layer_;
+  stream_core& core_;
+  bool start_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_DETAIL_KERNEL_TLS_IO_HPP
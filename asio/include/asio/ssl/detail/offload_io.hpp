@@ -0,0 +1,203 @@
+//
+// ssl/detail/offload_io.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_DETAIL_OFFLOAD_IO_HPP
+#define ASIO_SSL_DETAIL_OFFLOAD_IO_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include "asio/any_io_executor.hpp"
+#include "asio/compose.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/post.hpp"
+#include "asio/ssl/detail/engine.hpp"
+#include "asio/ssl/detail/kernel_tls_io.hpp"
+#include "asio/ssl/detail/stream_core.hpp"
+#include "asio/write.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+namespace detail {
+
+// Performs one step of an operation on the engine, and then resumes the
+// composed operation on its own executor. The step has no associated
+// executor, so that it runs on the executor to which it is posted.
+template <typename Operation, typename Self>
+class offload_step
+{
+public:
+  offload_step(stream_core& core, const Operation& op,
+      std::size_t bytes_transferred, Self& self)
+    : core_(core),
+      op_(op),
+      bytes_transferred_(bytes_transferred),
+      self_(ASIO_MOVE_CAST(Self)(self))
+  {
+  }
+
+  void operator()()
+  {
+    asio::error_code ec;
+    engine::want want = op_(core_.engine_, ec, bytes_transferred_);
+    asio::post(asio::detail::bind_handler(ASIO_MOVE_CAST(Self)(self_),
+          want, ec, bytes_transferred_));
+  }
+
+private:
+  stream_core& core_;
+  Operation op_;
+  std::size_t bytes_transferred_;
+  Self self_;
+};
+
+// Performs an operation in the same way as io_op, except that the engine is
+// run on another executor. Reads and writes on the next layer are started from
+// the composed operation's executor.
+template <typename Stream, typename Operation>
+class offload_io_op
+{
+public:
+  offload_io_op(Stream& next_layer, stream_core& core,
+      const Operation& op, const any_io_executor& ex)
+    : next_layer_(next_layer),
+      core_(core),
+      op_(op),
+      executor_(ex),
+      want_(engine::want_nothing),
+      bytes_transferred_(0)
+  {
+  }
+
+  // Start the operation. The first step is always posted to the offload
+  // executor, so the handler is never called from the initiating function.
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    offload(self);
+  }
+
+  // Resume after a step has been performed on the engine.
+  template <typename Self>
+  void operator()(Self& self, engine::want want,
+      const asio::error_code& ec, std::size_t bytes_transferred)
+  {
+    want_ = want;
+    ec_ = ec;
+    bytes_transferred_ = bytes_transferred;
+
+    switch (want_)
+    {
+    case engine::want_input_and_retry:
+
+      // If the input buffer already has data in it we can pass it to the
+      // engine and then retry the operation immediately.
+      if (core_.input_.size() != 0)
+      {
+        core_.input_ = core_.engine_.put_input(core_.input_);
+        offload(self);
+        return;
+      }
+
+      next_layer_.async_read_some(asio::buffer(core_.input_buffer_),
+          ASIO_MOVE_CAST(Self)(self));
+      return;
+
+    case engine::want_output_and_retry:
+    case engine::want_output:
+
+      // The engine wants some data to be written to the output, even if the
+      // operation has failed, so that any alert is sent to the peer.
+      asio::async_write(next_layer_,
+          core_.engine_.get_output(core_.output_buffer_),
+          ASIO_MOVE_CAST(Self)(self));
+      return;
+
+    default:
+      complete(self);
+      return;
+    }
+  }
+
+  // Resume after a read or write on the next layer.
+  template <typename Self>
+  void operator()(Self& self, const asio::error_code& ec,
+      std::size_t bytes_transferred)
+  {
+    if (want_ == engine::want_input_and_retry)
+    {
+      if (ec)
+      {
+        ec_ = ec;
+        complete(self);
+        return;
+      }
+
+      core_.input_ = asio::buffer(core_.input_buffer_, bytes_transferred);
+      core_.input_ = core_.engine_.put_input(core_.input_);
+      offload(self);
+      return;
+    }
+
+    core_.engine_.release_output();
+    if (!ec_)
+      ec_ = ec;
+    if (ec_ || want_ == engine::want_output)
+    {
+      complete(self);
+      return;
+    }
+
+    offload(self);
+  }
+
+private:
+  template <typename Self>
+  void offload(Self& self)
+  {
+    // The executor is copied because the step takes ownership of the
+    // composed operation, and with it this object.
+    any_io_executor ex(executor_);
+    asio::post(ex, offload_step<Operation, Self>(
+          core_, op_, bytes_transferred_, self));
+  }
+
+  template <typename Self>
+  void complete(Self& self)
+  {
+    core_.engine_.map_error_code(ec_);
+    if (!ec_ && kernel_tls_requested(next_layer_, core_))
+      kernel_tls_install(next_layer_, core_);
+
+    kernel_tls_completion<Self> completion(self);
+    op_.call_handler(completion, ec_, ec_ ? 0 : bytes_transferred_);
+  }
+
+  Stream& next_layer_;
+  stream_core& core_;
+  Operation op_;
+  any_io_executor executor_;
+  engine::want want_;
+  asio::error_code ec_;
+  std::size_t bytes_transferred_;
+};
+
+} // namespace detail
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_DETAIL_OFFLOAD_IO_HPP
@@ -22,7 +22,9 @@
 #else // defined(ASIO_HAS_BOOST_DATE_TIME)
 # include "asio/steady_timer.hpp"
 #endif // defined(ASIO_HAS_BOOST_DATE_TIME)
+#include "asio/any_io_executor.hpp"
 #include "asio/ssl/detail/engine.hpp"
+#include "asio/ssl/detail/kernel_tls.hpp"
 #include "asio/buffer.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -77,7 +79,10 @@ struct stream_core
           ASIO_MOVE_CAST(std::vector<unsigned char>)(
             other.input_buffer_space_)),
       input_buffer_(other.input_buffer_),
-      input_(other.input_)
+      input_(other.input_),
+      kernel_tls_(other.kernel_tls_),
+      handshake_executor_(
+          ASIO_MOVE_CAST(any_io_executor)(other.handshake_executor_))
   {
     other.output_buffer_ = asio::mutable_buffer(0, 0);
     other.input_buffer_ = asio::mutable_buffer(0, 0);
@@ -89,6 +94,36 @@ struct stream_core
   {
   }
 
+  // Resize the buffers used to transfer records to and from the transport,
+  // and have the engine use them directly.
+  asio::error_code use_direct_io(std::size_t input_buffer_size,
+      std::size_t output_buffer_size, asio::error_code& ec)
+  {
+    if (input_buffer_size == 0 || output_buffer_size == 0)
+    {
+      ec = asio::error::invalid_argument;
+      return ec;
+    }
+
+    if (input_.size() != 0)
+    {
+      ec = asio::error::already_started;
+      return ec;
+    }
+
+    std::vector<unsigned char> input_space(input_buffer_size);
+    std::vector<unsigned char> output_space(output_buffer_size);
+    if (!engine_.use_direct_io(asio::buffer(input_space),
+          asio::buffer(output_space), ec))
+    {
+      input_buffer_space_.swap(input_space);
+      input_buffer_ = asio::buffer(input_buffer_space_);
+      output_buffer_space_.swap(output_space);
+      output_buffer_ = asio::buffer(output_buffer_space_);
+    }
+    return ec;
+  }
+
   // The SSL engine.
   engine engine_;
 
@@ -158,6 +193,12 @@ struct stream_core
 
   // The buffer pointing to the engine's unconsumed input.
   asio::const_buffer input_;
+
+  // The state of record protection performed by the kernel.
+  kernel_tls kernel_tls_;
+
+  // The executor used to run the engine during a handshake, if any.
+  any_io_executor handshake_executor_;
 };
 
 } // namespace detail
@@ -22,6 +22,7 @@
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 #include "asio/ssl/context.hpp"
+#include "asio/ssl/detail/kernel_tls.hpp"
 #include "asio/ssl/error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -529,6 +530,34 @@ ASIO_SYNC_OP_VOID context::set_verify_depth(
   ASIO_SYNC_OP_VOID_RETURN(ec);
 }
 
+void context::set_kernel_tls(bool enabled)
+{
+  asio::error_code ec;
+  set_kernel_tls(enabled, ec);
+  asio::detail::throw_error(ec, "set_kernel_tls");
+}
+
+ASIO_SYNC_OP_VOID context::set_kernel_tls(
+    bool enabled, asio::error_code& ec)
+{
+  detail::kernel_tls::set_enabled(handle_, enabled, ec);
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+void context::set_session_cache(session_cache& cache)
+{
+  asio::error_code ec;
+  set_session_cache(cache, ec);
+  asio::detail::throw_error(ec, "set_session_cache");
+}
+
+ASIO_SYNC_OP_VOID context::set_session_cache(
+    session_cache& cache, asio::error_code& ec)
+{
+  session_cache::attach(handle_, &cache, ec);
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
 void context::load_verify_file(const std::string& filename)
 {
   asio::error_code ec;
@@ -0,0 +1,470 @@
+//
+// ssl/impl/session_cache.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_IMPL_SESSION_CACHE_IPP
+#define ASIO_SSL_IMPL_SESSION_CACHE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <cstring>
+#include <ctime>
+#include <openssl/rand.h>
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+#include "asio/ssl/error.hpp"
+#include "asio/ssl/session_cache.hpp"
+
+#if defined(ASIO_HAS_SSL_SESSION_CACHE)
+# include "asio/detail/static_mutex.hpp"
+# if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#  include <openssl/core_names.h>
+# else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#  include <openssl/hmac.h>
+# endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#endif // defined(ASIO_HAS_SSL_SESSION_CACHE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+session_cache::session_cache(std::size_t max_sessions)
+  : max_size_(max_sessions),
+    hits_(0),
+    misses_(0),
+    has_previous_key_(false)
+{
+  asio::error_code ec;
+  generate(current_key_, ec);
+  asio::detail::throw_error(ec, "session_cache");
+}
+
+session_cache::~session_cache()
+{
+  clear();
+  ::OPENSSL_cleanse(&current_key_, sizeof(current_key_));
+  ::OPENSSL_cleanse(&previous_key_, sizeof(previous_key_));
+}
+
+std::size_t session_cache::size() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return index_.size();
+}
+
+std::size_t session_cache::hits() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return hits_;
+}
+
+std::size_t session_cache::misses() const
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  return misses_;
+}
+
+void session_cache::clear()
+{
+  session_list sessions;
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  sessions.swap(sessions_);
+  index_.clear();
+  lock.unlock();
+
+  for (session_list::iterator i = sessions.begin(); i != sessions.end(); ++i)
+    ::SSL_SESSION_free(i->second);
+}
+
+void session_cache::rotate_ticket_keys()
+{
+  asio::error_code ec;
+  rotate_ticket_keys(ec);
+  asio::detail::throw_error(ec, "rotate_ticket_keys");
+}
+
+ASIO_SYNC_OP_VOID session_cache::rotate_ticket_keys(asio::error_code& ec)
+{
+  ticket_key key;
+  if (!generate(key, ec))
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    previous_key_ = current_key_;
+    current_key_ = key;
+    has_previous_key_ = true;
+  }
+
+  ::OPENSSL_cleanse(&key, sizeof(key));
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+asio::error_code session_cache::attach(SSL_CTX* ctx,
+    session_cache* cache, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_SSL_SESSION_CACHE)
+  int index = cache_index();
+  if (index < 0 || key_index() < 0)
+  {
+    ec = asio::error_code(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    return ec;
+  }
+
+  ::SSL_CTX_set_ex_data(ctx, index, cache);
+
+  // The context's internal cache is bypassed so that sessions are held only
+  // by the attached cache.
+  ::SSL_CTX_set_session_cache_mode(ctx,
+      SSL_SESS_CACHE_BOTH | SSL_SESS_CACHE_NO_INTERNAL);
+  ::SSL_CTX_sess_set_new_cb(ctx, &session_cache::new_session_callback);
+  ::SSL_CTX_sess_set_get_cb(ctx, &session_cache::get_session_callback);
+  ::SSL_CTX_sess_set_remove_cb(ctx, &session_cache::remove_session_callback);
+# if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  ::SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx,
+      &session_cache::ticket_key_callback);
+# else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  SSL_CTX_set_tlsext_ticket_key_cb(ctx, &session_cache::ticket_key_callback);
+# endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+  ec = asio::error_code();
+  return ec;
+#else // defined(ASIO_HAS_SSL_SESSION_CACHE)
+  (void)ctx;
+  (void)cache;
+  ec = asio::error::operation_not_supported;
+  return ec;
+#endif // defined(ASIO_HAS_SSL_SESSION_CACHE)
+}
+
+asio::error_code session_cache::use_key(SSL* ssl,
+    const std::string& key, asio::error_code& ec)
+{
+#if defined(ASIO_HAS_SSL_SESSION_CACHE)
+  session_cache* cache = get(ssl);
+  if (!cache)
+  {
+    ec = asio::error::not_found;
+    return ec;
+  }
+
+  if (::SSL_is_server(ssl))
+  {
+    ec = asio::error::operation_not_supported;
+    return ec;
+  }
+
+  if (!::SSL_in_before(ssl))
+  {
+    ec = asio::error::already_started;
+    return ec;
+  }
+
+  int index = key_index();
+  delete static_cast<std::string*>(::SSL_get_ex_data(ssl, index));
+  ::SSL_set_ex_data(ssl, index, new std::string(key));
+
+  if (SSL_SESSION* session = cache->find('c' + key))
+  {
+    ::SSL_set_session(ssl, session);
+    ::SSL_SESSION_free(session);
+  }
+
+  ec = asio::error_code();
+  return ec;
+#else // defined(ASIO_HAS_SSL_SESSION_CACHE)
+  (void)ssl;
+  (void)key;
+  ec = asio::error::operation_not_supported;
+  return ec;
+#endif // defined(ASIO_HAS_SSL_SESSION_CACHE)
+}
+
+asio::error_code session_cache::generate(
+    ticket_key& key, asio::error_code& ec)
+{
+  if (::RAND_bytes(key.name, sizeof(key.name)) != 1
+      || ::RAND_bytes(key.mac_key, sizeof(key.mac_key)) != 1
+      || ::RAND_bytes(key.cipher_key, sizeof(key.cipher_key)) != 1)
+  {
+    ec = asio::error_code(
+        static_cast<int>(::ERR_get_error()),
+        asio::error::get_ssl_category());
+    return ec;
+  }
+
+  ec = asio::error_code();
+  return ec;
+}
+
+#if defined(ASIO_HAS_SSL_SESSION_CACHE)
+
+SSL_SESSION* session_cache::find(const std::string& key)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  std::map<std::string, session_list::iterator>::iterator iter
+    = index_.find(key);
+  if (iter != index_.end())
+  {
+    SSL_SESSION* session = iter->second->second;
+    long expiry = ::SSL_SESSION_get_time(session)
+      + ::SSL_SESSION_get_timeout(session);
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    bool resumable = ::SSL_SESSION_is_resumable(session) != 0;
+#else // (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    bool resumable = true;
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    if (resumable && expiry > static_cast<long>(std::time(0)))
+    {
+      sessions_.splice(sessions_.begin(), sessions_, iter->second);
+      ::SSL_SESSION_up_ref(session);
+      ++hits_;
+      return session;
+    }
+
+    // Sessions that can no longer be resumed are discarded.
+    sessions_.erase(iter->second);
+    index_.erase(iter);
+    ::SSL_SESSION_free(session);
+  }
+
+  ++misses_;
+  return 0;
+}
+
+void session_cache::store(const std::string& key, SSL_SESSION* session)
+{
+  session_list discarded;
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  std::map<std::string, session_list::iterator>::iterator iter
+    = index_.find(key);
+  if (iter != index_.end())
+  {
+    discarded.splice(discarded.end(), sessions_, iter->second);
+    index_.erase(iter);
+  }
+
+  sessions_.push_front(std::make_pair(key, session));
+  index_[key] = sessions_.begin();
+
+  while (index_.size() > max_size_)
+  {
+    index_.erase(sessions_.back().first);
+    discarded.splice(discarded.end(), sessions_, --sessions_.end());
+  }
+
+  lock.unlock();
+
+  for (session_list::iterator i = discarded.begin(); i != discarded.end(); ++i)
+    ::SSL_SESSION_free(i->second);
+}
+
+void session_cache::erase(const std::string& key)
+{
+  SSL_SESSION* session = 0;
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  std::map<std::string, session_list::iterator>::iterator iter
+    = index_.find(key);
+  if (iter != index_.end())
+  {
+    session = iter->second->second;
+    sessions_.erase(iter->second);
+    index_.erase(iter);
+  }
+
+  lock.unlock();
+
+  if (session)
+    ::SSL_SESSION_free(session);
+}
+
+std::string session_cache::server_key(SSL_SESSION* session)
+{
+  unsigned int length = 0;
+  const unsigned char* id = ::SSL_SESSION_get_id(session, &length);
+  std::string key(1, 's');
+  key.append(reinterpret_cast<const char*>(id), length);
+  return key;
+}
+
+int session_cache::cache_index()
+{
+  static asio::detail::static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  static int index = -1;
+  mutex.init();
+  asio::detail::static_mutex::scoped_lock lock(mutex);
+  if (index < 0)
+    index = ::SSL_CTX_get_ex_new_index(0, 0, 0, 0, 0);
+  return index;
+}
+
+int session_cache::key_index()
+{
+  static asio::detail::static_mutex mutex = ASIO_STATIC_MUTEX_INIT;
+  static int index = -1;
+  mutex.init();
+  asio::detail::static_mutex::scoped_lock lock(mutex);
+  if (index < 0)
+    index = ::SSL_get_ex_new_index(0, 0, 0, 0, &session_cache::free_key);
+  return index;
+}
+
+session_cache* session_cache::get(SSL* ssl)
+{
+  int index = cache_index();
+  return index < 0 ? 0 : static_cast<session_cache*>(
+      ::SSL_CTX_get_ex_data(::SSL_get_SSL_CTX(ssl), index));
+}
+
+void session_cache::free_key(void*, void* ptr,
+    CRYPTO_EX_DATA*, int, long, void*)
+{
+  delete static_cast<std::string*>(ptr);
+}
+
+int session_cache::new_session_callback(SSL* ssl, SSL_SESSION* session)
+{
+  session_cache* cache = get(ssl);
+  if (!cache)
+    return 0;
+
+  if (::SSL_is_server(ssl))
+  {
+    // A TLS 1.3 session resumed using a ticket is held entirely within the
+    // ticket, so there is nothing to store.
+    if (::SSL_version(ssl) == TLS1_3_VERSION
+        && (::SSL_get_options(ssl) & SSL_OP_NO_TICKET) == 0)
+      return 0;
+
+    cache->store(server_key(session), session);
+    return 1;
+  }
+
+  // Only the sessions of client streams given a key are stored.
+  std::string* key = static_cast<std::string*>(
+      ::SSL_get_ex_data(ssl, key_index()));
+  if (!key)
+    return 0;
+
+  cache->store('c' + *key, session);
+  return 1;
+}
+
+SSL_SESSION* session_cache::get_session_callback(SSL* ssl,
+    const unsigned char* id, int length, int* copy)
+{
+  *copy = 0;
+
+  session_cache* cache = get(ssl);
+  if (!cache || length < 0)
+    return 0;
+
+  std::string key(1, 's');
+  key.append(reinterpret_cast<const char*>(id),
+      static_cast<std::size_t>(length));
+  return cache->find(key);
+}
+
+void session_cache::remove_session_callback(
+    SSL_CTX* ctx, SSL_SESSION* session)
+{
+  int index = cache_index();
+  if (session_cache* cache = index < 0 ? 0
+      : static_cast<session_cache*>(::SSL_CTX_get_ex_data(ctx, index)))
+    cache->erase(server_key(session));
+}
+
+int session_cache::ticket_key_callback(SSL* ssl, unsigned char* name,
+    unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+    ticket_mac_ctx* mac_ctx, int enc)
+{
+  using namespace std; // For memcmp and memcpy.
+
+  session_cache* cache = get(ssl);
+  if (!cache)
+    return -1;
+
+  // Select the key. A ticket protected by the previous key is still accepted.
+  // A decrypted TLS 1.3 ticket is always renewed, since clients use each
+  // ticket only once. TLS 1.2 tickets are never renewed, as a client that
+  // receives a new ticket during resumption discards its session without
+  // storing the new one. Encryption succeeds with 1.
+  ticket_key key;
+  int result = !enc && ::SSL_version(ssl) >= TLS1_3_VERSION ? 2 : 1;
+  {
+    asio::detail::mutex::scoped_lock lock(cache->mutex_);
+    if (enc)
+    {
+      key = cache->current_key_;
+    }
+    else if (memcmp(name, cache->current_key_.name, sizeof(key.name)) == 0)
+    {
+      key = cache->current_key_;
+      ++cache->hits_;
+    }
+    else if (cache->has_previous_key_ && memcmp(name,
+          cache->previous_key_.name, sizeof(key.name)) == 0)
+    {
+      key = cache->previous_key_;
+      ++cache->hits_;
+    }
+    else
+    {
+      ++cache->misses_;
+      return 0;
+    }
+  }
+
+  if (enc)
+  {
+    memcpy(name, key.name, sizeof(key.name));
+    if (::RAND_bytes(iv, EVP_CIPHER_iv_length(::EVP_aes_256_cbc())) != 1)
+      result = -1;
+  }
+
+  if (result != -1 && ::EVP_CipherInit_ex(cipher_ctx,
+        ::EVP_aes_256_cbc(), 0, key.cipher_key, iv, enc) != 1)
+    result = -1;
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  char digest[] = "SHA256";
+  OSSL_PARAM params[3];
+  params[0] = ::OSSL_PARAM_construct_octet_string(
+      OSSL_MAC_PARAM_KEY, key.mac_key, sizeof(key.mac_key));
+  params[1] = ::OSSL_PARAM_construct_utf8_string(
+      OSSL_MAC_PARAM_DIGEST, digest, 0);
+  params[2] = ::OSSL_PARAM_construct_end();
+  if (result != -1 && ::EVP_MAC_CTX_set_params(mac_ctx, params) != 1)
+    result = -1;
+#else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  if (result != -1 && ::HMAC_Init_ex(mac_ctx, key.mac_key,
+        sizeof(key.mac_key), ::EVP_sha256(), 0) != 1)
+    result = -1;
+#endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+  ::OPENSSL_cleanse(&key, sizeof(key));
+  return result;
+}
+
+#endif // defined(ASIO_HAS_SSL_SESSION_CACHE)
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_SSL_IMPL_SESSION_CACHE_IPP
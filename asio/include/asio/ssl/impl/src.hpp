@@ -22,8 +22,10 @@
 #include "asio/ssl/impl/context.ipp"
 #include "asio/ssl/impl/error.ipp"
 #include "asio/ssl/detail/impl/engine.ipp"
+#include "asio/ssl/detail/impl/kernel_tls.ipp"
 #include "asio/ssl/detail/impl/openssl_init.ipp"
 #include "asio/ssl/impl/host_name_verification.ipp"
 #include "asio/ssl/impl/rfc2818_verification.ipp"
+#include "asio/ssl/impl/session_cache.ipp"
 
 #endif // ASIO_SSL_IMPL_SRC_HPP
@@ -0,0 +1,244 @@
+//
+// ssl/session_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_SSL_SESSION_CACHE_HPP
+#define ASIO_SSL_SESSION_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error_code.hpp"
+#include "asio/ssl/detail/openssl_types.hpp"
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) \
+  && !defined(OPENSSL_IS_BORINGSSL) \
+  && !defined(ASIO_USE_WOLFSSL)
+# define ASIO_HAS_SSL_SESSION_CACHE 1
+#endif // (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+       //   && !defined(OPENSSL_IS_BORINGSSL)
+       //   && !defined(ASIO_USE_WOLFSSL)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ssl {
+
+class context;
+template <typename Stream> class stream;
+
+/// A bounded cache of SSL sessions that allows handshakes to be resumed.
+/**
+ * A session cache is attached to one or more contexts using
+ * ssl::context::set_session_cache().
+ *
+ * On the client side, sessions are stored under a key chosen by the
+ * application, typically the host name and port of the server. A stream
+ * resumes the session stored under a key when the key is given to
+ * ssl::stream::set_session_cache_key() before the handshake, and the session
+ * negotiated by the handshake is then stored under the same key.
+ *
+ * On the server side, sessions are stored under their session identifiers,
+ * and session tickets are protected by keys held by the cache. Calling
+ * rotate_ticket_keys() replaces the key used for new tickets, while tickets
+ * issued with the previous key continue to be accepted.
+ *
+ * A session is only resumed if the stream that negotiated it was shut down
+ * gracefully.
+ *
+ * When the cache is full, the least recently used session is discarded.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @note The cache must outlive the contexts to which it is attached, and the
+ * streams created from them.
+ */
+class session_cache
+  : private noncopyable
+{
+public:
+  /// Construct a cache that holds at most the given number of sessions.
+  ASIO_DECL explicit session_cache(std::size_t max_sessions = 1024);
+
+  /// Destructor.
+  ASIO_DECL ~session_cache();
+
+  /// Get the maximum number of sessions held by the cache.
+  std::size_t max_size() const
+  {
+    return max_size_;
+  }
+
+  /// Get the number of sessions held by the cache.
+  ASIO_DECL std::size_t size() const;
+
+  /// Get the number of times a session was requested and found.
+  /**
+   * Counts the sessions found for client streams and for resuming servers,
+   * and the session tickets that were decrypted using a key held by the
+   * cache.
+   */
+  ASIO_DECL std::size_t hits() const;
+
+  /// Get the number of times a session was requested but not found.
+  /**
+   * Counts the sessions not found, or found to have expired, for client
+   * streams and for resuming servers, and the session tickets that were
+   * protected by a key no longer held by the cache.
+   */
+  ASIO_DECL std::size_t misses() const;
+
+  /// Remove all sessions from the cache.
+  ASIO_DECL void clear();
+
+  /// Replace the key used to protect new session tickets.
+  /**
+   * Tickets issued using the key being replaced are still accepted. Tickets
+   * issued using any earlier key are rejected. A TLS 1.3 ticket is replaced
+   * each time it is used, but a TLS 1.2 ticket is used until it is rejected.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @note Calls @c RAND_bytes.
+   */
+  ASIO_DECL void rotate_ticket_keys();
+
+  /// Replace the key used to protect new session tickets.
+  /**
+   * Tickets issued using the key being replaced are still accepted. Tickets
+   * issued using any earlier key are rejected. A TLS 1.3 ticket is replaced
+   * each time it is used, but a TLS 1.2 ticket is used until it is rejected.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @note Calls @c RAND_bytes.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID rotate_ticket_keys(asio::error_code& ec);
+
+private:
+  friend class context;
+  template <typename Stream> friend class stream;
+
+  // Attach the cache to a context.
+  ASIO_DECL static asio::error_code attach(SSL_CTX* ctx,
+      session_cache* cache, asio::error_code& ec);
+
+  // Resume the session stored under the given key when the client stream's
+  // handshake is performed, and store the new session under the same key.
+  // Not supported on a server stream.
+  ASIO_DECL static asio::error_code use_key(SSL* ssl,
+      const std::string& key, asio::error_code& ec);
+
+#if defined(ASIO_HAS_SSL_SESSION_CACHE)
+  // Find a session and count the result. Returns a new reference to the
+  // session, or 0 if none is found.
+  ASIO_DECL SSL_SESSION* find(const std::string& key);
+
+  // Store a session, taking ownership of the caller's reference.
+  ASIO_DECL void store(const std::string& key, SSL_SESSION* session);
+
+  // Remove a session.
+  ASIO_DECL void erase(const std::string& key);
+
+  // Get the key under which a server stores a session.
+  ASIO_DECL static std::string server_key(SSL_SESSION* session);
+
+  // Get the SSL_CTX ex_data index used to hold the cache.
+  ASIO_DECL static int cache_index();
+
+  // Get the SSL ex_data index used to hold a client stream's key.
+  ASIO_DECL static int key_index();
+
+  // Get the cache attached to a session's context.
+  ASIO_DECL static session_cache* get(SSL* ssl);
+
+  // Free the key held by a client stream.
+  ASIO_DECL static void free_key(void* parent, void* ptr,
+      CRYPTO_EX_DATA* ad, int idx, long argl, void* argp);
+
+  // Callback used when a new session has been negotiated.
+  ASIO_DECL static int new_session_callback(SSL* ssl, SSL_SESSION* session);
+
+  // Callback used when a server looks up a session by its identifier.
+  ASIO_DECL static SSL_SESSION* get_session_callback(SSL* ssl,
+      const unsigned char* id, int length, int* copy);
+
+  // Callback used when a session should no longer be resumed.
+  ASIO_DECL static void remove_session_callback(
+      SSL_CTX* ctx, SSL_SESSION* session);
+
+# if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  typedef EVP_MAC_CTX ticket_mac_ctx;
+# else // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+  typedef HMAC_CTX ticket_mac_ctx;
+# endif // (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+
+  // Callback used to encrypt and decrypt session tickets.
+  ASIO_DECL static int ticket_key_callback(SSL* ssl, unsigned char* name,
+      unsigned char* iv, EVP_CIPHER_CTX* cipher_ctx,
+      ticket_mac_ctx* mac_ctx, int enc);
+#endif // defined(ASIO_HAS_SSL_SESSION_CACHE)
+
+  // The keys used to protect session tickets.
+  struct ticket_key
+  {
+    unsigned char name[16];
+    unsigned char mac_key[32];
+    unsigned char cipher_key[32];
+  };
+
+  // Generate a new ticket key.
+  ASIO_DECL static asio::error_code generate(
+      ticket_key& key, asio::error_code& ec);
+
+  // The sessions, ordered from most to least recently used.
+  typedef std::list<std::pair<std::string, SSL_SESSION*> > session_list;
+  session_list sessions_;
+
+  // The sessions, indexed by key.
+  std::map<std::string, session_list::iterator> index_;
+
+  // The maximum number of sessions held.
+  std::size_t max_size_;
+
+  // The number of sessions requested and found or not found.
+  std::size_t hits_;
+  std::size_t misses_;
+
+  // The key used for new tickets, and the key it replaced.
+  ticket_key current_key_;
+  ticket_key previous_key_;
+  bool has_previous_key_;
+
+  // Mutex to protect access to the cache.
+  mutable asio::detail::mutex mutex_;
+};
+
+} // namespace ssl
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ssl/impl/session_cache.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_SSL_SESSION_CACHE_HPP
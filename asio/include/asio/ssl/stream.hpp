@@ -23,10 +23,14 @@
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/type_traits.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/is_executor.hpp"
 #include "asio/ssl/context.hpp"
 #include "asio/ssl/detail/buffered_handshake_op.hpp"
 #include "asio/ssl/detail/handshake_op.hpp"
 #include "asio/ssl/detail/io.hpp"
+#include "asio/ssl/detail/kernel_tls_io.hpp"
+#include "asio/ssl/detail/offload_io.hpp"
 #include "asio/ssl/detail/read_op.hpp"
 #include "asio/ssl/detail/shutdown_op.hpp"
 #include "asio/ssl/detail/stream_core.hpp"
@@ -355,6 +359,157 @@ public:
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Transfer records directly between the SSL implementation and the
+  /// stream's buffers.
+  /**
+   * This function may be used to remove a copy of every record read from and
+   * written to the next layer. By default, records pass through a pair of
+   * OpenSSL memory BIOs on their way to and from the stream's buffers. Once
+   * direct I/O is enabled, the SSL implementation reads records from, and
+   * writes records to, the stream's buffers itself.
+   *
+   * @param input_buffer_size The size of the buffer used to read records from
+   * the next layer.
+   *
+   * @param output_buffer_size The size of the buffer used to write records to
+   * the next layer. Records larger than this buffer are written in parts.
+   *
+   * @throws asio::system_error Thrown on failure. Fails with
+   * asio::error::already_started if the handshake has begun.
+   *
+   * @note Calls @c SSL_set_bio.
+   */
+  void set_direct_io(std::size_t input_buffer_size,
+      std::size_t output_buffer_size)
+  {
+    asio::error_code ec;
+    set_direct_io(input_buffer_size, output_buffer_size, ec);
+    asio::detail::throw_error(ec, "set_direct_io");
+  }
+
+  /// Transfer records directly between the SSL implementation and the
+  /// stream's buffers.
+  /**
+   * This function may be used to remove a copy of every record read from and
+   * written to the next layer. By default, records pass through a pair of
+   * OpenSSL memory BIOs on their way to and from the stream's buffers. Once
+   * direct I/O is enabled, the SSL implementation reads records from, and
+   * writes records to, the stream's buffers itself.
+   *
+   * @param input_buffer_size The size of the buffer used to read records from
+   * the next layer.
+   *
+   * @param output_buffer_size The size of the buffer used to write records to
+   * the next layer. Records larger than this buffer are written in parts.
+   *
+   * @param ec Set to indicate what error occurred, if any. Set to
+   * asio::error::already_started if the handshake has begun.
+   *
+   * @note Calls @c SSL_set_bio.
+   */
+  ASIO_SYNC_OP_VOID set_direct_io(std::size_t input_buffer_size,
+      std::size_t output_buffer_size, asio::error_code& ec)
+  {
+    core_.use_direct_io(input_buffer_size, output_buffer_size, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Resume a session from the context's session cache.
+  /**
+   * This function may be used by a client stream, before the handshake, to
+   * resume the session stored in the session cache under the given key. The
+   * session negotiated by the handshake is stored under the same key. The
+   * cache is attached using ssl::context::set_session_cache(). It may not be
+   * used by a server stream, whose sessions are found using the session ID or
+   * ticket sent by the client.
+   *
+   * @param key Identifies the server, typically by its host name and port.
+   *
+   * @throws asio::system_error Thrown on failure. Fails with
+   * asio::error::operation_not_supported on a server stream.
+   *
+   * @note Calls @c SSL_set_session.
+   */
+  void set_session_cache_key(const std::string& key)
+  {
+    asio::error_code ec;
+    set_session_cache_key(key, ec);
+    asio::detail::throw_error(ec, "set_session_cache_key");
+  }
+
+  /// Resume a session from the context's session cache.
+  /**
+   * This function may be used by a client stream, before the handshake, to
+   * resume the session stored in the session cache under the given key. The
+   * session negotiated by the handshake is stored under the same key. The
+   * cache is attached using ssl::context::set_session_cache(). It may not be
+   * used by a server stream, whose sessions are found using the session ID or
+   * ticket sent by the client.
+   *
+   * @param key Identifies the server, typically by its host name and port.
+   *
+   * @param ec Set to indicate what error occurred, if any. Set to
+   * asio::error::not_found if the context has no session cache, to
+   * asio::error::operation_not_supported on a server stream, or to
+   * asio::error::already_started if the handshake has begun.
+   *
+   * @note Calls @c SSL_set_session.
+   */
+  ASIO_SYNC_OP_VOID set_session_cache_key(
+      const std::string& key, asio::error_code& ec)
+  {
+    session_cache::use_key(core_.engine_.native_handle(), key, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Run the computation performed by asynchronous handshakes on another
+  /// executor.
+  /**
+   * This function may be used to keep the key exchange and certificate
+   * verification performed during a handshake off the threads that run the
+   * stream's executor. Each step of a handshake started by async_handshake()
+   * is run on the given executor, such as that of an asio::thread_pool, while
+   * reads and writes on the next layer are started from the handler's
+   * associated executor. Synchronous handshakes are not affected.
+   *
+   * @param ex The executor on which handshake steps are run. The executor's
+   * execution context must outlive any handshake started by the stream.
+   *
+   * @note Callbacks set on the context, such as the verify callback, are
+   * called on the given executor.
+   */
+  template <typename Executor>
+  void set_handshake_executor(const Executor& ex,
+      typename enable_if<
+        execution::is_executor<Executor>::value
+          || is_executor<Executor>::value
+      >::type* = 0)
+  {
+    core_.handshake_executor_ = ex;
+  }
+
+  /// Determine whether the kernel protects data written to the stream.
+  /**
+   * This function may be used to determine whether kernel TLS offload, as
+   * requested using ssl::context::set_kernel_tls(), was established for
+   * writes when the handshake completed.
+   */
+  bool uses_kernel_tls_send() const
+  {
+    return core_.kernel_tls_.send();
+  }
+
+  /// Determine whether the kernel protects data read from the stream.
+  /**
+   * This function may be used to determine whether kernel TLS offload, as
+   * requested using ssl::context::set_kernel_tls(), was established for
+   * reads when the handshake completed.
+   */
+  bool uses_kernel_tls_receive() const
+  {
+    return core_.kernel_tls_.receive();
+  }
+
   /// Perform SSL handshaking.
   /**
    * This function is used to perform SSL handshaking on the stream. The
@@ -385,7 +540,8 @@ public:
   ASIO_SYNC_OP_VOID handshake(handshake_type type,
       asio::error_code& ec)
   {
-    detail::io(next_layer_, core_, detail::handshake_op(type), ec);
+    detail::kernel_tls_handshake(next_layer_, core_,
+        detail::handshake_op(type), ec);
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
@@ -425,7 +581,7 @@ public:
   ASIO_SYNC_OP_VOID handshake(handshake_type type,
       const ConstBufferSequence& buffers, asio::error_code& ec)
   {
-    detail::io(next_layer_, core_,
+    detail::kernel_tls_handshake(next_layer_, core_,
         detail::buffered_handshake_op<ConstBufferSequence>(type, buffers), ec);
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
@@ -519,7 +675,10 @@ public:
    */
   ASIO_SYNC_OP_VOID shutdown(asio::error_code& ec)
   {
-    detail::io(next_layer_, core_, detail::shutdown_op(), ec);
+    if (core_.kernel_tls_.send())
+      detail::kernel_tls_shutdown(next_layer_, core_, ec);
+    else
+      detail::io(next_layer_, core_, detail::shutdown_op(), ec);
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
@@ -595,6 +754,8 @@ public:
   std::size_t write_some(const ConstBufferSequence& buffers,
       asio::error_code& ec)
   {
+    if (core_.kernel_tls_.send())
+      return next_layer_.write_some(buffers, ec);
     return detail::io(next_layer_, core_,
         detail::write_op<ConstBufferSequence>(buffers), ec);
   }
@@ -682,6 +843,8 @@ public:
   std::size_t read_some(const MutableBufferSequence& buffers,
       asio::error_code& ec)
   {
+    if (core_.kernel_tls_.receive())
+      return detail::kernel_tls_read_some(next_layer_, core_, buffers, ec);
     return detail::io(next_layer_, core_,
         detail::read_op<MutableBufferSequence>(buffers), ec);
   }
@@ -749,6 +912,28 @@ private:
       ASIO_HANDSHAKE_HANDLER_CHECK(HandshakeHandler, handler) type_check;
 
       asio::detail::non_const_lvalue<HandshakeHandler> handler2(handler);
+      if (self_->core_.handshake_executor_)
+      {
+        async_compose<typename decay<HandshakeHandler>::type,
+          void (asio::error_code)>(
+            detail::offload_io_op<next_layer_type, detail::handshake_op>(
+              self_->next_layer_, self_->core_, detail::handshake_op(type),
+              self_->core_.handshake_executor_),
+            handler2.value, self_->next_layer_);
+        return;
+      }
+
+      if (detail::kernel_tls_requested(self_->next_layer_, self_->core_))
+      {
+        async_compose<typename decay<HandshakeHandler>::type,
+          void (asio::error_code)>(
+            detail::kernel_tls_handshake_op<next_layer_type,
+              detail::handshake_op>(
+                self_->next_layer_, self_->core_, detail::handshake_op(type)),
+            handler2.value, self_->next_layer_);
+        return;
+      }
+
       detail::async_io(self_->next_layer_, self_->core_,
           detail::handshake_op(type), handler2.value);
     }
@@ -784,6 +969,33 @@ private:
 
       asio::detail::non_const_lvalue<
           BufferedHandshakeHandler> handler2(handler);
+      if (self_->core_.handshake_executor_)
+      {
+        async_compose<typename decay<BufferedHandshakeHandler>::type,
+          void (asio::error_code, std::size_t)>(
+            detail::offload_io_op<next_layer_type,
+              detail::buffered_handshake_op<ConstBufferSequence> >(
+                self_->next_layer_, self_->core_,
+                detail::buffered_handshake_op<ConstBufferSequence>(
+                  type, buffers),
+                self_->core_.handshake_executor_),
+            handler2.value, self_->next_layer_);
+        return;
+      }
+
+      if (detail::kernel_tls_requested(self_->next_layer_, self_->core_))
+      {
+        async_compose<typename decay<BufferedHandshakeHandler>::type,
+          void (asio::error_code, std::size_t)>(
+            detail::kernel_tls_handshake_op<next_layer_type,
+              detail::buffered_handshake_op<ConstBufferSequence> >(
+                self_->next_layer_, self_->core_,
+                detail::buffered_handshake_op<ConstBufferSequence>(
+                  type, buffers)),
+            handler2.value, self_->next_layer_);
+        return;
+      }
+
       detail::async_io(self_->next_layer_, self_->core_,
           detail::buffered_handshake_op<ConstBufferSequence>(type, buffers),
           handler2.value);
@@ -816,6 +1028,16 @@ private:
       ASIO_HANDSHAKE_HANDLER_CHECK(ShutdownHandler, handler) type_check;
 
       asio::detail::non_const_lvalue<ShutdownHandler> handler2(handler);
+      if (self_->core_.kernel_tls_.send())
+      {
+        async_compose<typename decay<ShutdownHandler>::type,
+          void (asio::error_code)>(
+            detail::kernel_tls_shutdown_op<next_layer_type>(
+              self_->next_layer_, self_->core_),
+            handler2.value, self_->next_layer_);
+        return;
+      }
+
       detail::async_io(self_->next_layer_, self_->core_,
           detail::shutdown_op(), handler2.value);
     }
@@ -848,6 +1070,14 @@ private:
       ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
 
       asio::detail::non_const_lvalue<WriteHandler> handler2(handler);
+      if (self_->core_.kernel_tls_.send())
+      {
+        self_->next_layer_.async_write_some(buffers,
+            ASIO_MOVE_CAST(typename decay<WriteHandler>::type)(
+              handler2.value));
+        return;
+      }
+
       detail::async_io(self_->next_layer_, self_->core_,
           detail::write_op<ConstBufferSequence>(buffers), handler2.value);
     }
@@ -880,6 +1110,17 @@ private:
       ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
 
       asio::detail::non_const_lvalue<ReadHandler> handler2(handler);
+      if (self_->core_.kernel_tls_.receive())
+      {
+        async_compose<typename decay<ReadHandler>::type,
+          void (asio::error_code, std::size_t)>(
+            detail::kernel_tls_read_op<
+              next_layer_type, MutableBufferSequence>(
+                self_->next_layer_, self_->core_, buffers),
+            handler2.value, self_->next_layer_);
+        return;
+      }
+
       detail::async_io(self_->next_layer_, self_->core_,
           detail::read_op<MutableBufferSequence>(buffers), handler2.value);
     }
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <vector>
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/thread_group.hpp"
@@ -70,6 +71,14 @@ namespace detail {
  *
  * // Wait for all tasks in the pool to complete.
  * pool.join(); @endcode
+ *
+ * @par Thread affinity
+ *
+ * A pool may be constructed with a thread_pool::affinity object that pins its
+ * threads to processors, and groups them by node. For example, to divide the
+ * threads between the NUMA nodes of the machine:
+ *
+ * @code asio::thread_pool pool(16, asio::thread_pool::affinity::numa()); @endcode
  */
 class thread_pool
   : public execution_context
@@ -87,6 +96,71 @@ public:
   /// Scheduler used to schedule receivers on a thread pool.
   typedef basic_executor_type<std::allocator<void>, 0> scheduler_type;
 
+  /// Describes the processors on which a pool's threads run.
+  /**
+   * The processors are divided into nodes. The pool's threads are divided
+   * between the nodes as evenly as possible, and each thread is pinned to the
+   * processors of its node.
+   *
+   * When there is more than one node, each thread has its own queue. A
+   * function submitted from one of the pool's threads is added to that
+   * thread's queue, and a thread that runs out of work takes functions from
+   * threads on its own node before those on other nodes. The order in which
+   * functions are invoked is then only preserved for functions submitted
+   * from the same thread.
+   *
+   * Threads are only pinned on Linux. Elsewhere, and if a thread's processors
+   * are not available to the process, the thread may run on any processor.
+   */
+  class affinity
+  {
+  public:
+    /// Construct an affinity with no nodes, under which threads are not
+    /// pinned.
+    affinity()
+    {
+    }
+
+    /// Add a node containing the given processors.
+    affinity& add_node(const std::vector<int>& cpus)
+    {
+      nodes_.push_back(cpus);
+      return *this;
+    }
+
+    /// Obtain an affinity with a single node containing the given processors.
+    static affinity cpus(const std::vector<int>& cpus)
+    {
+      affinity a;
+      a.add_node(cpus);
+      return a;
+    }
+
+    /// Obtain an affinity with a node for each NUMA node.
+    /**
+     * Each node contains the processors of the corresponding NUMA node that
+     * the calling thread may use. If the NUMA nodes cannot be determined, there
+     * is a single node containing all of the processors that the calling
+     * thread may use.
+     */
+    ASIO_DECL static affinity numa();
+
+    /// Get the number of nodes.
+    std::size_t node_count() const
+    {
+      return nodes_.size();
+    }
+
+    /// Get the processors of the given node.
+    const std::vector<int>& node_cpus(std::size_t node) const
+    {
+      return nodes_[node];
+    }
+
+  private:
+    std::vector<std::vector<int> > nodes_;
+  };
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
   /// Constructs a pool with an automatically determined number of threads.
   ASIO_DECL thread_pool();
@@ -95,6 +169,14 @@ public:
   /// Constructs a pool with a specified number of threads.
   ASIO_DECL thread_pool(std::size_t num_threads);
 
+  /// Constructs a pool with a specified number of threads, placed on the
+  /// processors described by the given affinity.
+  /**
+   * @note Threads attached to the pool using @c attach() are not pinned, and
+   * belong to the first node.
+   */
+  ASIO_DECL thread_pool(std::size_t num_threads, const affinity& a);
+
   /// Destructor.
   /**
    * Automatically stops and joins the pool, if not explicitly done beforehand.
@@ -158,6 +240,13 @@ private:
 
   // The current number of threads in the pool.
   detail::atomic_count num_threads_;
+
+  // The processors on which the threads run.
+  affinity affinity_;
+
+  // The largest number of threads on one node, or 0 if the threads are not
+  // grouped into more than one node.
+  std::size_t node_occupancy_;
 };
 
 /// Executor implementation type used to submit functions to a thread pool.
@@ -534,9 +623,15 @@ public:
    * @code auto ex = my_thread_pool.executor();
    * std::size_t occupancy = asio::query(
    *     ex, asio::execution::occupancy); @endcode
+   *
+   * @returns The number of threads in the pool or, if the pool's threads are
+   * divided between more than one node, the number of threads in the largest
+   * node.
    */
   std::size_t query(execution::occupancy_t) const ASIO_NOEXCEPT
   {
+    if (pool_->node_occupancy_)
+      return pool_->node_occupancy_;
     return static_cast<std::size_t>(pool_->num_threads_);
   }
 
@@ -36,11 +36,11 @@ struct transfer_all
 
 int main(int argc, char* argv[])
 {
-  if (argc != 6)
+  if (argc != 6 && !(argc == 7 && std::strcmp(argv[5], "busy") == 0))
   {
     std::fprintf(stderr,
         "Usage: tcp_client <ip> <port> "
-        "<nconns> <bufsize> {spin|block}\n");
+        "<nconns> <bufsize> {spin|block|busy [usec]}\n");
     return 1;
   }
 
@@ -49,6 +49,8 @@ int main(int argc, char* argv[])
   int num_connections = std::atoi(argv[3]);
   std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[4]));
   bool spin = (std::strcmp(argv[5], "spin") == 0);
+  bool busy = (std::strcmp(argv[5], "busy") == 0);
+  int busy_usec = busy ? (argc == 7 ? std::atoi(argv[6]) : 100) : 0;
 
   asio::io_context io_context;
   std::vector<boost::shared_ptr<tcp::socket> > sockets;
@@ -67,6 +69,16 @@ int main(int argc, char* argv[])
       s->non_blocking(true);
     }
 
+#if defined(ASIO_HAS_SO_BUSY_POLL)
+    // Blocking reads busy poll the device queue before sleeping. Increasing
+    // the value may require privileges, so errors are ignored.
+    if (busy_usec > 0)
+    {
+      asio::error_code ignored_ec;
+      s->set_option(tcp::socket::busy_poll(busy_usec), ignored_ec);
+    }
+#endif // defined(ASIO_HAS_SO_BUSY_POLL)
+
     sockets.push_back(s);
   }
 
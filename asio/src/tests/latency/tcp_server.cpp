@@ -25,10 +25,11 @@ using asio::ip::tcp;
 class tcp_server : asio::coroutine
 {
 public:
-  tcp_server(tcp::acceptor& acceptor, std::size_t buf_size) :
+  tcp_server(tcp::acceptor& acceptor, std::size_t buf_size, int busy_poll) :
     acceptor_(acceptor),
     socket_(acceptor_.get_executor()),
-    buffer_(buf_size)
+    buffer_(buf_size),
+    busy_poll_(busy_poll)
   {
   }
 
@@ -38,6 +39,16 @@ public:
     {
       yield acceptor_.async_accept(socket_, ref(this));
 
+#if defined(ASIO_HAS_SO_BUSY_POLL)
+      // Increasing the value may require privileges, so errors are ignored.
+      if (!ec && busy_poll_ > 0)
+      {
+        asio::error_code ignored_ec;
+        socket_.set_option(
+            tcp::socket::busy_poll(busy_poll_), ignored_ec);
+      }
+#endif // defined(ASIO_HAS_SO_BUSY_POLL)
+
       while (!ec)
       {
         yield asio::async_read(socket_,
@@ -77,17 +88,18 @@ private:
   tcp::socket socket_;
   std::vector<unsigned char> buffer_;
   tcp::endpoint sender_;
+  int busy_poll_;
 };
 
 #include <asio/unyield.hpp>
 
 int main(int argc, char* argv[])
 {
-  if (argc != 5)
+  if (argc != 5 && !(argc == 6 && std::strcmp(argv[4], "busy") == 0))
   {
     std::fprintf(stderr,
         "Usage: tcp_server <port> <nconns> "
-        "<bufsize> {spin|block}\n");
+        "<bufsize> {spin|block|busy [usec]}\n");
     return 1;
   }
 
@@ -95,14 +107,23 @@ int main(int argc, char* argv[])
   int max_connections = std::atoi(argv[2]);
   std::size_t buf_size = std::atoi(argv[3]);
   bool spin = (std::strcmp(argv[4], "spin") == 0);
+  bool busy = (std::strcmp(argv[4], "busy") == 0);
+  int busy_usec = busy ? (argc == 6 ? std::atoi(argv[5]) : 100) : 0;
 
   asio::io_context io_context(1);
+
+  // In busy mode, run() polls for up to the given time before blocking, and
+  // the sockets busy poll the device queue for the same time.
+  if (busy_usec > 0)
+    io_context.set_spin_duration(asio::chrono::microseconds(busy_usec));
+
   tcp::acceptor acceptor(io_context, tcp::endpoint(tcp::v4(), port));
   std::vector<boost::shared_ptr<tcp_server> > servers;
 
   for (int i = 0; i < max_connections; ++i)
   {
-    boost::shared_ptr<tcp_server> s(new tcp_server(acceptor, buf_size));
+    boost::shared_ptr<tcp_server> s(
+        new tcp_server(acceptor, buf_size, busy_usec));
     servers.push_back(s);
     (*s)(asio::error_code());
   }
@@ -0,0 +1,119 @@
+//
+// scheduler_batch.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// A chain of handlers, each of which posts the next until the shared count of
+// remaining handlers is exhausted.
+class chain
+{
+public:
+  chain(asio::io_context& io_context, asio::detail::atomic_count& remaining)
+    : io_context_(io_context),
+      remaining_(remaining)
+  {
+  }
+
+  void operator()()
+  {
+    if (--remaining_ > 0)
+      asio::post(io_context_, *this);
+  }
+
+private:
+  asio::io_context& io_context_;
+  asio::detail::atomic_count& remaining_;
+};
+
+class runner
+{
+public:
+  explicit runner(asio::io_context& io_context)
+    : io_context_(io_context)
+  {
+  }
+
+  void operator()()
+  {
+    io_context_.run();
+  }
+
+private:
+  asio::io_context& io_context_;
+};
+
+// Returns the number of handlers run per second.
+double measure(int concurrency_hint, int thread_count,
+    int chains_per_thread, long handlers)
+{
+  asio::io_context io_context(concurrency_hint);
+  asio::detail::atomic_count remaining(handlers);
+
+  for (int i = 0; i < thread_count * chains_per_thread; ++i)
+    asio::post(io_context, chain(io_context, remaining));
+
+  ptime start = microsec_clock::universal_time();
+
+  std::list<asio::thread*> threads;
+  for (int i = 1; i < thread_count; ++i)
+    threads.push_back(new asio::thread(runner(io_context)));
+  io_context.run();
+  while (!threads.empty())
+  {
+    threads.front()->join();
+    delete threads.front();
+    threads.pop_front();
+  }
+
+  ptime stop = microsec_clock::universal_time();
+  double usec = static_cast<double>((stop - start).total_microseconds());
+  return usec > 0 ? handlers * 1000000.0 / usec : 0.0;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: scheduler_batch <batch> <chains_per_thread> <handlers>\n");
+    std::fprintf(stderr, "Compares the handlers run per second by an io_context"
+        " that takes handlers\none at a time with one that takes them in"
+        " batches of up to <batch>,\nusing 1, 4, 16 and 64 threads.\n");
+    return 1;
+  }
+
+  int batch = std::atoi(argv[1]);
+  int chains_per_thread = std::atoi(argv[2]);
+  long handlers = std::atol(argv[3]);
+
+  const int thread_counts[] = { 1, 4, 16, 64 };
+
+  std::printf("%8s %16s %16s %8s\n",
+      "threads", "single/sec", "batched/sec", "ratio");
+  for (std::size_t i = 0; i < sizeof(thread_counts) / sizeof(int); ++i)
+  {
+    double single = measure(ASIO_CONCURRENCY_HINT_SAFE,
+        thread_counts[i], chains_per_thread, handlers);
+    double batched = measure(ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH(batch),
+        thread_counts[i], chains_per_thread, handlers);
+    std::printf("%8d %16.0f %16.0f %8.2f\n", thread_counts[i],
+        single, batched, single > 0 ? batched / single : 0.0);
+  }
+
+  return 0;
+}
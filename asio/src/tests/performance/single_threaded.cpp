@@ -0,0 +1,128 @@
+//
+// single_threaded.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// A chain of handlers, each of which posts the next until the shared count of
+// remaining handlers is exhausted. Only the thread running the io_context
+// touches the count.
+class chain
+{
+public:
+  chain(asio::io_context& io_context, long& remaining)
+    : io_context_(io_context),
+      remaining_(remaining)
+  {
+  }
+
+  void operator()()
+  {
+    if (--remaining_ > 0)
+      asio::post(io_context_, *this);
+  }
+
+private:
+  asio::io_context& io_context_;
+  long& remaining_;
+};
+
+class noop
+{
+public:
+  void operator()()
+  {
+  }
+};
+
+// Posts handlers from outside the io_context, and then releases the work that
+// keeps the io_context running.
+class poster
+{
+public:
+  poster(asio::io_context& io_context, long handlers)
+    : io_context_(io_context),
+      work_(new asio::io_context::work(io_context)),
+      handlers_(handlers)
+  {
+  }
+
+  void operator()()
+  {
+    for (long i = 0; i < handlers_; ++i)
+      asio::post(io_context_, noop());
+    work_.reset();
+  }
+
+private:
+  asio::io_context& io_context_;
+  asio::detail::shared_ptr<asio::io_context::work> work_;
+  long handlers_;
+};
+
+// Returns the number of handlers run per second.
+double measure(int concurrency_hint, int chains, long handlers, bool remote)
+{
+  asio::io_context io_context(concurrency_hint);
+  long remaining = handlers;
+
+  ptime start = microsec_clock::universal_time();
+
+  if (remote)
+  {
+    asio::thread t(poster(io_context, handlers));
+    io_context.run();
+    t.join();
+  }
+  else
+  {
+    for (int i = 0; i < chains; ++i)
+      asio::post(io_context, chain(io_context, remaining));
+    io_context.run();
+  }
+
+  ptime stop = microsec_clock::universal_time();
+  double usec = static_cast<double>((stop - start).total_microseconds());
+  return usec > 0 ? handlers * 1000000.0 / usec : 0.0;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr, "Usage: single_threaded <chains> <handlers>\n");
+    std::fprintf(stderr, "Compares the handlers run per second by an io_context"
+        " with a concurrency\nhint of 1 with one that uses"
+        " ASIO_CONCURRENCY_HINT_SINGLE_THREADED, for handlers\nposted from"
+        " within the io_context and from another thread.\n");
+    return 1;
+  }
+
+  int chains = std::atoi(argv[1]);
+  long handlers = std::atol(argv[2]);
+
+  std::printf("%8s %16s %16s %8s\n",
+      "posted", "hint 1/sec", "single/sec", "ratio");
+  for (int remote = 0; remote < 2; ++remote)
+  {
+    double one = measure(1, chains, handlers, remote != 0);
+    double single = measure(ASIO_CONCURRENCY_HINT_SINGLE_THREADED,
+        chains, handlers, remote != 0);
+    std::printf("%8s %16.0f %16.0f %8.2f\n", remote ? "remote" : "local",
+        one, single, one > 0 ? single / one : 0.0);
+  }
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+//
+// udp_batch.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using asio::ip::udp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+class timing
+{
+public:
+  timing()
+    : usec_(0),
+      packets_(0)
+  {
+  }
+
+  void start()
+  {
+    start_ = microsec_clock::universal_time();
+  }
+
+  void stop(std::size_t packets)
+  {
+    usec_ += (microsec_clock::universal_time() - start_).total_microseconds();
+    packets_ += packets;
+  }
+
+  void print(const char* name) const
+  {
+    std::printf("%-14s %10.1f ns/packet (%lu packets)\n", name,
+        packets_ ? (usec_ * 1000.0) / packets_ : 0.0,
+        static_cast<unsigned long>(packets_));
+  }
+
+private:
+  ptime start_;
+  boost::int64_t usec_;
+  std::size_t packets_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr, "Usage: udp_batch <bufsize> <batch> <rounds>\n");
+    std::fprintf(stderr, "Compares the per-packet cost of send_to and"
+        " receive_from with\nsend_batch and receive_batch over loopback.\n");
+    return 1;
+  }
+
+  std::size_t buf_size = static_cast<std::size_t>(std::atoi(argv[1]));
+  std::size_t batch = static_cast<std::size_t>(std::atoi(argv[2]));
+  int rounds = std::atoi(argv[3]);
+
+  asio::io_context io_context;
+
+  udp::socket receiver(io_context,
+      udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  receiver.set_option(udp::socket::receive_buffer_size(1 << 22));
+  udp::endpoint target = receiver.local_endpoint();
+
+  udp::socket sender(io_context,
+      udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  std::vector<char> write_buf(buf_size, 'x');
+  std::vector<char> read_bufs(buf_size * batch);
+
+  std::vector<udp::socket::send_record> send_records(batch);
+  std::vector<udp::socket::receive_record> receive_records(batch);
+  for (std::size_t i = 0; i < batch; ++i)
+  {
+    send_records[i].buffer = asio::buffer(write_buf);
+    send_records[i].endpoint = target;
+    receive_records[i].buffer =
+      asio::buffer(&read_bufs[i * buf_size], buf_size);
+  }
+
+  timing send_to, receive_from, send_batch, receive_batch;
+
+  for (int r = 0; r < rounds; ++r)
+  {
+    udp::endpoint sender_endpoint;
+
+    send_to.start();
+    for (std::size_t i = 0; i < batch; ++i)
+      sender.send_to(asio::buffer(write_buf), target);
+    send_to.stop(batch);
+
+    receive_from.start();
+    for (std::size_t i = 0; i < batch; ++i)
+      receiver.receive_from(asio::buffer(read_bufs), sender_endpoint);
+    receive_from.stop(batch);
+
+    send_batch.start();
+    for (std::size_t n = 0; n < batch; )
+      n += sender.send_batch(&send_records[n], batch - n);
+    send_batch.stop(batch);
+
+    receive_batch.start();
+    for (std::size_t n = 0; n < batch; )
+      n += receiver.receive_batch(&receive_records[n], batch - n);
+    receive_batch.stop(batch);
+  }
+
+  send_to.print("send_to");
+  send_batch.print("send_batch");
+  receive_from.print("receive_from");
+  receive_batch.print("receive_batch");
+
+  return 0;
+}
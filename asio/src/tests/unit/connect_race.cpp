@@ -0,0 +1,306 @@
+//
+// connect_race.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/connect_race.hpp"
+
+#include <vector>
+#include "asio/detail/thread.hpp"
+#include "asio/ip/tcp.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_MOVE)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+class connection_sink
+{
+public:
+  connection_sink()
+    : acceptor_(io_context_,
+        asio::ip::tcp::endpoint(
+          asio::ip::address_v4::loopback(), 0)),
+      target_endpoint_(acceptor_.local_endpoint()),
+      socket_(io_context_),
+      thread_(bindns::bind(&connection_sink::run, this))
+  {
+  }
+
+  ~connection_sink()
+  {
+    io_context_.stop();
+    thread_.join();
+  }
+
+  asio::ip::tcp::endpoint target_endpoint()
+  {
+    return target_endpoint_;
+  }
+
+private:
+  void run()
+  {
+    io_context_.run();
+  }
+
+  void handle_accept()
+  {
+    socket_.close();
+    acceptor_.async_accept(socket_,
+        bindns::bind(&connection_sink::handle_accept, this));
+  }
+
+  asio::io_context io_context_;
+  asio::ip::tcp::acceptor acceptor_;
+  asio::ip::tcp::endpoint target_endpoint_;
+  asio::ip::tcp::socket socket_;
+  asio::detail::thread thread_;
+};
+
+// Obtain an endpoint on which no connection will be accepted.
+asio::ip::tcp::endpoint refused_endpoint()
+{
+  asio::io_context io_context;
+  asio::ip::tcp::acceptor acceptor(io_context,
+      asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  return acceptor.local_endpoint();
+}
+
+// Records the endpoints on which connections are attempted.
+struct recording_cond
+{
+  explicit recording_cond(std::vector<asio::ip::tcp::endpoint>* attempts)
+    : attempts_(attempts)
+  {
+  }
+
+  bool operator()(const asio::error_code& /*ec*/,
+      const asio::ip::tcp::endpoint& endpoint)
+  {
+    attempts_->push_back(endpoint);
+    return true;
+  }
+
+  std::vector<asio::ip::tcp::endpoint>* attempts_;
+};
+
+bool false_cond(const asio::error_code& /*ec*/,
+    const asio::ip::tcp::endpoint& /*endpoint*/)
+{
+  return false;
+}
+
+void range_handler(const asio::error_code& ec,
+    const asio::ip::tcp::endpoint& endpoint,
+    asio::error_code* out_ec,
+    asio::ip::tcp::endpoint* out_endpoint)
+{
+  *out_ec = ec;
+  *out_endpoint = endpoint;
+}
+
+void test_async_connect_race()
+{
+  connection_sink sink;
+  asio::io_context io_context;
+  asio::ip::tcp::socket socket(io_context);
+  std::vector<asio::ip::tcp::endpoint> endpoints;
+  asio::ip::tcp::endpoint result;
+  asio::error_code ec;
+
+  // An empty sequence.
+
+  asio::async_connect_race(socket, endpoints, asio::chrono::seconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(ec == asio::error::not_found);
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(!socket.is_open());
+
+  // The first endpoint connects before the delay elapses, so no other
+  // attempt is started.
+
+  endpoints.push_back(sink.target_endpoint());
+  endpoints.push_back(refused_endpoint());
+
+  asio::async_connect_race(socket, endpoints, asio::chrono::seconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result == endpoints[0]);
+  ASIO_CHECK(socket.is_open());
+  ASIO_CHECK(socket.remote_endpoint(ec) == endpoints[0]);
+
+  // A failed attempt starts the next attempt without waiting for the delay.
+
+  endpoints.clear();
+  endpoints.push_back(refused_endpoint());
+  endpoints.push_back(sink.target_endpoint());
+
+  asio::chrono::steady_clock::time_point start
+    = asio::chrono::steady_clock::now();
+  asio::async_connect_race(socket, endpoints, asio::chrono::seconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result == endpoints[1]);
+  ASIO_CHECK(socket.is_open());
+  ASIO_CHECK(asio::chrono::steady_clock::now() - start
+      < asio::chrono::seconds(5));
+
+  // An attempt that does not complete is overtaken once the delay elapses.
+  // The listener's backlog is full, so the first attempt cannot complete.
+
+  asio::ip::tcp::acceptor full_acceptor(io_context);
+  full_acceptor.open(asio::ip::tcp::v4());
+  full_acceptor.bind(asio::ip::tcp::endpoint(
+        asio::ip::address_v4::loopback(), 0));
+  full_acceptor.listen(0);
+  asio::ip::tcp::socket backlog_socket(io_context);
+  backlog_socket.connect(full_acceptor.local_endpoint());
+
+  endpoints.clear();
+  endpoints.push_back(full_acceptor.local_endpoint());
+  endpoints.push_back(sink.target_endpoint());
+
+  start = asio::chrono::steady_clock::now();
+  asio::async_connect_race(socket, endpoints,
+      asio::chrono::milliseconds(50),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result == endpoints[1]);
+  ASIO_CHECK(socket.is_open());
+  ASIO_CHECK(asio::chrono::steady_clock::now() - start
+      >= asio::chrono::milliseconds(50));
+  ASIO_CHECK(asio::chrono::steady_clock::now() - start
+      < asio::chrono::seconds(5));
+
+  // All attempts start at once when there is no delay. The first to succeed
+  // is kept.
+
+  endpoints.clear();
+  endpoints.push_back(refused_endpoint());
+  endpoints.push_back(sink.target_endpoint());
+  endpoints.push_back(sink.target_endpoint());
+
+  asio::async_connect_race(socket, endpoints, asio::chrono::seconds(0),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result == sink.target_endpoint());
+  ASIO_CHECK(socket.is_open());
+  ASIO_CHECK(socket.remote_endpoint(ec) == sink.target_endpoint());
+
+  // Every attempt fails.
+
+  endpoints.clear();
+  endpoints.push_back(refused_endpoint());
+  endpoints.push_back(refused_endpoint());
+
+  asio::async_connect_race(socket, endpoints, asio::chrono::seconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(ec == asio::error::connection_refused);
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(!socket.is_open());
+}
+
+void test_async_connect_race_cond()
+{
+  connection_sink sink;
+  asio::io_context io_context;
+  asio::ip::tcp::socket socket(io_context);
+  std::vector<asio::ip::tcp::endpoint> endpoints;
+  asio::ip::tcp::endpoint result;
+  asio::error_code ec;
+
+  // The address families alternate, starting with that of the first
+  // endpoint.
+
+  asio::ip::tcp::endpoint v4_refused1 = refused_endpoint();
+  asio::ip::tcp::endpoint v4_refused2 = refused_endpoint();
+  asio::ip::tcp::endpoint v6_refused(
+      asio::ip::address_v6::loopback(), v4_refused1.port());
+  endpoints.push_back(v4_refused1);
+  endpoints.push_back(v4_refused2);
+  endpoints.push_back(v6_refused);
+  endpoints.push_back(sink.target_endpoint());
+
+  std::vector<asio::ip::tcp::endpoint> attempts;
+  asio::async_connect_race(socket, endpoints, asio::chrono::seconds(10),
+      recording_cond(&attempts),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(result == sink.target_endpoint());
+  ASIO_CHECK(attempts.size() == 4);
+  if (attempts.size() == 4)
+  {
+    ASIO_CHECK(attempts[0] == v4_refused1);
+    ASIO_CHECK(attempts[1] == v6_refused);
+    ASIO_CHECK(attempts[2] == v4_refused2);
+    ASIO_CHECK(attempts[3] == sink.target_endpoint());
+  }
+
+  // A condition that rejects every endpoint.
+
+  asio::async_connect_race(socket, endpoints, asio::chrono::seconds(10),
+      false_cond, bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(ec == asio::error::not_found);
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(!socket.is_open());
+}
+
+#else // defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_MOVE)
+
+void test_async_connect_race()
+{
+}
+
+void test_async_connect_race_cond()
+{
+}
+
+#endif // defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_MOVE)
+
+ASIO_TEST_SUITE
+(
+  "connect_race",
+  ASIO_TEST_CASE(test_async_connect_race)
+  ASIO_TEST_CASE(test_async_connect_race_cond)
+)
@@ -17,8 +17,11 @@
 #include "asio/io_context.hpp"
 
 #include <sstream>
+#include <vector>
 #include "asio/bind_executor.hpp"
 #include "asio/dispatch.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
 #include "asio/post.hpp"
 #include "asio/thread.hpp"
 #include "unit_test.hpp"
@@ -113,6 +116,22 @@ void io_context_run(io_context* ioc)
   ioc->run();
 }
 
+void fan_out_increment(io_context* ioc,
+    asio::detail::atomic_count* count, int depth)
+{
+  ++(*count);
+  if (depth > 0)
+  {
+    asio::post(*ioc, bindns::bind(fan_out_increment, ioc, count, depth - 1));
+    asio::post(*ioc, bindns::bind(fan_out_increment, ioc, count, depth - 1));
+  }
+}
+
+void record(std::vector<int>* values, int value)
+{
+  values->push_back(value);
+}
+
 void io_context_test()
 {
   io_context ioc;
@@ -284,6 +303,63 @@ void io_context_test()
   ASIO_CHECK(exception_count == 2);
 }
 
+void io_context_work_stealing_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_WORK_STEALING);
+  asio::detail::atomic_count count(0);
+
+  // Each handler posts two more from within the handler, so that most of the
+  // work is queued on the running threads' own queues and must be stolen to
+  // be shared out.
+  asio::post(ioc, bindns::bind(fan_out_increment, &ioc, &count, 12));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  thread thread1(bindns::bind(io_context_run, &ioc));
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  thread thread3(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  // The run() calls will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == (1 << 13) - 1);
+
+  int int_count = 10;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(decrement_to_zero, &ioc, &int_count));
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(int_count == 0);
+
+  int_count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  thread thread4(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  thread4.join();
+
+  // The stop() call must cause all run() calls to return.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(int_count == 0);
+
+  ioc.restart();
+  asio::post(ioc, bindns::bind(increment, &int_count));
+  w.reset();
+  ioc.run();
+
+  // Handlers queued after a restart are still executed.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(int_count == 1);
+}
+
 class test_service : public asio::io_context::service
 {
 public:
@@ -296,6 +372,379 @@ private:
 
 asio::io_context::id test_service::id;
 
+void io_context_batch_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_SCHEDULER_BATCH(8));
+
+  // Handlers are run in the order in which they were posted, including those
+  // posted from within a batch.
+  std::vector<int> values;
+  for (int i = 0; i < 20; ++i)
+    asio::post(ioc, bindns::bind(record, &values, i));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(values.size() == 20);
+  for (int i = 0; i < static_cast<int>(values.size()); ++i)
+    ASIO_CHECK(values[i] == i);
+
+  // The stop() call takes effect before the rest of the batch is run, and
+  // the remaining handlers are run after a restart.
+  values.clear();
+  ioc.restart();
+  asio::post(ioc, bindns::bind(record, &values, 0));
+  asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  asio::post(ioc, bindns::bind(record, &values, 1));
+  asio::post(ioc, bindns::bind(record, &values, 2));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(values.size() == 1);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(values.size() == 3);
+  ASIO_CHECK(values[1] == 1);
+  ASIO_CHECK(values[2] == 2);
+
+  // Handlers left in a batch by an exception are run by the next call.
+  values.clear();
+  int exception_count = 0;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(record, &values, 0));
+  asio::post(ioc, &throw_exception);
+  asio::post(ioc, bindns::bind(record, &values, 1));
+  asio::post(ioc, &throw_exception);
+  asio::post(ioc, bindns::bind(record, &values, 2));
+
+  for (;;)
+  {
+    try
+    {
+      ioc.run();
+      break;
+    }
+    catch (int)
+    {
+      ++exception_count;
+    }
+  }
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(exception_count == 2);
+  ASIO_CHECK(values.size() == 3);
+  for (int i = 0; i < static_cast<int>(values.size()); ++i)
+    ASIO_CHECK(values[i] == i);
+
+  // Work is shared out between threads.
+  asio::detail::atomic_count count(0);
+  ioc.restart();
+  asio::post(ioc, bindns::bind(fan_out_increment, &ioc, &count, 12));
+  thread thread1(bindns::bind(io_context_run, &ioc));
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  thread thread3(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  // The run() calls will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == (1 << 13) - 1);
+}
+
+void io_context_spin_test()
+{
+#if defined(ASIO_HAS_CHRONO)
+  io_context ioc;
+  ioc.set_spin_duration(asio::chrono::milliseconds(20));
+
+  // Handlers posted from another thread are picked up by threads that are
+  // polling the reactor or the queue.
+  int count = 0;
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  thread thread1(bindns::bind(io_context_run, &ioc));
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  for (int i = 0; i < 10; ++i)
+    asio::post(ioc, bindns::bind(increment, &count));
+  w.reset();
+  thread1.join();
+  thread2.join();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 10);
+
+  // Timers expire while the reactor is polled, and after the spin period has
+  // elapsed and the thread has blocked.
+  count = 0;
+  ioc.restart();
+  timer t1(ioc, chronons::milliseconds(5));
+  t1.async_wait(bindns::bind(increment, &count));
+  timer t2(ioc, chronons::milliseconds(100));
+  t2.async_wait(bindns::bind(increment, &count));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 2);
+
+  // The stop() call causes a polling thread to return.
+  count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w2 = make_work_guard(ioc);
+  thread thread3(bindns::bind(io_context_run, &ioc));
+  asio::post(ioc, bindns::bind(increment, &count));
+  timer t3(ioc, chronons::milliseconds(5));
+  t3.wait();
+  ioc.stop();
+  thread3.join();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+  w2.reset();
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void read_handler(const asio::error_code& ec, std::size_t, int* count)
+{
+  if (!ec)
+    ++*count;
+}
+
+// Make a number of sockets ready at once, so that they are reported by the
+// reactor together.
+void run_ready_sockets(io_context& ioc, int num_pairs)
+{
+  typedef asio::local::stream_protocol::socket socket_type;
+  std::vector<socket_type*> readers, writers;
+  char read_data[1];
+  int count = 0;
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    readers.push_back(new socket_type(ioc));
+    writers.push_back(new socket_type(ioc));
+    asio::local::connect_pair(*readers.back(), *writers.back());
+    readers.back()->async_read_some(asio::buffer(read_data),
+        bindns::bind(read_handler, bindns::placeholders::_1,
+          bindns::placeholders::_2, &count));
+  }
+
+  for (int i = 0; i < num_pairs; ++i)
+    writers[i]->write_some(asio::buffer("x", 1));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == num_pairs);
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    delete readers[i];
+    delete writers[i];
+  }
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void io_context_reactor_batch_test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  && defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING)
+  io_context ioc;
+  ioc.set_reactor_batch_size(4);
+
+  io_context::reactor_statistics stats = ioc.get_reactor_statistics();
+  ASIO_CHECK(stats.waits == 0);
+  ASIO_CHECK(stats.events == 0);
+  ASIO_CHECK(stats.full_batches == 0);
+  ASIO_CHECK(stats.batch_size == 4);
+
+  // The batch does not grow beyond the maximum.
+  run_ready_sockets(ioc, 16);
+
+  stats = ioc.get_reactor_statistics();
+  ASIO_CHECK(stats.waits >= 4);
+  ASIO_CHECK(stats.events >= 16);
+  ASIO_CHECK(stats.full_batches >= 4);
+  ASIO_CHECK(stats.batch_size == 4);
+
+  // Raising the maximum allows the batch to grow after a full wait.
+  ioc.set_reactor_batch_size(1024);
+  run_ready_sockets(ioc, 16);
+
+  io_context::reactor_statistics stats2 = ioc.get_reactor_statistics();
+  ASIO_CHECK(stats2.waits > stats.waits);
+  ASIO_CHECK(stats2.events >= stats.events + 16);
+  ASIO_CHECK(stats2.full_batches > stats.full_batches);
+  ASIO_CHECK(stats2.batch_size >= 8);
+  ASIO_CHECK(stats2.batch_size <= 32);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   && defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING)
+}
+
+void io_context_unsafe_io_test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  // Without locking in the reactor, readiness events are processed by the
+  // thread that runs the reactor.
+  io_context ioc1(ASIO_CONCURRENCY_HINT_UNSAFE);
+  run_ready_sockets(ioc1, 16);
+
+  io_context ioc2(ASIO_CONCURRENCY_HINT_UNSAFE_IO);
+  run_ready_sockets(ioc2, 16);
+
+  // Operations of several types on one descriptor complete from a single
+  // readiness event. The operation on the closed socket is aborted.
+  typedef asio::local::stream_protocol::socket socket_type;
+  socket_type s1(ioc1), s2(ioc1);
+  asio::local::connect_pair(s1, s2);
+
+  char read_data[1];
+  int count = 0;
+  s1.async_read_some(asio::buffer(read_data),
+      bindns::bind(read_handler, bindns::placeholders::_1,
+        bindns::placeholders::_2, &count));
+  s1.async_wait(socket_type::wait_write,
+      bindns::bind(increment, &count));
+  s2.async_read_some(asio::buffer(read_data),
+      bindns::bind(read_handler, bindns::placeholders::_1,
+        bindns::placeholders::_2, &count));
+
+  s2.write_some(asio::buffer("x", 1));
+  s2.close();
+  ioc1.restart();
+  ioc1.run();
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(ioc1.stopped());
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void post_increments(io_context* ioc, int* count, int n,
+    executor_work_guard<io_context::executor_type>* w)
+{
+  for (int i = 0; i < n; ++i)
+    asio::post(*ioc, bindns::bind(increment, count));
+  w->reset();
+}
+
+void io_context_single_threaded_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_SINGLE_THREADED);
+
+  // Handlers are run in the order in which they were posted, including those
+  // posted from within a handler.
+  std::vector<int> values;
+  for (int i = 0; i < 10; ++i)
+    asio::post(ioc, bindns::bind(record, &values, i));
+  int count = 10;
+  asio::post(ioc, bindns::bind(decrement_to_zero, &ioc, &count));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 0);
+  ASIO_CHECK(values.size() == 10);
+  for (int i = 0; i < static_cast<int>(values.size()); ++i)
+    ASIO_CHECK(values[i] == i);
+
+  // The poll functions do not block.
+  count = 0;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(increment, &count));
+  asio::post(ioc, bindns::bind(increment, &count));
+  asio::post(ioc, bindns::bind(increment, &count));
+  ASIO_CHECK(ioc.poll_one() == 1);
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ioc.run_one() == 1);
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(ioc.poll() == 1);
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(ioc.stopped());
+
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  ASIO_CHECK(ioc.poll() == 0);
+  ASIO_CHECK(!ioc.stopped());
+
+  // Handlers posted from another thread wake the running thread, as does
+  // releasing the last work from another thread.
+  thread thread1(bindns::bind(post_increments, &ioc, &count, 1000, &w));
+  ioc.run();
+  thread1.join();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1003);
+
+  // Timers expire.
+  count = 0;
+  ioc.restart();
+  timer t1(ioc, chronons::milliseconds(5));
+  t1.async_wait(bindns::bind(increment, &count));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+
+  // The stop() call causes a blocked thread to return, and handlers left in
+  // the queue are run after a restart.
+  count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w2 = make_work_guard(ioc);
+  thread thread2(bindns::bind(io_context_run, &ioc));
+  io_context ioc2;
+  timer t2(ioc2, chronons::milliseconds(50));
+  t2.wait();
+  ioc.stop();
+  thread2.join();
+
+  ASIO_CHECK(ioc.stopped());
+
+  ioc.restart();
+  asio::post(ioc, bindns::bind(increment, &count));
+  asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  asio::post(ioc, bindns::bind(increment, &count));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+
+  ioc.restart();
+  w2.reset();
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 2);
+
+  // Exceptions propagate out of run(), and the remaining handlers are run by
+  // the next call.
+  int exception_count = 0;
+  count = 0;
+  ioc.restart();
+  asio::post(ioc, &throw_exception);
+  asio::post(ioc, bindns::bind(increment, &count));
+  asio::post(ioc, &throw_exception);
+  asio::post(ioc, bindns::bind(increment, &count));
+
+  for (;;)
+  {
+    try
+    {
+      ioc.run();
+      break;
+    }
+    catch (int)
+    {
+      ++exception_count;
+    }
+  }
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(exception_count == 2);
+  ASIO_CHECK(count == 2);
+}
+
 void io_context_service_test()
 {
   asio::io_context ioc1;
@@ -579,6 +1028,12 @@ ASIO_TEST_SUITE
 (
   "io_context",
   ASIO_TEST_CASE(io_context_test)
+  ASIO_TEST_CASE(io_context_work_stealing_test)
+  ASIO_TEST_CASE(io_context_batch_test)
+  ASIO_TEST_CASE(io_context_spin_test)
+  ASIO_TEST_CASE(io_context_reactor_batch_test)
+  ASIO_TEST_CASE(io_context_unsafe_io_test)
+  ASIO_TEST_CASE(io_context_single_threaded_test)
   ASIO_TEST_CASE(io_context_service_test)
   ASIO_TEST_CASE(io_context_executor_query_test)
   ASIO_TEST_CASE(io_context_executor_execute_test)
@@ -0,0 +1,392 @@
+//
+// basic_dns_resolver.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/basic_dns_resolver.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_CHRONO)
+# include "asio/detail/thread.hpp"
+#endif // defined(ASIO_HAS_CHRONO)
+
+//------------------------------------------------------------------------------
+
+// ip_basic_dns_resolver_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::basic_dns_resolver
+// class template against a name server running on the loopback interface.
+
+namespace ip_basic_dns_resolver_runtime {
+
+#if defined(ASIO_HAS_CHRONO)
+
+typedef asio::ip::basic_dns_resolver<asio::ip::tcp> resolver_type;
+
+// A name server that answers queries for a few fixed names. It is stopped by
+// sending it a datagram containing "quit".
+struct name_server
+{
+  name_server()
+    : udp_socket(io_context),
+      acceptor(io_context,
+          asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+  {
+    udp_socket.open(asio::ip::udp::v4());
+    udp_socket.bind(asio::ip::udp::endpoint(
+          asio::ip::address_v4::loopback(),
+          acceptor.local_endpoint().port()));
+  }
+
+  asio::ip::udp::endpoint endpoint() const
+  {
+    return udp_socket.local_endpoint();
+  }
+
+  asio::io_context io_context;
+  asio::ip::udp::socket udp_socket;
+  asio::ip::tcp::acceptor acceptor;
+};
+
+std::string question_name(const std::vector<unsigned char>& query,
+    std::size_t& question_end)
+{
+  std::string name;
+  std::size_t pos = 12;
+  while (pos < query.size() && query[pos] != 0)
+  {
+    if (!name.empty())
+      name += '.';
+    name.append(reinterpret_cast<const char*>(&query[pos + 1]), query[pos]);
+    pos += query[pos] + 1;
+  }
+  question_end = pos + 5;
+  return name;
+}
+
+void append_u16(std::vector<unsigned char>& message, std::size_t value)
+{
+  message.push_back(static_cast<unsigned char>(value >> 8));
+  message.push_back(static_cast<unsigned char>(value & 0xFF));
+}
+
+// Build a response with the given number of answers of the queried type.
+std::vector<unsigned char> make_response(
+    const std::vector<unsigned char>& query, int rcode,
+    bool truncated, std::size_t answers)
+{
+  std::size_t question_end = 0;
+  question_name(query, question_end);
+  int type = (query[question_end - 4] << 8) | query[question_end - 3];
+
+  std::vector<unsigned char> response(query.begin(),
+      query.begin() + question_end);
+  response[2] = static_cast<unsigned char>(0x81 | (truncated ? 0x02 : 0));
+  response[3] = static_cast<unsigned char>(0x80 | rcode);
+  response[6] = 0;
+  response[7] = static_cast<unsigned char>(answers);
+
+  for (std::size_t i = 0; i < answers; ++i)
+  {
+    append_u16(response, 0xC00C);
+    append_u16(response, type);
+    append_u16(response, 1);
+    append_u16(response, 0);
+    append_u16(response, 60);
+    if (type == 1)
+    {
+      append_u16(response, 4);
+      response.push_back(192);
+      response.push_back(0);
+      response.push_back(2);
+      response.push_back(static_cast<unsigned char>(i + 1));
+    }
+    else
+    {
+      append_u16(response, 16);
+      append_u16(response, 0x2001);
+      append_u16(response, 0x0DB8);
+      for (int j = 0; j < 5; ++j)
+        append_u16(response, 0);
+      append_u16(response, i + 1);
+    }
+  }
+
+  return response;
+}
+
+void run_name_server(name_server* server)
+{
+  for (;;)
+  {
+    unsigned char data[512];
+    asio::ip::udp::endpoint sender;
+    std::size_t length = server->udp_socket.receive_from(
+        asio::buffer(data), sender);
+    if (length == 4 && std::memcmp(data, "quit", 4) == 0)
+      return;
+
+    std::vector<unsigned char> query(data, data + length);
+    std::size_t question_end = 0;
+    std::string name = question_name(query, question_end);
+
+    if (name == "www.example.test")
+    {
+      server->udp_socket.send_to(
+          asio::buffer(make_response(query, 0, false, 1)), sender);
+    }
+    else if (name == "big.example.test")
+    {
+      // Answer with a truncated response, then with the full response over
+      // the TCP connection that follows.
+      server->udp_socket.send_to(
+          asio::buffer(make_response(query, 0, true, 0)), sender);
+
+      asio::ip::tcp::socket socket(server->io_context);
+      server->acceptor.accept(socket);
+      unsigned char prefix[2];
+      asio::read(socket, asio::buffer(prefix));
+      std::vector<unsigned char> tcp_query((prefix[0] << 8) | prefix[1]);
+      asio::read(socket, asio::buffer(tcp_query));
+
+      std::vector<unsigned char> response;
+      std::vector<unsigned char> message = make_response(tcp_query, 0, false, 3);
+      append_u16(response, message.size());
+      response.insert(response.end(), message.begin(), message.end());
+      asio::write(socket, asio::buffer(response));
+    }
+    else
+    {
+      server->udp_socket.send_to(
+          asio::buffer(make_response(query, 3, false, 0)), sender);
+    }
+  }
+}
+
+void handle_resolve(const asio::error_code& err,
+    resolver_type::results_type results,
+    asio::error_code* out_err,
+    resolver_type::results_type* out_results)
+{
+  *out_err = err;
+  *out_results = results;
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  namespace chrono = asio::chrono;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  name_server server;
+  asio::detail::thread server_thread(bindns::bind(run_name_server, &server));
+
+  // A server that never answers.
+  ip::udp::socket silent_server(server.io_context,
+      ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  io_context ioc;
+  resolver_type resolver(ioc);
+  ASIO_CHECK(!resolver.servers().empty());
+  resolver.set_servers(std::vector<ip::udp::endpoint>(1, server.endpoint()));
+  resolver.set_timeout(chrono::milliseconds(200));
+  resolver.set_attempts(1);
+
+  asio::error_code ec;
+  resolver_type::results_type results;
+
+  // A query for a single address family.
+
+  resolver.async_resolve(ip::tcp::v4(), "www.example.test", "80",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 1);
+  if (!results.empty())
+  {
+    ASIO_CHECK(results.begin()->endpoint() == ip::tcp::endpoint(
+          ip::make_address("192.0.2.1"), 80));
+    ASIO_CHECK(results.begin()->host_name() == "www.example.test");
+    ASIO_CHECK(results.begin()->service_name() == "80");
+  }
+
+  // A query for both address families lists the IPv6 address first.
+
+  resolver.async_resolve("www.example.test", "443",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 2);
+  if (results.size() == 2)
+  {
+    resolver_type::results_type::const_iterator iter = results.begin();
+    ASIO_CHECK(iter->endpoint() == ip::tcp::endpoint(
+          ip::make_address("2001:db8::1"), 443));
+    ++iter;
+    ASIO_CHECK(iter->endpoint() == ip::tcp::endpoint(
+          ip::make_address("192.0.2.1"), 443));
+  }
+
+  // A name that does not exist.
+
+  resolver.async_resolve("missing.example.test", "80",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(ec == asio::error::host_not_found);
+  ASIO_CHECK(results.empty());
+
+  // A truncated response is repeated over TCP.
+
+  resolver.async_resolve(ip::tcp::v4(), "big.example.test", "80",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 3);
+
+  // A server that does not respond is skipped.
+
+  std::vector<ip::udp::endpoint> servers;
+  servers.push_back(silent_server.local_endpoint());
+  servers.push_back(server.endpoint());
+  resolver.set_servers(servers);
+
+  resolver.async_resolve(ip::tcp::v4(), "www.example.test", "80",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 1);
+
+  // No server responds.
+
+  resolver.set_servers(std::vector<ip::udp::endpoint>(
+        1, silent_server.local_endpoint()));
+  resolver.set_attempts(2);
+
+  resolver.async_resolve(ip::tcp::v4(), "www.example.test", "80",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(results.empty());
+
+  // A server to which the queries cannot be sent. The handler is not invoked
+  // from within async_resolve.
+
+  resolver.set_servers(std::vector<ip::udp::endpoint>(1,
+        ip::udp::endpoint(ip::address_v4::broadcast(), 53)));
+
+  ec = asio::error::would_block;
+  resolver.async_resolve(ip::tcp::v4(), "www.example.test", "80",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ASIO_CHECK(ec == asio::error::would_block);
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(!!ec);
+  ASIO_CHECK(ec != asio::error::would_block);
+  ASIO_CHECK(results.empty());
+
+  // Numeric addresses do not need a server.
+
+  resolver.async_resolve("127.0.0.1", "8080",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 1);
+  if (!results.empty())
+  {
+    ASIO_CHECK(results.begin()->endpoint() == ip::tcp::endpoint(
+          ip::address_v4::loopback(), 8080));
+  }
+
+  resolver.async_resolve(ip::tcp::v6(), "127.0.0.1", "8080",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(ec == asio::error::host_not_found);
+
+  // Only numeric services are supported.
+
+  resolver.async_resolve("127.0.0.1", "http",
+      bindns::bind(handle_resolve, _1, _2, &ec, &results));
+  ioc.run();
+  ioc.restart();
+
+  ASIO_CHECK(ec == asio::error::service_not_found);
+
+  // A missing configuration file leaves the configuration unchanged.
+
+  resolver.load_configuration("/nonexistent/resolv.conf", ec);
+  ASIO_CHECK(!!ec);
+  ASIO_CHECK(resolver.servers().size() == 1);
+
+  ip::udp::socket client(ioc, ip::udp::v4());
+  client.send_to(asio::buffer("quit", 4), server.endpoint());
+  server_thread.join();
+}
+
+#else // defined(ASIO_HAS_CHRONO)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+} // namespace ip_basic_dns_resolver_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/basic_dns_resolver",
+  ASIO_TEST_CASE(ip_basic_dns_resolver_runtime::test)
+)
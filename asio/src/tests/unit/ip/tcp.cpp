@@ -20,8 +20,10 @@
 #include "asio/ip/tcp.hpp"
 
 #include <cstring>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/read.hpp"
+#include "asio/thread.hpp"
 #include "asio/write.hpp"
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -679,17 +681,607 @@ void test()
       bindns::bind(handle_read_eof,
         _1, _2, &read_eof_completed));
 
+  // A read on a socket that is closed should be aborted.
+
+  char close_buffer[sizeof(write_data)];
+  bool read_close_completed = false;
+  asio::async_read(server_side_socket,
+      asio::buffer(close_buffer),
+      bindns::bind(handle_read_cancel,
+        _1, _2, &read_close_completed));
+
   server_side_socket.close();
 
   ioc.restart();
   ioc.run();
   ASIO_CHECK(read_eof_completed);
+  ASIO_CHECK(read_close_completed);
 }
 
 } // namespace ip_tcp_socket_runtime
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_socket_sharded_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::tcp::socket class
+// when the io_context's reactor is divided among multiple epoll sets.
+
+namespace ip_tcp_socket_sharded_runtime {
+
+void run_io_context(asio::io_context* ioc)
+{
+  ioc->run();
+}
+
+void test()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+  using ip_tcp_socket_runtime::write_data;
+  using ip_tcp_socket_runtime::handle_read;
+  using ip_tcp_socket_runtime::handle_write;
+  using ip_tcp_socket_runtime::handle_read_cancel;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc(ASIO_CONCURRENCY_HINT_REACTOR_SHARDS(4));
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  // Use enough sockets that each epoll set has some descriptors.
+  const int num_pairs = 8;
+  ip::tcp::socket* client_side_sockets[num_pairs];
+  ip::tcp::socket* server_side_sockets[num_pairs];
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    client_side_sockets[i] = new ip::tcp::socket(ioc);
+    server_side_sockets[i] = new ip::tcp::socket(ioc);
+    client_side_sockets[i]->connect(server_endpoint);
+    acceptor.accept(*server_side_sockets[i]);
+  }
+
+  // Read and write to transfer data, using several threads.
+
+  char read_buffers[num_pairs][sizeof(write_data)];
+  bool read_completed[num_pairs];
+  bool write_completed[num_pairs];
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    read_completed[i] = false;
+    asio::async_read(*client_side_sockets[i],
+        asio::buffer(read_buffers[i]),
+        bindns::bind(handle_read,
+          _1, _2, &read_completed[i]));
+
+    write_completed[i] = false;
+    asio::async_write(*server_side_sockets[i],
+        asio::buffer(write_data),
+        bindns::bind(handle_write,
+          _1, _2, &write_completed[i]));
+  }
+
+  asio::thread thread1(bindns::bind(run_io_context, &ioc));
+  asio::thread thread2(bindns::bind(run_io_context, &ioc));
+  ioc.run();
+  thread1.join();
+  thread2.join();
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    ASIO_CHECK(read_completed[i]);
+    ASIO_CHECK(write_completed[i]);
+    ASIO_CHECK(memcmp(read_buffers[i], write_data, sizeof(write_data)) == 0);
+  }
+
+  // Cancelled reads.
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    read_completed[i] = false;
+    asio::async_read(*server_side_sockets[i],
+        asio::buffer(read_buffers[i]),
+        bindns::bind(handle_read_cancel,
+          _1, _2, &read_completed[i]));
+  }
+
+  ioc.restart();
+  ioc.poll();
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    ASIO_CHECK(!read_completed[i]);
+    server_side_sockets[i]->cancel();
+  }
+
+  ioc.restart();
+  ioc.run();
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    ASIO_CHECK(read_completed[i]);
+    delete client_side_sockets[i];
+    delete server_side_sockets[i];
+  }
+}
+
+} // namespace ip_tcp_socket_sharded_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_unsafe_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::tcp::socket class
+// when the io_context's reactor performs I/O without locking.
+
+namespace ip_tcp_socket_unsafe_runtime {
+
+void handle_complete(const asio::error_code& err, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+}
+
+void handle_transfer(const asio::error_code& err,
+    size_t bytes_transferred, size_t expected, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected);
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  using ip_tcp_socket_runtime::handle_read_cancel;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  const int hints[] =
+  {
+    ASIO_CONCURRENCY_HINT_UNSAFE,
+    ASIO_CONCURRENCY_HINT_UNSAFE_IO
+  };
+
+  for (std::size_t h = 0; h < sizeof(hints) / sizeof(hints[0]); ++h)
+  {
+    io_context ioc(hints[h]);
+
+    ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+    ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+    server_endpoint.address(ip::address_v4::loopback());
+
+    ip::tcp::socket client_side_socket(ioc);
+    ip::tcp::socket server_side_socket(ioc);
+
+    bool accept_completed = false;
+    acceptor.async_accept(server_side_socket,
+        bindns::bind(handle_complete, _1, &accept_completed));
+
+    bool connect_completed = false;
+    client_side_socket.async_connect(server_endpoint,
+        bindns::bind(handle_complete, _1, &connect_completed));
+
+    ioc.run();
+    ASIO_CHECK(accept_completed);
+    ASIO_CHECK(connect_completed);
+
+    // Transfer enough data in both directions at once that the sockets'
+    // buffers fill, so that the operations must wait for readiness.
+
+    const size_t length = 4 * 1024 * 1024;
+    std::vector<char> client_data(length), server_data(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+      client_data[i] = static_cast<char>(i % 251);
+      server_data[i] = static_cast<char>(i % 241);
+    }
+    std::vector<char> client_read(length), server_read(length);
+
+    bool client_write_completed = false;
+    asio::async_write(client_side_socket, asio::buffer(client_data),
+        bindns::bind(handle_transfer, _1, _2,
+          length, &client_write_completed));
+
+    bool server_write_completed = false;
+    asio::async_write(server_side_socket, asio::buffer(server_data),
+        bindns::bind(handle_transfer, _1, _2,
+          length, &server_write_completed));
+
+    bool client_read_completed = false;
+    asio::async_read(client_side_socket, asio::buffer(client_read),
+        bindns::bind(handle_transfer, _1, _2,
+          length, &client_read_completed));
+
+    bool server_read_completed = false;
+    asio::async_read(server_side_socket, asio::buffer(server_read),
+        bindns::bind(handle_transfer, _1, _2,
+          length, &server_read_completed));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(client_write_completed);
+    ASIO_CHECK(server_write_completed);
+    ASIO_CHECK(client_read_completed);
+    ASIO_CHECK(server_read_completed);
+    ASIO_CHECK(client_read == server_data);
+    ASIO_CHECK(server_read == client_data);
+
+    // A cancelled read, and a read on a socket that is closed.
+
+    char read_buffer[1];
+    bool cancel_completed = false;
+    asio::async_read(client_side_socket, asio::buffer(read_buffer),
+        bindns::bind(handle_read_cancel, _1, _2, &cancel_completed));
+
+    bool close_completed = false;
+    asio::async_read(server_side_socket, asio::buffer(read_buffer),
+        bindns::bind(handle_read_cancel, _1, _2, &close_completed));
+
+    ioc.restart();
+    ioc.poll();
+    ASIO_CHECK(!cancel_completed);
+    ASIO_CHECK(!close_completed);
+
+    client_side_socket.cancel();
+    server_side_socket.close();
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(cancel_completed);
+    ASIO_CHECK(close_completed);
+  }
+}
+
+} // namespace ip_tcp_socket_unsafe_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_recycling_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that steady-state echo traffic on the
+// ip::tcp::socket class recycles all handler memory.
+
+namespace ip_tcp_socket_recycling_runtime {
+
+#if !defined(ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+
+struct echo_session
+{
+  asio::ip::tcp::socket* client;
+  asio::ip::tcp::socket* server;
+  char client_buffer[64];
+  char server_buffer[64];
+  int round;
+  int warmup_rounds;
+  int rounds;
+  std::size_t heap_allocations_after_warmup;
+  std::size_t heap_allocations_at_end;
+
+  static std::size_t heap_allocations()
+  {
+    asio::detail::thread_info_base* this_thread =
+      asio::detail::thread_context::thread_call_stack::top();
+    ASIO_CHECK(this_thread != 0);
+    return this_thread ? this_thread->heap_allocations() : 0;
+  }
+
+  void start_round()
+  {
+#if defined(ASIO_HAS_BOOST_BIND)
+    namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+    namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+    using bindns::placeholders::_1;
+    using bindns::placeholders::_2;
+
+    asio::async_write(*client, asio::buffer(client_buffer),
+        bindns::bind(&echo_session::handle_write, this, _1, _2));
+    asio::async_read(*server, asio::buffer(server_buffer),
+        bindns::bind(&echo_session::handle_server_read, this, _1, _2));
+    asio::async_read(*client, asio::buffer(client_buffer),
+        bindns::bind(&echo_session::handle_client_read, this, _1, _2));
+  }
+
+  void handle_write(const asio::error_code& err, size_t bytes_transferred)
+  {
+    ASIO_CHECK(!err);
+    ASIO_CHECK(bytes_transferred == sizeof(client_buffer));
+  }
+
+  void handle_server_read(const asio::error_code& err,
+      size_t bytes_transferred)
+  {
+#if defined(ASIO_HAS_BOOST_BIND)
+    namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+    namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+    using bindns::placeholders::_1;
+    using bindns::placeholders::_2;
+
+    ASIO_CHECK(!err);
+    ASIO_CHECK(bytes_transferred == sizeof(server_buffer));
+
+    asio::async_write(*server, asio::buffer(server_buffer),
+        bindns::bind(&echo_session::handle_write, this, _1, _2));
+  }
+
+  void handle_client_read(const asio::error_code& err,
+      size_t bytes_transferred)
+  {
+    ASIO_CHECK(!err);
+    ASIO_CHECK(bytes_transferred == sizeof(client_buffer));
+
+    if (++round == warmup_rounds)
+      heap_allocations_after_warmup = heap_allocations();
+
+    if (round < rounds)
+      start_round();
+    else
+      heap_allocations_at_end = heap_allocations();
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  echo_session session;
+  session.client = &client_side_socket;
+  session.server = &server_side_socket;
+  for (size_t i = 0; i < sizeof(session.client_buffer); ++i)
+    session.client_buffer[i] = static_cast<char>(i);
+  session.round = 0;
+  session.warmup_rounds = 10;
+  session.rounds = 1000;
+  session.heap_allocations_after_warmup = 0;
+  session.heap_allocations_at_end = ~size_t(0);
+
+  session.start_round();
+  ioc.run();
+
+  ASIO_CHECK(session.round == session.rounds);
+  ASIO_CHECK(session.heap_allocations_at_end
+      == session.heap_allocations_after_warmup);
+}
+
+#else // !defined(ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+
+void test()
+{
+}
+
+#endif // !defined(ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+
+} // namespace ip_tcp_socket_recycling_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_zerocopy_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of zero-copy sends on the
+// ip::tcp::socket class.
+
+namespace ip_tcp_socket_zerocopy_runtime {
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+void handle_send_chunk(const asio::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, int* count)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected_bytes);
+  ++*count;
+}
+
+void handle_send_all(const asio::error_code& err, size_t bytes_transferred,
+    asio::ip::tcp::socket* socket, const char* data, size_t size,
+    size_t* total_sent)
+{
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  ASIO_CHECK(!err);
+  *total_sent += bytes_transferred;
+  if (!err && *total_sent < size)
+  {
+    socket->async_send_zerocopy(
+        asio::buffer(data + *total_sent, size - *total_sent),
+        bindns::bind(handle_send_all, _1, _2,
+          socket, data, size, total_sent));
+  }
+}
+
+void handle_read_all(const asio::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, bool* called)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected_bytes);
+  *called = true;
+}
+
+void test()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // Several small sends outstanding at once.
+
+  const size_t chunk_size = 1024;
+  const int num_chunks = 4;
+  static char chunk_data[num_chunks][chunk_size];
+  static char chunk_read_data[num_chunks * chunk_size];
+  for (int i = 0; i < num_chunks; ++i)
+    memset(chunk_data[i], 'a' + i, chunk_size);
+
+  int chunks_sent = 0;
+  for (int i = 0; i < num_chunks; ++i)
+  {
+    server_side_socket.async_send_zerocopy(
+        asio::buffer(chunk_data[i]),
+        bindns::bind(handle_send_chunk, _1, _2,
+          chunk_size, &chunks_sent));
+  }
+
+  bool read_called = false;
+  asio::async_read(client_side_socket, asio::buffer(chunk_read_data),
+      bindns::bind(handle_read_all, _1, _2,
+        sizeof(chunk_read_data), &read_called));
+
+  ioc.run();
+
+  ASIO_CHECK(chunks_sent == num_chunks);
+  ASIO_CHECK(read_called);
+  for (int i = 0; i < num_chunks; ++i)
+    ASIO_CHECK(memcmp(chunk_read_data + i * chunk_size,
+          chunk_data[i], chunk_size) == 0);
+
+  // A large send, which is likely to be only partially accepted each time.
+
+  const size_t large_size = 4 * 1024 * 1024;
+  std::vector<char> large_data(large_size);
+  std::vector<char> large_read_data(large_size);
+  for (size_t i = 0; i < large_size; ++i)
+    large_data[i] = static_cast<char>(i % 251);
+
+  size_t total_sent = 0;
+  server_side_socket.async_send_zerocopy(
+      asio::buffer(large_data),
+      bindns::bind(handle_send_all, _1, _2, &server_side_socket,
+        &large_data[0], large_size, &total_sent));
+
+  read_called = false;
+  asio::async_read(client_side_socket, asio::buffer(large_read_data),
+      bindns::bind(handle_read_all, _1, _2, large_size, &read_called));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(total_sent == large_size);
+  ASIO_CHECK(read_called);
+  ASIO_CHECK(large_data == large_read_data);
+
+  // An empty send completes immediately.
+
+  int empty_sent = 0;
+  server_side_socket.async_send_zerocopy(asio::buffer(chunk_data[0], 0),
+      bindns::bind(handle_send_chunk, _1, _2, 0, &empty_sent));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(empty_sent == 1);
+
+  // Once its data has been sent, a send is waiting for the kernel to release
+  // the buffers. Cancelling it does not abort it, and closing the socket
+  // completes it with the result of the send.
+
+  ip::tcp::socket client_side_socket2(ioc);
+  ip::tcp::socket server_side_socket2(ioc);
+
+  client_side_socket2.connect(server_endpoint);
+  acceptor.accept(server_side_socket2);
+
+  int pending_sent = 0;
+  server_side_socket2.async_send_zerocopy(asio::buffer(chunk_data[0]),
+      bindns::bind(handle_send_chunk, _1, _2, chunk_size, &pending_sent));
+  server_side_socket2.cancel();
+
+  read_called = false;
+  asio::async_read(client_side_socket2,
+      asio::buffer(chunk_read_data, chunk_size),
+      bindns::bind(handle_read_all, _1, _2, chunk_size, &read_called));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(pending_sent == 1);
+  ASIO_CHECK(read_called);
+  ASIO_CHECK(memcmp(chunk_read_data, chunk_data[0], chunk_size) == 0);
+
+  server_side_socket2.async_send_zerocopy(asio::buffer(chunk_data[1]),
+      bindns::bind(handle_send_chunk, _1, _2, chunk_size, &pending_sent));
+  server_side_socket2.close();
+
+  read_called = false;
+  asio::async_read(client_side_socket2,
+      asio::buffer(chunk_read_data, chunk_size),
+      bindns::bind(handle_read_all, _1, _2, chunk_size, &read_called));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(pending_sent == 2);
+  ASIO_CHECK(read_called);
+  ASIO_CHECK(memcmp(chunk_read_data, chunk_data[1], chunk_size) == 0);
+}
+
+#else // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+} // namespace ip_tcp_socket_zerocopy_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_acceptor_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -1094,6 +1686,13 @@ void test()
 
     resolver.cancel();
 
+    resolver.set_thread_count(2);
+
+#if defined(ASIO_HAS_CHRONO)
+    resolver.set_cache_durations(asio::chrono::seconds(1),
+        asio::chrono::milliseconds(0));
+#endif // defined(ASIO_HAS_CHRONO)
+
 #if !defined(ASIO_NO_DEPRECATED)
     ip::tcp::resolver::results_type results1 = resolver.resolve(q);
     (void)results1;
@@ -1195,6 +1794,136 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_resolver_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of parallel and cached
+// asynchronous resolution on the ip::tcp::resolver class.
+
+namespace ip_tcp_resolver_runtime {
+
+void handle_resolve(const asio::error_code& err,
+    asio::ip::tcp::resolver::results_type results,
+    asio::error_code* out_err,
+    asio::ip::tcp::resolver::results_type* out_results)
+{
+  *out_err = err;
+  *out_results = results;
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+  ip::tcp::resolver resolver1(ioc);
+  ip::tcp::resolver resolver2(ioc);
+  resolver1.set_thread_count(4);
+
+  // Identical and distinct queries that are outstanding at the same time,
+  // from more than one resolver.
+
+  const int num_queries = 8;
+  const char* hosts[num_queries] = { "localhost", "127.0.0.1",
+    "localhost", "127.0.0.1", "localhost", "::1", "127.0.0.1", "localhost" };
+  asio::error_code errs[num_queries];
+  ip::tcp::resolver::results_type results[num_queries];
+  for (int i = 0; i < num_queries; ++i)
+  {
+    ip::tcp::resolver& resolver = (i % 2) ? resolver2 : resolver1;
+    resolver.async_resolve(hosts[i], "80",
+        ip::resolver_base::numeric_service,
+        bindns::bind(handle_resolve, _1, _2, &errs[i], &results[i]));
+  }
+
+  ioc.run();
+
+  for (int i = 0; i < num_queries; ++i)
+  {
+    if (hosts[i][0] == ':' && errs[i])
+      continue; // IPv6 may not be available.
+    ASIO_CHECK(!errs[i]);
+    ASIO_CHECK(!results[i].empty());
+    ip::tcp::resolver::results_type::const_iterator iter = results[i].begin();
+    for (; iter != results[i].end(); ++iter)
+    {
+      ASIO_CHECK(iter->host_name() == hosts[i]);
+      ASIO_CHECK(iter->endpoint().port() == 80);
+    }
+  }
+
+#if defined(ASIO_HAS_CHRONO)
+  // Cached results are shared between resolvers.
+
+  resolver1.set_cache_durations(asio::chrono::seconds(60),
+      asio::chrono::seconds(60));
+
+  asio::error_code err1, err2;
+  ip::tcp::resolver::results_type results1, results2;
+  resolver1.async_resolve("127.0.0.1", "443",
+      ip::resolver_base::numeric_service,
+      bindns::bind(handle_resolve, _1, _2, &err1, &results1));
+  ioc.restart();
+  ioc.run();
+
+  resolver2.async_resolve("127.0.0.1", "443",
+      ip::resolver_base::numeric_service,
+      bindns::bind(handle_resolve, _1, _2, &err2, &results2));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!err1);
+  ASIO_CHECK(!err2);
+  ASIO_CHECK(!results1.empty());
+  ASIO_CHECK(results1 == results2);
+
+  // Queries that differ only in their flags are not shared.
+
+  resolver2.async_resolve("127.0.0.1", "443",
+      ip::resolver_base::numeric_service | ip::resolver_base::passive,
+      bindns::bind(handle_resolve, _1, _2, &err2, &results2));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!err2);
+  ASIO_CHECK(!results2.empty());
+  ASIO_CHECK(results1 != results2);
+
+  // Disabling the cache discards the cached results.
+
+  resolver1.set_cache_durations(asio::chrono::seconds(0),
+      asio::chrono::seconds(0));
+
+  resolver1.async_resolve("127.0.0.1", "443",
+      ip::resolver_base::numeric_service,
+      bindns::bind(handle_resolve, _1, _2, &err1, &results1));
+  ioc.restart();
+  ioc.run();
+
+  resolver2.async_resolve("127.0.0.1", "443",
+      ip::resolver_base::numeric_service,
+      bindns::bind(handle_resolve, _1, _2, &err2, &results2));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!err1);
+  ASIO_CHECK(!err2);
+  ASIO_CHECK(results1 != results2);
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace ip_tcp_resolver_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_resolver_entry_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -1337,9 +2066,14 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(ip_tcp_runtime::test)
   ASIO_TEST_CASE(ip_tcp_socket_compile::test)
   ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_sharded_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_unsafe_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_recycling_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_zerocopy_runtime::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_compile::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
   ASIO_TEST_CASE(ip_tcp_resolver_compile::test)
+  ASIO_TEST_CASE(ip_tcp_resolver_runtime::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_iostream_compile::test)
@@ -521,6 +521,264 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_udp_socket_batch_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the batch send and
+// receive operations on the ip::udp::socket class.
+
+namespace ip_udp_socket_batch_runtime {
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void handle_batch(size_t* total, const asio::error_code& err, size_t n)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(n > 0);
+  *total += n;
+}
+
+void test()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  const size_t num_msgs = 8;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s3(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  char send_msgs[num_msgs][16];
+  ip::udp::socket::send_record send_records[num_msgs];
+  for (size_t i = 0; i < num_msgs; ++i)
+  {
+    memset(send_msgs[i], 'a' + static_cast<int>(i), sizeof(send_msgs[i]));
+    send_records[i].buffer = buffer(send_msgs[i], i + 1);
+    send_records[i].endpoint =
+      (i % 2 == 0) ? s1.local_endpoint() : s3.local_endpoint();
+    send_records[i].size = 0;
+  }
+
+  size_t sent = 0;
+  while (sent < num_msgs)
+    sent += s2.send_batch(send_records + sent, num_msgs - sent);
+
+  for (size_t i = 0; i < num_msgs; ++i)
+    ASIO_CHECK(send_records[i].size == i + 1);
+
+  char recv_msgs[num_msgs][16];
+  ip::udp::socket::receive_record recv_records[num_msgs];
+  for (size_t i = 0; i < num_msgs; ++i)
+  {
+    recv_records[i].buffer = buffer(recv_msgs[i], sizeof(recv_msgs[i]));
+    recv_records[i].size = 0;
+  }
+
+  size_t recvd = 0;
+  while (recvd < num_msgs / 2)
+    recvd += s1.receive_batch(recv_records + recvd, num_msgs - recvd);
+  ASIO_CHECK(recvd == num_msgs / 2);
+
+  for (size_t i = 0; i < recvd; ++i)
+  {
+    ASIO_CHECK(recv_records[i].size == 2 * i + 1);
+    ASIO_CHECK(recv_records[i].endpoint == s2.local_endpoint());
+    ASIO_CHECK(memcmp(recv_msgs[i], send_msgs[2 * i], 2 * i + 1) == 0);
+  }
+
+  recvd = 0;
+  while (recvd < num_msgs / 2)
+    recvd += s3.receive_batch(recv_records + recvd, num_msgs - recvd);
+  ASIO_CHECK(recvd == num_msgs / 2);
+
+  for (size_t i = 0; i < recvd; ++i)
+  {
+    ASIO_CHECK(recv_records[i].size == 2 * i + 2);
+    ASIO_CHECK(memcmp(recv_msgs[i], send_msgs[2 * i + 1], 2 * i + 2) == 0);
+  }
+
+  for (size_t i = 0; i < num_msgs; ++i)
+  {
+    send_records[i].endpoint = s1.local_endpoint();
+    send_records[i].size = 0;
+    recv_records[i].size = 0;
+  }
+
+  size_t async_sent = 0;
+  size_t async_recvd = 0;
+  s1.async_receive_batch(recv_records, num_msgs,
+      bindns::bind(handle_batch, &async_recvd, _1, _2));
+  s2.async_send_batch(send_records, num_msgs,
+      bindns::bind(handle_batch, &async_sent, _1, _2));
+
+  ioc.run();
+
+  ASIO_CHECK(async_sent > 0 && async_sent <= num_msgs);
+  ASIO_CHECK(async_recvd > 0 && async_recvd <= async_sent);
+
+  for (size_t i = 0; i < async_recvd; ++i)
+  {
+    ASIO_CHECK(recv_records[i].size == i + 1);
+    ASIO_CHECK(recv_records[i].endpoint == s2.local_endpoint());
+    ASIO_CHECK(memcmp(recv_msgs[i], send_msgs[i], i + 1) == 0);
+  }
+
+  size_t empty = s1.receive_batch(recv_records, 0);
+  ASIO_CHECK(empty == 0);
+}
+
+#else // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void test()
+{
+}
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+} // namespace ip_udp_socket_batch_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_udp_socket_segmented_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the segmentation offload
+// operations on the ip::udp::socket class.
+
+namespace ip_udp_socket_segmented_runtime {
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+void handle_send(size_t expected_bytes_sent,
+    const asio::error_code& err, size_t bytes_sent)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(expected_bytes_sent == bytes_sent);
+}
+
+void handle_recv(size_t* total, const asio::error_code& err, size_t n)
+{
+  ASIO_CHECK(!err);
+  *total += n;
+}
+
+void test()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  const size_t num_segments = 4;
+  const size_t segment = 1000;
+  const size_t last_segment = 500;
+  const size_t total = (num_segments - 1) * segment + last_segment;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  // Segmentation offload requires kernel support. Skip the test without it.
+  asio::error_code ec;
+  s2.set_option(ip::udp::segment_size(0), ec);
+  if (ec)
+    return;
+
+  s1.set_option(ip::udp::generic_receive_offload(true), ec);
+  bool gro = !ec;
+
+  char send_msg[total];
+  for (size_t i = 0; i < total; ++i)
+    send_msg[i] = static_cast<char>('A' + i / segment);
+
+  size_t bytes_sent = s2.send_to_segmented(
+      buffer(send_msg, total), s1.local_endpoint(), segment);
+  ASIO_CHECK(bytes_sent == total);
+
+  // Each receive returns whole segments, whether or not they are coalesced.
+  char recv_msg[total];
+  memset(recv_msg, 0, sizeof(recv_msg));
+  size_t bytes_recvd = 0;
+  while (bytes_recvd < total)
+  {
+    ip::udp::endpoint sender_endpoint;
+    size_t segment_size = 0;
+    size_t n = s1.receive_from_segmented(
+        buffer(recv_msg + bytes_recvd, total - bytes_recvd),
+        sender_endpoint, segment_size);
+    ASIO_CHECK(n > 0);
+    ASIO_CHECK(sender_endpoint == s2.local_endpoint());
+    if (bytes_recvd + n < total)
+    {
+      ASIO_CHECK(segment_size == segment);
+      ASIO_CHECK(n % segment == 0);
+    }
+    else
+    {
+      ASIO_CHECK(segment_size == (n > last_segment ? segment : last_segment));
+    }
+    if (!gro)
+      ASIO_CHECK(n == segment_size);
+    bytes_recvd += n;
+  }
+
+  ASIO_CHECK(bytes_recvd == total);
+  ASIO_CHECK(memcmp(send_msg, recv_msg, total) == 0);
+
+  // A segment size that cannot be represented is rejected.
+  s2.send_to_segmented(buffer(send_msg, total),
+      s1.local_endpoint(), 0x10000, 0, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+
+  memset(recv_msg, 0, sizeof(recv_msg));
+  ip::udp::endpoint sender_endpoint;
+  size_t segment_size = 0;
+  size_t async_recvd = 0;
+  s1.async_receive_from_segmented(buffer(recv_msg, total),
+      sender_endpoint, segment_size,
+      bindns::bind(handle_recv, &async_recvd, _1, _2));
+  s2.async_send_to_segmented(buffer(send_msg, total),
+      s1.local_endpoint(), segment,
+      bindns::bind(handle_send, total, _1, _2));
+
+  ioc.run();
+
+  ASIO_CHECK(async_recvd > 0);
+  ASIO_CHECK(sender_endpoint == s2.local_endpoint());
+  ASIO_CHECK(segment_size == segment);
+  ASIO_CHECK(memcmp(send_msg, recv_msg, async_recvd) == 0);
+}
+
+#else // defined(ASIO_HAS_UDP_GSO)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
+} // namespace ip_udp_socket_segmented_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_udp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -669,5 +927,7 @@ ASIO_TEST_SUITE
   "ip/udp",
   ASIO_TEST_CASE(ip_udp_socket_compile::test)
   ASIO_TEST_CASE(ip_udp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_batch_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_segmented_runtime::test)
   ASIO_TEST_CASE(ip_udp_resolver_compile::test)
 )
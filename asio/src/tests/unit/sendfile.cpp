@@ -0,0 +1,215 @@
+//
+// sendfile.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/sendfile.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_SENDFILE)
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/posix/stream_descriptor.hpp"
+#include "asio/read.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+// A temporary file holding known content, which is removed on destruction.
+class temp_file
+{
+public:
+  explicit temp_file(std::size_t size)
+    : data_(size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      data_[i] = static_cast<char>(i % 251);
+
+    char name[] = "/tmp/asio_sendfile_XXXXXX";
+    descriptor_ = ::mkstemp(name);
+    if (descriptor_ != -1)
+    {
+      ::unlink(name);
+      std::size_t written = 0;
+      while (written < size)
+      {
+        ssize_t n = ::write(descriptor_, &data_[written], size - written);
+        if (n <= 0)
+          break;
+        written += n;
+      }
+    }
+  }
+
+  ~temp_file()
+  {
+    if (descriptor_ != -1)
+      ::close(descriptor_);
+  }
+
+  int release()
+  {
+    int descriptor = descriptor_;
+    descriptor_ = -1;
+    return descriptor;
+  }
+
+  const std::vector<char>& data() const
+  {
+    return data_;
+  }
+
+private:
+  std::vector<char> data_;
+  int descriptor_;
+};
+
+void async_handler(const asio::error_code& err, std::size_t bytes_transferred,
+    asio::error_code* out_err, std::size_t* out_bytes_transferred)
+{
+  *out_err = err;
+  *out_bytes_transferred = bytes_transferred;
+}
+
+void test_sync_sendfile()
+{
+  using namespace std; // For memcmp.
+
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  temp_file tmp(100000);
+  asio::posix::stream_descriptor file(ioc, tmp.release());
+
+  std::size_t n = asio::sendfile(s1, file, 1000, 50000);
+  ASIO_CHECK(n == 50000);
+
+  std::vector<char> received(50000);
+  asio::read(s2, asio::buffer(received));
+  ASIO_CHECK(memcmp(&received[0], &tmp.data()[1000], 50000) == 0);
+
+  // Sending past the end of the file stops with eof.
+  asio::error_code ec;
+  n = asio::sendfile(s1, file, 99000, 5000, ec);
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(n == 1000);
+
+  received.resize(1000);
+  asio::read(s2, asio::buffer(received));
+  ASIO_CHECK(memcmp(&received[0], &tmp.data()[99000], 1000) == 0);
+
+  // A completion condition limits each step of the operation.
+  n = asio::sendfile(s1, file, 0, 5000, asio::transfer_at_least(1), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n > 0 && n <= 5000);
+}
+
+void test_async_sendfile()
+{
+  using namespace std; // For memcmp.
+
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  // Larger than the socket buffer, so that the send has to wait.
+  const std::size_t size = 4 * 1024 * 1024;
+  temp_file tmp(size);
+  asio::posix::stream_descriptor file(ioc, tmp.release());
+
+  asio::error_code send_ec, read_ec;
+  std::size_t send_bytes = 0, read_bytes = 0;
+  std::vector<char> received(size);
+
+  asio::async_sendfile(s1, file, 0, size,
+      bindns::bind(async_handler, _1, _2, &send_ec, &send_bytes));
+  asio::async_read(s2, asio::buffer(received),
+      bindns::bind(async_handler, _1, _2, &read_ec, &read_bytes));
+
+  ASIO_CHECK(send_bytes == 0);
+  ioc.run();
+
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(send_bytes == size);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read_bytes == size);
+  ASIO_CHECK(memcmp(&received[0], &tmp.data()[0], size) == 0);
+
+  // Sending past the end of the file stops with eof.
+  asio::async_sendfile(s1, file, size - 10, 100,
+      bindns::bind(async_handler, _1, _2, &send_ec, &send_bytes));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(send_ec == asio::error::eof);
+  ASIO_CHECK(send_bytes == 10);
+
+  received.resize(10);
+  asio::read(s2, asio::buffer(received));
+  ASIO_CHECK(memcmp(&received[0], &tmp.data()[size - 10], 10) == 0);
+
+  // An empty send completes without error.
+  send_bytes = 1;
+  asio::async_sendfile(s1, file, 0, 0,
+      bindns::bind(async_handler, _1, _2, &send_ec, &send_bytes));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(send_bytes == 0);
+
+  // A completion condition stops the operation early.
+  asio::async_sendfile(s1, file, 0, 1000, asio::transfer_exactly(100),
+      bindns::bind(async_handler, _1, _2, &send_ec, &send_bytes));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(send_bytes == 100);
+}
+
+#else // defined(ASIO_HAS_SENDFILE)
+
+void test_sync_sendfile()
+{
+}
+
+void test_async_sendfile()
+{
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+ASIO_TEST_SUITE
+(
+  "sendfile",
+  ASIO_TEST_CASE(test_sync_sendfile)
+  ASIO_TEST_CASE(test_async_sendfile)
+)
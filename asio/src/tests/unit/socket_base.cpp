@@ -97,6 +97,17 @@ void test()
     (void)static_cast<bool>(!keep_alive1);
     (void)static_cast<bool>(keep_alive1.value());
 
+#if defined(ASIO_HAS_SO_BUSY_POLL)
+    // busy_poll class.
+
+    socket_base::busy_poll busy_poll1(50);
+    sock.set_option(busy_poll1);
+    socket_base::busy_poll busy_poll2;
+    sock.get_option(busy_poll2);
+    busy_poll1 = 1;
+    (void)static_cast<int>(busy_poll1.value());
+#endif // defined(ASIO_HAS_SO_BUSY_POLL)
+
     // send_buffer_size class.
 
     socket_base::send_buffer_size send_buffer_size1(1024);
@@ -402,6 +413,21 @@ void test()
   ASIO_CHECK(!static_cast<bool>(keep_alive4));
   ASIO_CHECK(!keep_alive4);
 
+#if defined(ASIO_HAS_SO_BUSY_POLL)
+  // busy_poll class.
+
+  // Lowering the value needs no privileges.
+  socket_base::busy_poll busy_poll1(0);
+  ASIO_CHECK(busy_poll1.value() == 0);
+  tcp_sock.set_option(busy_poll1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::busy_poll busy_poll2;
+  tcp_sock.get_option(busy_poll2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(busy_poll2.value() == 0);
+#endif // defined(ASIO_HAS_SO_BUSY_POLL)
+
   // send_buffer_size class.
 
   socket_base::send_buffer_size send_buffer_size1(4096);
@@ -0,0 +1,220 @@
+//
+// splice.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/splice.hpp"
+
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/post.hpp"
+#include "asio/posix/stream_descriptor.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+typedef asio::local::stream_protocol::socket socket_type;
+
+void async_handler(const asio::error_code& err, std::size_t bytes_transferred,
+    asio::error_code* out_err, std::size_t* out_bytes_transferred)
+{
+  *out_err = err;
+  *out_bytes_transferred = bytes_transferred;
+}
+
+void fill_pattern(std::vector<char>& data)
+{
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+}
+
+void write_to_pipe(asio::posix::stream_descriptor* pipe,
+    const std::vector<char>* data)
+{
+  asio::write(*pipe, asio::buffer(*data));
+  pipe->close();
+}
+
+void test_pipe_to_socket()
+{
+  using namespace std; // For memcmp.
+
+  asio::io_context ioc;
+  socket_type s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  int pipe_fds[2];
+  ASIO_CHECK(::pipe(pipe_fds) == 0);
+  asio::posix::stream_descriptor pipe_rd(ioc, pipe_fds[0]);
+  asio::posix::stream_descriptor pipe_wr(ioc, pipe_fds[1]);
+
+  std::vector<char> data(10000);
+  fill_pattern(data);
+
+  // The pipe is empty when the operation starts, so it waits for the pipe.
+  asio::error_code ec;
+  std::size_t bytes = 0;
+  asio::async_splice(pipe_rd, s1, 20000,
+      bindns::bind(async_handler, _1, _2, &ec, &bytes));
+  asio::post(ioc, bindns::bind(write_to_pipe, &pipe_wr, &data));
+  ioc.run();
+
+  // The write end was closed after the data was written.
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(bytes == data.size());
+
+  std::vector<char> received(data.size());
+  asio::read(s2, asio::buffer(received));
+  ASIO_CHECK(memcmp(&received[0], &data[0], data.size()) == 0);
+}
+
+void test_socket_to_pipe()
+{
+  using namespace std; // For memcmp.
+
+  asio::io_context ioc;
+  socket_type s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  int pipe_fds[2];
+  ASIO_CHECK(::pipe(pipe_fds) == 0);
+  asio::posix::stream_descriptor pipe_rd(ioc, pipe_fds[0]);
+  asio::posix::stream_descriptor pipe_wr(ioc, pipe_fds[1]);
+
+  std::vector<char> data(10000);
+  fill_pattern(data);
+  asio::write(s2, asio::buffer(data));
+
+  std::size_t n = asio::splice(s1, pipe_wr, data.size());
+  ASIO_CHECK(n == data.size());
+
+  std::vector<char> received(data.size());
+  asio::read(pipe_rd, asio::buffer(received));
+  ASIO_CHECK(memcmp(&received[0], &data[0], data.size()) == 0);
+
+  // Asynchronously, with the data arriving after the operation starts.
+  asio::error_code ec;
+  std::size_t bytes = 0;
+  asio::async_splice(s1, pipe_wr, data.size(),
+      bindns::bind(async_handler, _1, _2, &ec, &bytes));
+  asio::async_write(s2, asio::buffer(data),
+      bindns::bind(async_handler, _1, _2, &ec, &n));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(bytes == data.size());
+
+  asio::read(pipe_rd, asio::buffer(received));
+  ASIO_CHECK(memcmp(&received[0], &data[0], data.size()) == 0);
+}
+
+void test_socket_to_socket()
+{
+  using namespace std; // For memcmp.
+
+  asio::io_context ioc;
+  socket_type a1(ioc), a2(ioc), b1(ioc), b2(ioc);
+  asio::local::connect_pair(a1, a2);
+  asio::local::connect_pair(b1, b2);
+
+  // Larger than the socket buffers and the intermediate pipe.
+  std::vector<char> data(4 * 1024 * 1024);
+  fill_pattern(data);
+  std::vector<char> received(data.size());
+
+  asio::error_code write_ec, splice_ec, read_ec;
+  std::size_t write_bytes = 0, splice_bytes = 0, read_bytes = 0;
+  asio::async_write(a1, asio::buffer(data),
+      bindns::bind(async_handler, _1, _2, &write_ec, &write_bytes));
+  asio::async_splice(a2, b1, data.size(),
+      bindns::bind(async_handler, _1, _2, &splice_ec, &splice_bytes));
+  asio::async_read(b2, asio::buffer(received),
+      bindns::bind(async_handler, _1, _2, &read_ec, &read_bytes));
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(write_bytes == data.size());
+  ASIO_CHECK(!splice_ec);
+  ASIO_CHECK(splice_bytes == data.size());
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read_bytes == data.size());
+  ASIO_CHECK(memcmp(&received[0], &data[0], data.size()) == 0);
+
+  // Forwarding until the source is closed.
+  asio::write(a1, asio::buffer(data, 1000));
+  a1.close();
+  asio::error_code ec;
+  std::size_t n = asio::splice(a2, b1, data.size(), ec);
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(n == 1000);
+
+  asio::read(b2, asio::buffer(received, 1000));
+  ASIO_CHECK(memcmp(&received[0], &data[0], 1000) == 0);
+
+  // A completion condition stops the operation early.
+  socket_type c1(ioc), c2(ioc);
+  asio::local::connect_pair(c1, c2);
+  asio::write(b2, asio::buffer(data, 1000));
+  n = asio::splice(b1, c1, 1000, asio::transfer_exactly(100), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 100);
+
+  asio::read(c2, asio::buffer(received, 100));
+  ASIO_CHECK(memcmp(&received[0], &data[0], 100) == 0);
+}
+
+#else // defined(ASIO_HAS_SPLICE)
+
+void test_pipe_to_socket()
+{
+}
+
+void test_socket_to_pipe()
+{
+}
+
+void test_socket_to_socket()
+{
+}
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+ASIO_TEST_SUITE
+(
+  "splice",
+  ASIO_TEST_CASE(test_pipe_to_socket)
+  ASIO_TEST_CASE(test_socket_to_pipe)
+  ASIO_TEST_CASE(test_socket_to_socket)
+)
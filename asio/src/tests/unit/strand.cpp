@@ -17,11 +17,13 @@
 #include "asio/strand.hpp"
 
 #include <sstream>
+#include <vector>
 #include "asio/executor.hpp"
 #include "asio/io_context.hpp"
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
 #include "asio/thread.hpp"
+#include "asio/thread_pool.hpp"
 #include "unit_test.hpp"
 
 #if defined(ASIO_HAS_BOOST_DATE_TIME)
@@ -239,6 +241,70 @@ void strand_test()
   ASIO_CHECK(count == 0);
 }
 
+struct strand_state
+{
+  strand_state()
+    : running(0),
+      count(0),
+      last_sequence(4, -1)
+  {
+  }
+
+  int running;
+  int count;
+  std::vector<int> last_sequence;
+};
+
+void check_exclusive(strand_state* state, int producer, int sequence)
+{
+  // No other function may run in the strand at the same time, and functions
+  // posted by a single thread must run in the order they were posted.
+  ASIO_CHECK(state->running++ == 0);
+  ASIO_CHECK(state->last_sequence[producer] < sequence);
+  state->last_sequence[producer] = sequence;
+  ++state->count;
+  --state->running;
+}
+
+void post_to_strands(std::vector<strand<thread_pool::executor_type> >* s,
+    std::vector<strand_state>* states, int producer, int num_posts)
+{
+  for (int i = 0; i < num_posts; ++i)
+  {
+    std::size_t index = i % s->size();
+    post((*s)[index], bindns::bind(check_exclusive,
+          &(*states)[index], producer, i));
+  }
+}
+
+void strand_concurrency_test()
+{
+  const int num_strands = 16;
+  const int num_threads = 4;
+  const int num_posts = 20000;
+
+  thread_pool pool(num_threads);
+  std::vector<strand<thread_pool::executor_type> > strands;
+  for (int i = 0; i < num_strands; ++i)
+    strands.push_back(make_strand(pool));
+  std::vector<strand_state> states(num_strands);
+
+  // Post to the strands from several threads at once.
+  thread_pool producers(num_threads);
+  for (int i = 0; i < num_threads; ++i)
+  {
+    post(producers, bindns::bind(post_to_strands,
+          &strands, &states, i, num_posts));
+  }
+  producers.join();
+  pool.join();
+
+  int total = 0;
+  for (int i = 0; i < num_strands; ++i)
+    total += states[i].count;
+  ASIO_CHECK(total == num_threads * num_posts);
+}
+
 void strand_conversion_test()
 {
   io_context ioc;
@@ -470,6 +536,7 @@ ASIO_TEST_SUITE
 (
   "strand",
   ASIO_TEST_CASE(strand_test)
+  ASIO_TEST_CASE(strand_concurrency_test)
   ASIO_COMPILE_TEST_CASE(strand_conversion_test)
   ASIO_TEST_CASE(strand_query_test)
   ASIO_TEST_CASE(strand_execute_test)
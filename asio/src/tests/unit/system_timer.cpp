@@ -28,6 +28,7 @@
 #include "asio/executor_work_guard.hpp"
 #include "asio/io_context.hpp"
 #include "asio/thread.hpp"
+#include <vector>
 
 #if defined(ASIO_HAS_BOOST_BIND)
 # include <boost/bind/bind.hpp>
@@ -466,6 +467,148 @@ void system_timer_move_test()
 #endif // defined(ASIO_HAS_MOVE)
 }
 
+struct wheel_wait_traits
+  : asio::wait_traits<asio::system_timer::clock_type>
+{
+  static asio::system_timer::duration timer_wheel_resolution()
+  {
+    return asio::chrono::milliseconds(1);
+  }
+};
+
+typedef asio::basic_waitable_timer<
+    asio::system_timer::clock_type, wheel_wait_traits> wheel_timer;
+
+void record_expiry(wheel_timer* t, int id, std::vector<int>* order,
+    int* cancelled, const asio::error_code& ec)
+{
+  if (ec)
+  {
+    ASIO_CHECK(ec == asio::error::operation_aborted);
+    ++(*cancelled);
+  }
+  else
+  {
+    // A timer in the wheel may fire late but never early.
+    ASIO_CHECK(!(now() < t->expiry()));
+    order->push_back(id);
+  }
+}
+
+void system_timer_wheel_test()
+{
+  using asio::chrono::milliseconds;
+  using asio::chrono::seconds;
+  using bindns::placeholders::_1;
+
+  asio::io_context ioc;
+  std::vector<int> order;
+  int cancelled = 0;
+
+  // Timers are added in reverse order of expiry, spread over enough ticks
+  // that the later ones must be cascaded down from the upper levels.
+  const int num_timers = 200;
+  std::vector<wheel_timer*> timers;
+  for (int i = 0; i < num_timers; ++i)
+    timers.push_back(new wheel_timer(ioc));
+  asio::system_timer::time_point start = now();
+  for (int i = num_timers - 1; i >= 0; --i)
+  {
+    timers[i]->expires_at(start + milliseconds(3 * i));
+    timers[i]->async_wait(bindns::bind(record_expiry,
+          timers[i], i, &order, &cancelled, _1));
+  }
+
+  // Cancel every fifth timer, and move some others to expire much later.
+  int expected_cancelled = 0;
+  for (int i = 0; i < num_timers; i += 5, ++expected_cancelled)
+    ASIO_CHECK(timers[i]->cancel() == 1);
+  for (int i = 1; i < num_timers; i += 7)
+  {
+    if (i % 5 != 0)
+    {
+      ASIO_CHECK(timers[i]->expires_at(start + milliseconds(1000 + i)) == 1);
+      timers[i]->async_wait(bindns::bind(record_expiry,
+            timers[i], num_timers + i, &order, &cancelled, _1));
+      ++expected_cancelled;
+    }
+  }
+
+  // A timer that is far enough in the future to use the top level, and which
+  // is then cancelled.
+  wheel_timer far_timer(ioc, seconds(600));
+  far_timer.async_wait(bindns::bind(record_expiry,
+        &far_timer, -1, &order, &cancelled, _1));
+  ioc.poll();
+  ASIO_CHECK(far_timer.cancel() == 1);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(cancelled == expected_cancelled + 1);
+  ASIO_CHECK(order.size() == static_cast<std::size_t>(num_timers
+        - num_timers / 5));
+  for (std::size_t i = 1; i < order.size(); ++i)
+    ASIO_CHECK(order[i - 1] < order[i]);
+
+  for (int i = 0; i < num_timers; ++i)
+    delete timers[i];
+}
+
+template <typename Timer>
+void check_expired(Timer* t, int* count, const asio::error_code& ec)
+{
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(!(now() < t->expiry()));
+  ++(*count);
+}
+
+template <typename Timer>
+void reschedule_test()
+{
+  using asio::chrono::milliseconds;
+  using asio::chrono::seconds;
+  using bindns::placeholders::_1;
+
+  asio::io_context ioc;
+  int count = 0;
+
+  // Rescheduling a timer with no pending waits only changes its expiry time.
+  Timer t1(ioc);
+  asio::system_timer::time_point expected_expiry = now() + seconds(1);
+  t1.reschedule_at(expected_expiry);
+  ASIO_CHECK(t1.expiry() == expected_expiry);
+
+  // Move a pending wait later.
+  asio::system_timer::time_point start = now();
+  t1.expires_after(milliseconds(50));
+  t1.async_wait(bindns::bind(check_expired<Timer>, &t1, &count, _1));
+  t1.reschedule_after(milliseconds(200));
+
+  // Move a pending wait earlier, and then later again.
+  Timer t2(ioc, seconds(10));
+  t2.async_wait(bindns::bind(check_expired<Timer>, &t2, &count, _1));
+  t2.reschedule_after(milliseconds(50));
+  t2.reschedule_after(milliseconds(100));
+
+  // Move a pending wait earlier than all others.
+  Timer t3(ioc, seconds(10));
+  t3.async_wait(bindns::bind(check_expired<Timer>, &t3, &count, _1));
+  t3.reschedule_after(milliseconds(10));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(!(now() < start + milliseconds(200)));
+  ASIO_CHECK(now() < start + seconds(5));
+}
+
+void system_timer_reschedule_test()
+{
+  reschedule_test<asio::system_timer>();
+  reschedule_test<wheel_timer>();
+}
+
 ASIO_TEST_SUITE
 (
   "system_timer",
@@ -474,6 +617,8 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(system_timer_custom_allocation_test)
   ASIO_TEST_CASE(system_timer_thread_test)
   ASIO_TEST_CASE(system_timer_move_test)
+  ASIO_TEST_CASE(system_timer_wheel_test)
+  ASIO_TEST_CASE(system_timer_reschedule_test)
 )
 #else // defined(ASIO_HAS_STD_CHRONO)
 ASIO_TEST_SUITE
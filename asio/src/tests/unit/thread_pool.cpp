@@ -16,10 +16,18 @@
 // Test that header file is self-contained.
 #include "asio/thread_pool.hpp"
 
+#include <algorithm>
+#include <vector>
 #include "asio/dispatch.hpp"
 #include "asio/post.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/thread_affinity.hpp"
 #include "unit_test.hpp"
 
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+# include <sched.h>
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+
 #if defined(ASIO_HAS_BOOST_BIND)
 # include <boost/bind/bind.hpp>
 #else // defined(ASIO_HAS_BOOST_BIND)
@@ -87,6 +95,140 @@ void thread_pool_test()
   ASIO_CHECK(count3 == 0);
 }
 
+void fan_out_increment(thread_pool* pool,
+    asio::detail::atomic_count* count, int depth)
+{
+  ++(*count);
+  if (depth > 0)
+  {
+    asio::post(*pool, bindns::bind(fan_out_increment, pool, count, depth - 1));
+    asio::post(*pool, bindns::bind(fan_out_increment, pool, count, depth - 1));
+  }
+}
+
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+
+// Get the processors that the calling thread may run on.
+std::vector<int> current_cpus()
+{
+  std::vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &set))
+        cpus.push_back(cpu);
+  return cpus;
+}
+
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+
+// Check that the calling thread may only run on the given processors.
+void check_pinned(const std::vector<int>* cpus,
+    asio::detail::atomic_count* count)
+{
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+  std::vector<int> current = current_cpus();
+  ASIO_CHECK(!current.empty());
+  for (std::size_t i = 0; i < current.size(); ++i)
+    ASIO_CHECK(std::find(cpus->begin(), cpus->end(), current[i])
+        != cpus->end());
+#else // defined(ASIO_HAS_THREAD_AFFINITY)
+  (void)cpus;
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+  ++(*count);
+}
+
+void thread_pool_affinity_test()
+{
+  std::vector<int> cpus;
+  asio::detail::thread_affinity::parse_cpu_list("0-2,5,7-8\n", cpus);
+  ASIO_CHECK(cpus.size() == 6);
+  ASIO_CHECK(cpus[0] == 0 && cpus[2] == 2 && cpus[3] == 5 && cpus[5] == 8);
+
+  thread_pool::affinity numa = thread_pool::affinity::numa();
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+  ASIO_CHECK(numa.node_count() > 0);
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+  if (numa.node_count() > 0)
+    cpus = numa.node_cpus(0);
+  else
+    cpus.clear();
+
+  // Threads pinned to a single node share one queue, and run only on the
+  // node's processors.
+  {
+    thread_pool pool(3, thread_pool::affinity::cpus(cpus));
+    ASIO_CHECK(query(pool.executor(), execution::occupancy) == 3);
+
+    int count = 10;
+    asio::post(pool, bindns::bind(decrement_to_zero, &pool, &count));
+
+    asio::detail::atomic_count pinned(0);
+    for (int i = 0; i < 6; ++i)
+      asio::post(pool, bindns::bind(check_pinned, &cpus, &pinned));
+
+    pool.wait();
+    ASIO_CHECK(count == 0);
+    ASIO_CHECK(pinned == 6);
+  }
+
+  // A node with one processor restricts its threads to that processor, while
+  // the thread that created the pool is not pinned.
+  if (!cpus.empty())
+  {
+    std::vector<int> first_cpu(1, cpus.back());
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+    std::vector<int> before = current_cpus();
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+
+    thread_pool pool(2, thread_pool::affinity::cpus(first_cpu));
+
+    asio::detail::atomic_count pinned(0);
+    for (int i = 0; i < 4; ++i)
+      asio::post(pool, bindns::bind(check_pinned, &first_cpu, &pinned));
+    pool.wait();
+    ASIO_CHECK(pinned == 4);
+
+#if defined(ASIO_HAS_THREAD_AFFINITY)
+    ASIO_CHECK(current_cpus() == before);
+#endif // defined(ASIO_HAS_THREAD_AFFINITY)
+  }
+
+  // The occupancy of a pool divided between nodes is that of the largest
+  // node, and work submitted on one node is taken by the others.
+  {
+    thread_pool::affinity a;
+    a.add_node(cpus).add_node(cpus);
+    ASIO_CHECK(a.node_count() == 2);
+
+    thread_pool pool(3, a);
+    ASIO_CHECK(query(pool.executor(), execution::occupancy) == 2);
+
+    asio::detail::atomic_count count(0);
+    asio::post(pool, bindns::bind(fan_out_increment, &pool, &count, 10));
+
+    asio::detail::atomic_count pinned(0);
+    for (int i = 0; i < 6; ++i)
+      asio::post(pool, bindns::bind(check_pinned, &cpus, &pinned));
+
+    pool.wait();
+    ASIO_CHECK(count == (1 << 11) - 1);
+    ASIO_CHECK(pinned == 6);
+  }
+
+  // A pool with no nodes is not pinned.
+  {
+    thread_pool pool(2, thread_pool::affinity());
+    ASIO_CHECK(query(pool.executor(), execution::occupancy) == 2);
+
+    int count = 0;
+    asio::post(pool, bindns::bind(increment, &count));
+    pool.wait();
+    ASIO_CHECK(count == 1);
+  }
+}
+
 class test_service : public asio::execution_context::service
 {
 public:
@@ -506,13 +648,49 @@ void thread_pool_executor_bulk_execute_test()
   ASIO_CHECK(count == 20);
 }
 
+struct mark_index
+{
+  asio::detail::atomic_count* marks;
+
+  void operator()(std::size_t i) const
+  {
+    ++marks[i];
+  }
+};
+
+void thread_pool_executor_chunked_bulk_execute_test()
+{
+  const std::size_t max_n = 10007;
+  static asio::detail::atomic_count marks[max_n];
+  const std::size_t sizes[] = { 0, 1, 3, 64, 1000, max_n };
+
+  for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    for (std::size_t i = 0; i < max_n; ++i)
+      marks[i] = 0;
+
+    thread_pool pool(4);
+    mark_index f = { marks };
+    pool.executor().bulk_execute(f, sizes[s]);
+    pool.wait();
+
+    bool each_index_once = true;
+    for (std::size_t i = 0; i < max_n; ++i)
+      if (marks[i] != (i < sizes[s] ? 1 : 0))
+        each_index_once = false;
+    ASIO_CHECK(each_index_once);
+  }
+}
+
 ASIO_TEST_SUITE
 (
   "thread_pool",
   ASIO_TEST_CASE(thread_pool_test)
+  ASIO_TEST_CASE(thread_pool_affinity_test)
   ASIO_TEST_CASE(thread_pool_service_test)
   ASIO_TEST_CASE(thread_pool_executor_query_test)
   ASIO_TEST_CASE(thread_pool_executor_execute_test)
   ASIO_TEST_CASE(thread_pool_executor_bulk_execute_test)
+  ASIO_TEST_CASE(thread_pool_executor_chunked_bulk_execute_test)
   ASIO_TEST_CASE(thread_pool_scheduler_test)
 )